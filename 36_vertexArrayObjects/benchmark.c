@@ -0,0 +1,1311 @@
+#include "benchmark.h"
+#include "gl/gl_LTexture.h"
+#include "gl/gl_LTexture_spritesheet.h"
+#include "gl/gl_LFont.h"
+#include "gl/gl_LShaderProgram.h"
+#include "gl/gl_lasset_pack.h"
+#include "gl/gl_lglyph_cache.h"
+#include "gl/gl_ltext_layout.h"
+#include "gl/gl_lfont_registry.h"
+#include "gl/gl_LFont_internals.h"
+#include "gl/gl_lfont_polygon_program2d.h"
+#include "gl/gl_lfont_instanced_program2d.h"
+#include "gl/gl_lglyph_run.h"
+#include "gl/gl_ltextured_polygon_program2d.h"
+#include "gl/gl_lprogram.h"
+#include "gl/gl_lshader_variants.h"
+#include "gl/gl_lshader_source.h"
+#include "gl/gl_lframe_constants.h"
+#include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "gl/gl_lsampler_cache.h"
+#include "gl/gl_ltexture_array.h"
+#include "gl/gl_lvertex_format.h"
+#include "foundation/krr_hash.h"
+#ifndef DISABLE_SDL_TTF_LIB
+#include "foundation/common.h"
+#include "foundation/LWindow.h"
+#include "foundation/LTexture.h"
+#include "foundation/LTextCache.h"
+#endif
+#include "SDL_log.h"
+#include "SDL_timer.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BENCHMARK_FONT_PATH "../Minecraft.ttf"
+// directory to keep baked font caches in
+#define BENCHMARK_FONT_CACHE_DIR "cache"
+// built via 'make assets'
+#define BENCHMARK_PACK_PATH "cache/assets.pack"
+// directory to keep linked program binaries in
+#define BENCHMARK_SHADER_CACHE_DIR "cache"
+
+static double now_ms_();
+static void bench_font_load_();
+static void bench_texture_create_();
+static void bench_asset_pack_();
+static void bench_glyph_cache_();
+static void bench_font_cache_();
+static void bench_sdf_font_();
+static void bench_font_load_many_();
+static void bench_text_layout_();
+static void bench_measure_strings_();
+static void bench_font_registry_();
+static void bench_bitmap_font_parse_();
+static void bench_glyph_run_();
+static void bench_program_binary_cache_();
+static void bench_frame_constants_();
+static void bench_program_uniforms_();
+static void bench_shader_variants_();
+static void bench_embedded_shaders_();
+static void bench_error_checks_();
+static void bench_samplers_();
+static void bench_texture_array_();
+static void bench_vertex_formats_();
+#ifndef DISABLE_SDL_TTF_LIB
+static void bench_text_cache_();
+#endif
+static double load_all_programs_(bool batched);
+static void parse_bitmap_per_pixel_(gl_LTexture* texture, LRect* clips);
+
+double now_ms_()
+{
+  return SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+void bench_font_load_()
+{
+  const int iterations = 10;
+
+  double start = now_ms_();
+  for (int i=0; i<iterations; i++)
+  {
+    gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+    if (!gl_LFont_load_freetype(font, BENCHMARK_FONT_PATH, 40))
+    {
+      SDL_Log("[benchmark] Unable to load font %s", BENCHMARK_FONT_PATH);
+      gl_LFont_free(font);
+      return;
+    }
+    gl_LFont_free(font);
+  }
+  double elapsed = now_ms_() - start;
+
+  SDL_Log("[benchmark] font load (freetype, 40px): %.3f ms avg over %d loads", elapsed / iterations, iterations);
+}
+
+void bench_texture_create_()
+{
+  // lots of small textures i.e. sprites, or glyphs
+  const int count = 256;
+  const int size = 16;
+
+  GLuint* pixels = malloc(size * size * sizeof(GLuint));
+  for (int i=0; i<size*size; i++)
+  {
+    pixels[i] = 0xFFFFFFFF;
+  }
+
+  gl_LTexture* textures[count];
+
+  double start = now_ms_();
+  for (int i=0; i<count; i++)
+  {
+    textures[i] = gl_LTexture_new();
+    gl_LTexture_load_texture_from_pixels32(textures[i], pixels, size, size);
+  }
+  double create_elapsed = now_ms_() - start;
+
+  start = now_ms_();
+  for (int i=0; i<count; i++)
+  {
+    gl_LTexture_free(textures[i]);
+  }
+  double free_elapsed = now_ms_() - start;
+
+  free(pixels);
+
+  SDL_Log("[benchmark] create %d textures %dx%d: %.3f ms, free: %.3f ms (no per-texture VBO/IBO)", count, size, size, create_elapsed, free_elapsed);
+}
+
+void bench_asset_pack_()
+{
+  const char* shaders[] = {
+    "res/shaders/l_textured_polygon_program2d.vert",
+    "res/shaders/l_textured_polygon_program2d.frag",
+    "res/shaders/l_font_program2d.vert",
+    "res/shaders/l_font_program2d.frag"
+  };
+  const int shader_count = sizeof(shaders) / sizeof(shaders[0]);
+
+  // loose files
+  double start = now_ms_();
+  {
+    gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+    gl_LFont_load_freetype(font, BENCHMARK_FONT_PATH, 40);
+    gl_LFont_free(font);
+
+    for (int i=0; i<shader_count; i++)
+    {
+      GLuint shader = gl_LShaderProgram_load_shader_from_file(shaders[i], i % 2 == 0 ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER);
+      glDeleteShader(shader);
+    }
+  }
+  double loose_ms = now_ms_() - start;
+
+  // asset pack, opening it is part of the cost
+  int failures = 0;
+  start = now_ms_();
+  gl_lasset_pack* pack = gl_lasset_pack_new();
+  if (!gl_lasset_pack_open(pack, BENCHMARK_PACK_PATH))
+  {
+    SDL_Log("[benchmark] skip asset pack, build %s via 'make assets' first", BENCHMARK_PACK_PATH);
+    gl_lasset_pack_free(pack);
+    return;
+  }
+  {
+    gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+    gl_lasset_pack_load_font(pack, BENCHMARK_FONT_PATH, font, 40);
+    gl_LFont_free(font);
+
+    for (int i=0; i<shader_count; i++)
+    {
+      GLuint shader = gl_lasset_pack_load_shader(pack, shaders[i], i % 2 == 0 ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER);
+      if (shader == 0)
+      {
+        failures++;
+      }
+      glDeleteShader(shader);
+    }
+  }
+  gl_lasset_pack_free(pack);
+  double pack_ms = now_ms_() - start;
+
+  if (failures > 0)
+  {
+    // timing of failed compiles means nothing
+    SDL_Log("[benchmark] skip asset pack, %d shaders failed to compile from it, rebuild %s via 'make assets'", failures, BENCHMARK_PACK_PATH);
+    return;
+  }
+
+  SDL_Log("[benchmark] font + %d shaders, loose files: %.3f ms, asset pack: %.3f ms", shader_count, loose_ms, pack_ms);
+}
+
+void bench_glyph_cache_()
+{
+  const int iterations = 10;
+
+  // printable ASCII, what gl_LFont bakes eagerly is its superset
+  char ascii[96];
+  for (int i=0; i<95; i++)
+  {
+    ascii[i] = ' ' + i;
+  }
+  ascii[95] = '\0';
+
+  // eager bake of all 256 glyphs
+  gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+  double start = now_ms_();
+  for (int i=0; i<iterations; i++)
+  {
+    gl_LFont_load_freetype(font, BENCHMARK_FONT_PATH, 40);
+  }
+  double eager_ms = (now_ms_() - start) / iterations;
+  const gl_LTexture* eager_atlas = font->spritesheet->ltexture;
+  int eager_bytes = eager_atlas->physical_width_ * eager_atlas->physical_height_;
+
+  // lazy load, then rasterize only glyphs in use
+  gl_lglyph_cache* cache = gl_lglyph_cache_new();
+  start = now_ms_();
+  for (int i=0; i<iterations; i++)
+  {
+    gl_lglyph_cache_load(cache, BENCHMARK_FONT_PATH, 40);
+  }
+  double lazy_load_ms = (now_ms_() - start) / iterations;
+
+  start = now_ms_();
+  gl_lglyph_cache_warm(cache, ascii);
+  double warm_ms = now_ms_() - start;
+  int lazy_bytes = cache->atlas_width_ * cache->atlas_height_;
+
+  SDL_Log("[benchmark] font 40px eager 256 glyphs: %.3f ms, atlas %d bytes | glyph cache load: %.3f ms, +95 ASCII glyphs: %.3f ms, atlas %d bytes",
+      eager_ms, eager_bytes, lazy_load_ms, warm_ms, lazy_bytes);
+  gl_lglyph_cache_print_stats(cache);
+
+  gl_lglyph_cache_free(cache);
+  gl_LFont_free(font);
+}
+
+void bench_font_cache_()
+{
+  // both sizes that sample loads at startup
+  const GLuint sizes[] = { 14, 40 };
+  const int size_count = sizeof(sizes) / sizeof(sizes[0]);
+
+  gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+
+  // cold, remove existing caches so fonts are baked with FreeType then saved
+  double start = now_ms_();
+  for (int i=0; i<size_count; i++)
+  {
+    char cache_file[512];
+    snprintf(cache_file, sizeof(cache_file), "%s/%016llx_%u.fontcache", BENCHMARK_FONT_CACHE_DIR, (unsigned long long)krr_hash_string(BENCHMARK_FONT_PATH), sizes[i]);
+    remove(cache_file);
+
+    if (!gl_LFont_load_freetype_cached(font, BENCHMARK_FONT_PATH, sizes[i], BENCHMARK_FONT_CACHE_DIR))
+    {
+      SDL_Log("[benchmark] Unable to load font %s", BENCHMARK_FONT_PATH);
+      gl_LFont_free(font);
+      return;
+    }
+  }
+  double cold_ms = now_ms_() - start;
+
+  // cached
+  start = now_ms_();
+  for (int i=0; i<size_count; i++)
+  {
+    gl_LFont_load_freetype_cached(font, BENCHMARK_FONT_PATH, sizes[i], BENCHMARK_FONT_CACHE_DIR);
+  }
+  double cached_ms = now_ms_() - start;
+
+  gl_LFont_free(font);
+
+  SDL_Log("[benchmark] startup fonts (14px + 40px), cold bake + save: %.3f ms, cached: %.3f ms", cold_ms, cached_ms);
+}
+
+void bench_sdf_font_()
+{
+  // two bitmap fonts as sample loads at startup
+  gl_LFont* small_font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+  gl_LFont* large_font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+
+  double start = now_ms_();
+  gl_LFont_load_freetype(small_font, BENCHMARK_FONT_PATH, 14);
+  gl_LFont_load_freetype(large_font, BENCHMARK_FONT_PATH, 40);
+  double bitmap_ms = now_ms_() - start;
+  int bitmap_bytes = small_font->spritesheet->ltexture->physical_width_ * small_font->spritesheet->ltexture->physical_height_ +
+    large_font->spritesheet->ltexture->physical_width_ * large_font->spritesheet->ltexture->physical_height_;
+
+  // one distance field font serving both sizes
+  gl_LFont* sdf_font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+  start = now_ms_();
+  if (!gl_LFont_load_freetype_sdf(sdf_font, BENCHMARK_FONT_PATH, 40, 6))
+  {
+    SDL_Log("[benchmark] Unable to load SDF font %s", BENCHMARK_FONT_PATH);
+  }
+  double sdf_ms = now_ms_() - start;
+  int sdf_bytes = sdf_font->spritesheet->ltexture->physical_width_ * sdf_font->spritesheet->ltexture->physical_height_;
+
+  SDL_Log("[benchmark] bitmap fonts 14px + 40px: %.3f ms, atlas %d bytes | SDF font 40px (any size): %.3f ms, atlas %d bytes",
+      bitmap_ms, bitmap_bytes, sdf_ms, sdf_bytes);
+
+  gl_LFont_free(sdf_font);
+  gl_LFont_free(large_font);
+  gl_LFont_free(small_font);
+}
+
+void bench_font_load_many_()
+{
+  // typical set of UI text sizes
+  const GLuint sizes[] = { 12, 14, 18, 24, 32, 40 };
+  const int count = sizeof(sizes) / sizeof(sizes[0]);
+
+  gl_LFont* fonts[count];
+  gl_LFont_load_request requests[count];
+  for (int i=0; i<count; i++)
+  {
+    fonts[i] = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+    requests[i].font = fonts[i];
+    requests[i].path = BENCHMARK_FONT_PATH;
+    requests[i].pixel_size = sizes[i];
+  }
+
+  // one after another, each font's glyphs are still rasterized in parallel
+  double start = now_ms_();
+  for (int i=0; i<count; i++)
+  {
+    gl_LFont_load_freetype(fonts[i], BENCHMARK_FONT_PATH, sizes[i]);
+  }
+  double sequential_ms = now_ms_() - start;
+
+  // all fonts at once
+  start = now_ms_();
+  gl_LFont_load_freetype_many(requests, count);
+  double many_ms = now_ms_() - start;
+
+  for (int i=0; i<count; i++)
+  {
+    gl_LFont_free(fonts[i]);
+  }
+
+  SDL_Log("[benchmark] load %d font sizes one by one: %.3f ms, all at once: %.3f ms", count, sequential_ms, many_ms);
+}
+
+void bench_text_layout_()
+{
+  const int iterations = 1000;
+  const char* text = "The quick brown fox jumps over the lazy dog. Voix ambiguë d'un cœur qui, au zéphyr, préfère les jattes de kiwis.\n"
+    "Sphinx of black quartz, judge my vow. Pack my box with five dozen liquor jugs.";
+  const LSize area = { 320.f, 240.f };
+  const int align = gl_LFont_TEXT_ALIGN_CENTERED_H | gl_LFont_TEXT_ALIGN_CENTERED_V;
+
+  gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+  if (!gl_LFont_load_freetype(font, BENCHMARK_FONT_PATH, 18))
+  {
+    SDL_Log("[benchmark] Unable to load font %s", BENCHMARK_FONT_PATH);
+    gl_LFont_free(font);
+    return;
+  }
+
+  // lay out from scratch every time
+  double start = now_ms_();
+  for (int i=0; i<iterations; i++)
+  {
+    gl_ltext_layout_invalidate_font(font);
+    gl_ltext_layout_get(font, text, &area, align);
+  }
+  double cold_ms = (now_ms_() - start) / iterations;
+
+  // measure then render the same text as a frame would, both served from cache
+  start = now_ms_();
+  for (int i=0; i<iterations; i++)
+  {
+    gl_ltext_layout_get(font, text, &area, align);
+    gl_ltext_layout_get(font, text, &area, align);
+  }
+  double cached_ms = (now_ms_() - start) / iterations;
+
+  const gl_ltext_layout* layout = gl_ltext_layout_get(font, text, &area, align);
+  gl_ltext_layout_stats stats = gl_ltext_layout_get_stats();
+  SDL_Log("[benchmark] text layout %d glyphs, %d lines: %.4f ms | measure + render cached: %.4f ms (hits: %u, misses: %u)",
+      layout->glyph_count, layout->line_count, cold_ms, cached_ms, stats.hits, stats.misses);
+
+  gl_LFont_free(font);
+}
+
+void bench_measure_strings_()
+{
+  // UI layout pass over 10k labels
+  const int count = 10000;
+  const char* formats[] = { "Item %d", "Settings / Graphics / Option %d", "Score: %d", "Player %d joined the game", "Volume %d%%\nMusic" };
+
+  gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+  if (!gl_LFont_load_freetype(font, BENCHMARK_FONT_PATH, 18))
+  {
+    SDL_Log("[benchmark] Unable to load font %s", BENCHMARK_FONT_PATH);
+    gl_LFont_free(font);
+    return;
+  }
+
+  char** labels = malloc(count * sizeof(char*));
+  for (int i=0; i<count; i++)
+  {
+    labels[i] = malloc(64);
+    snprintf(labels[i], 64, formats[i % 5], i);
+  }
+  LSize* single_sizes = malloc(count * sizeof(LSize));
+  LSize* batch_sizes = malloc(count * sizeof(LSize));
+
+  // one by one
+  double start = now_ms_();
+  for (int i=0; i<count; i++)
+  {
+    single_sizes[i] = gl_LFont_get_string_area_size(font, labels[i]);
+  }
+  double single_ms = now_ms_() - start;
+
+  // all at once
+  start = now_ms_();
+  gl_LFont_measure_strings(font, (const char* const*)labels, count, batch_sizes);
+  double batch_ms = now_ms_() - start;
+
+  int mismatches = 0;
+  for (int i=0; i<count; i++)
+  {
+    if (single_sizes[i].w != batch_sizes[i].w || single_sizes[i].h != batch_sizes[i].h)
+    {
+      mismatches++;
+    }
+  }
+
+  SDL_Log("[benchmark] measure %d labels one by one: %.3f ms, batch: %.3f ms, mismatches: %d", count, single_ms, batch_ms, mismatches);
+
+  for (int i=0; i<count; i++)
+  {
+    free(labels[i]);
+  }
+  free(labels);
+  free(single_sizes);
+  free(batch_sizes);
+  gl_LFont_free(font);
+}
+
+void bench_font_registry_()
+{
+  // UI widgets each asking for the font they use
+  const GLuint sizes[] = { 12, 14, 18, 24 };
+  const int count = sizeof(sizes) / sizeof(sizes[0]);
+  const int widgets = 32;
+
+  gl_lfont_registry* registry = gl_lfont_registry_new();
+  gl_LFont* fonts[widgets];
+
+  double start = now_ms_();
+  for (int i=0; i<widgets; i++)
+  {
+    fonts[i] = gl_lfont_registry_acquire(registry, BENCHMARK_FONT_PATH, sizes[i % count]);
+  }
+  double separate_ms = now_ms_() - start;
+  SDL_Log("[benchmark] %d widgets acquire fonts of %d sizes separately: %.3f ms", widgets, count, separate_ms);
+  gl_lfont_registry_print_stats(registry);
+
+  for (int i=0; i<widgets; i++)
+  {
+    if (fonts[i] != NULL)
+      gl_lfont_registry_release(registry, fonts[i]);
+  }
+  gl_lfont_registry_free(registry);
+
+  // all sizes at once in a shared atlas page
+  registry = gl_lfont_registry_new();
+  gl_LFont* shared_fonts[count];
+
+  start = now_ms_();
+  bool result = gl_lfont_registry_acquire_sizes(registry, BENCHMARK_FONT_PATH, sizes, count, shared_fonts);
+  double shared_ms = now_ms_() - start;
+  SDL_Log("[benchmark] acquire fonts of %d sizes in shared page: %.3f ms", count, shared_ms);
+  gl_lfont_registry_print_stats(registry);
+
+  if (result)
+  {
+    for (int i=0; i<count; i++)
+    {
+      gl_lfont_registry_release(registry, shared_fonts[i]);
+    }
+  }
+  gl_lfont_registry_free(registry);
+}
+
+void parse_bitmap_per_pixel_(gl_LTexture* texture, LRect* clips)
+{
+  // column by column per-pixel scan, as gl_LFont_load_bitmap used to do
+  const int cell_width = texture->width / 16;
+  const int cell_height = texture->height / 16;
+  for (int i=0; i<256; i++)
+  {
+    int b_x = cell_width * (i % 16);
+    int b_y = cell_height * (i / 16);
+    clips[i] = (LRect){ b_x, b_y, cell_width, cell_height };
+
+    int left = -1;
+    for (int col=0; col<cell_width && left == -1; col++)
+      for (int row=0; row<cell_height && left == -1; row++)
+        if (gl_LTexture_get_pixel8(texture, b_x + col, b_y + row) != 0)
+          left = col;
+
+    int right = -1;
+    for (int col=cell_width-1; col>=0 && right == -1; col--)
+      for (int row=0; row<cell_height && right == -1; row++)
+        if (gl_LTexture_get_pixel8(texture, b_x + col, b_y + row) != 0)
+          right = col;
+
+    if (left != -1)
+    {
+      clips[i].x = b_x + left;
+      clips[i].w = right - left + 1;
+    }
+  }
+}
+
+void bench_bitmap_font_parse_()
+{
+  // 4096x4096 sheet, 256x256 cells with glyph-like blocks of varying size
+  const int size = 4096;
+  const int cell = size / 16;
+
+  gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+  gl_LTexture* texture = font->spritesheet->ltexture;
+  gl_LTexture_create_pixels8(texture, size, size);
+  for (int i=0; i<256; i++)
+  {
+    int b_x = cell * (i % 16);
+    int b_y = cell * (i / 16);
+    int w = 16 + (i * 37) % (cell - 48);
+    int h = 32 + (i * 53) % (cell - 64);
+    for (int y=0; y<h; y++)
+    {
+      memset(texture->pixels8 + (b_y + 24 + y) * texture->physical_width_ + b_x + 8, 0xFF, w);
+    }
+  }
+
+  LRect reference[256];
+  double start = now_ms_();
+  parse_bitmap_per_pixel_(texture, reference);
+  double per_pixel_ms = now_ms_() - start;
+
+  start = now_ms_();
+  gl_LFont_parse_bitmap(font);
+  double parse_ms = now_ms_() - start;
+
+  // compare horizontal bounds, vertical ones are trimmed by common top
+  int mismatches = 0;
+  for (int i=0; i<256; i++)
+  {
+    const LRect* clip = vector_get(font->spritesheet->clips, i);
+    if (clip->x != reference[i].x || clip->w != reference[i].w)
+    {
+      mismatches++;
+    }
+  }
+
+  SDL_Log("[benchmark] parse %dx%d bitmap font per-pixel column scan: %.3f ms, row scan: %.3f ms, mismatches: %d",
+      size, size, per_pixel_ms, parse_ms, mismatches);
+
+  gl_LFont_free(font);
+}
+
+void bench_glyph_run_()
+{
+  // paragraph of differently colored words with per-glyph wobble, rendered for a number of frames
+  const int frames = 100;
+  const int words = 200;
+  const char* word = "wobble";
+  const GLfloat word_width = 90.f;
+  const GLfloat line_height = 24.f;
+  const int words_per_line = 10;
+
+  gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+  if (!gl_LFont_load_freetype(font, BENCHMARK_FONT_PATH, 18))
+  {
+    SDL_Log("[benchmark] Unable to load font %s", BENCHMARK_FONT_PATH);
+    gl_LFont_free(font);
+    return;
+  }
+
+  gl_lfont_instanced_program2d* instanced_program = gl_lfont_instanced_program2d_new();
+  if (!gl_lfont_instanced_program2d_load_program(instanced_program))
+  {
+    SDL_Log("[benchmark] Unable to load instanced font program");
+    gl_lfont_instanced_program2d_free(instanced_program);
+    gl_LFont_free(font);
+    return;
+  }
+
+  GLuint vao = 0;
+  glGenVertexArrays(1, &vao);
+  glBindVertexArray(vao);
+
+  // span by span, each with its own color, and glyph by glyph matrix update
+  gl_LShaderProgram_bind(shared_font_shaderprogram->program);
+  glFinish();
+  double start = now_ms_();
+  for (int f=0; f<frames; f++)
+  {
+    for (int i=0; i<words; i++)
+    {
+      gl_lfont_polygon_program2d_set_text_color(shared_font_shaderprogram, (LColorRGBA){ (i % 3) / 2.f, (i % 5) / 4.f, 1.f, 1.f });
+      gl_LFont_render_text(font, word, (i % words_per_line) * word_width, (i / words_per_line) * line_height);
+    }
+  }
+  glFinish();
+  double spans_ms = (now_ms_() - start) / frames;
+  gl_lfont_polygon_program2d_set_text_color(shared_font_shaderprogram, (LColorRGBA){ 1.f, 1.f, 1.f, 1.f });
+  gl_LShaderProgram_unbind(shared_font_shaderprogram->program);
+  glBindVertexArray(0);
+
+  // whole paragraph as a single glyph run, animating instances every frame
+  gl_lglyph_run* run = gl_lglyph_run_new();
+  for (int i=0; i<words; i++)
+  {
+    gl_lglyph_run_add_text(run, font, word, (i % words_per_line) * word_width, (i / words_per_line) * line_height, NULL, 0, (LColorRGBA){ (i % 3) / 2.f, (i % 5) / 4.f, 1.f, 1.f });
+  }
+
+  gl_LShaderProgram_bind(instanced_program->program);
+  gl_lfont_instanced_program2d_update_modelview_matrix(instanced_program);
+  gl_lfont_instanced_program2d_set_texture_sampler(instanced_program, 0);
+  glFinish();
+  start = now_ms_();
+  for (int f=0; f<frames; f++)
+  {
+    for (int i=0; i<run->instance_count; i++)
+    {
+      run->instances[i].rotation = 0.1f * ((f + i) % 7 - 3);
+      run->instances[i].scale = 1.f + 0.05f * ((f + i) % 3);
+    }
+    gl_lglyph_run_render(run);
+  }
+  glFinish();
+  double run_ms = (now_ms_() - start) / frames;
+  gl_LShaderProgram_unbind(instanced_program->program);
+
+  SDL_Log("[benchmark] %d glyphs in %d colored spans per frame: %.3f ms | glyph run with per-glyph wobble: %.3f ms",
+      run->instance_count, words, spans_ms, run_ms);
+
+  glDeleteVertexArrays(1, &vao);
+  gl_lglyph_run_free(run);
+  gl_lfont_instanced_program2d_free(instanced_program);
+  gl_LFont_free(font);
+}
+
+double load_all_programs_(bool batched)
+{
+  // every program the sample loads at startup
+  double start = now_ms_();
+  if (batched)
+  {
+    gl_LShaderProgram_begin_batch();
+  }
+
+  gl_ltextured_polygon_program2d* textured = gl_ltextured_polygon_program2d_new();
+  gl_ltextured_polygon_program2d_load_program(textured);
+  gl_lfont_polygon_program2d* font = gl_lfont_polygon_program2d_new();
+  gl_lfont_polygon_program2d_load_program(font);
+  gl_lfont_polygon_program2d* sdf_font = gl_lfont_polygon_program2d_new();
+  gl_lfont_polygon_program2d_load_sdf_program(sdf_font);
+  gl_lfont_instanced_program2d* instanced_font = gl_lfont_instanced_program2d_new();
+  gl_lfont_instanced_program2d_load_program(instanced_font);
+  gl_lprogram* multicolor = gl_lprogram_new();
+  gl_lprogram_load_program(multicolor, "res/shaders/l_double_multicolor_polygon_program2d.vert", "res/shaders/l_double_multicolor_polygon_program2d.frag", NULL, 0);
+  if (batched)
+  {
+    gl_LShaderProgram_wait_all();
+  }
+  // programs are ready to draw with only after driver finished with them
+  glFinish();
+
+  double elapsed = now_ms_() - start;
+
+  gl_ltextured_polygon_program2d_free(textured);
+  gl_lfont_polygon_program2d_free(font);
+  gl_lfont_polygon_program2d_free(sdf_font);
+  gl_lfont_instanced_program2d_free(instanced_font);
+  gl_lprogram_free(multicolor);
+
+  return elapsed;
+}
+
+void bench_program_binary_cache_()
+{
+  // compile everything from source, one program after another, then all submitted before checking any
+  gl_LShaderProgram_set_binary_cache_dir(NULL);
+  double serial_ms = load_all_programs_(false);
+  double batched_ms = load_all_programs_(true);
+
+  // first run with cache stores binaries (or restores ones from previous start), second one restores them
+  gl_LShaderProgram_set_binary_cache_dir(BENCHMARK_SHADER_CACHE_DIR);
+  gl_LShaderProgram_cache_stats before = gl_LShaderProgram_get_cache_stats();
+  double store_ms = load_all_programs_(true);
+  double warm_ms = load_all_programs_(true);
+  gl_LShaderProgram_cache_stats after = gl_LShaderProgram_get_cache_stats();
+
+  SDL_Log("[benchmark] startup programs cold serial: %.3f ms | cold batched: %.3f ms | first run with cache: %.3f ms | warm: %.3f ms (binary hits: %u, compiles: %u, stores: %u)",
+      serial_ms, batched_ms, store_ms, warm_ms,
+      after.binary_hits - before.binary_hits,
+      after.compiles - before.compiles,
+      after.binary_stores - before.binary_stores);
+}
+
+void bench_frame_constants_()
+{
+  // resize storm, every resize changes projection, and view matrix for all programs
+  const int resizes = 1000;
+
+  gl_ltextured_polygon_program2d* textured = gl_ltextured_polygon_program2d_new();
+  gl_lfont_polygon_program2d* font = gl_lfont_polygon_program2d_new();
+  gl_lprogram* multicolor = gl_lprogram_new();
+  if (!gl_ltextured_polygon_program2d_load_program(textured) ||
+      !gl_lfont_polygon_program2d_load_program(font) ||
+      !gl_lprogram_load_program(multicolor, "res/shaders/l_double_multicolor_polygon_program2d.vert", "res/shaders/l_double_multicolor_polygon_program2d.frag", NULL, 0))
+  {
+    SDL_Log("[benchmark] Unable to load programs");
+    gl_ltextured_polygon_program2d_free(textured);
+    gl_lfont_polygon_program2d_free(font);
+    gl_lprogram_free(multicolor);
+    return;
+  }
+
+  gl_LShaderProgram* programs[3] = { textured->program, font->program, multicolor->program };
+  GLint locations[3] = { textured->modelview_matrix_location, font->modelview_matrix_location, glGetUniformLocation(multicolor->program->program_id, "modelview_matrix") };
+
+  // keep matrices to restore afterwards
+  gl_lframe_constants original;
+  memcpy(&original, gl_lframe_constants_get(), sizeof(original));
+
+  mat4 projection;
+  mat4 view;
+
+  // per-program, bind each program then upload both matrices as its own uniforms
+  // programs no longer have projection uniform, modelview location stands in for both uploads
+  glFinish();
+  double start = now_ms_();
+  for (int i=0; i<resizes; i++)
+  {
+    glm_ortho(0.0, 640.0 + i, 480.0 + i, 0.0, -1.0, 1.0, projection);
+    glm_mat4_identity(view);
+    glm_scale(view, (vec3){ 1.f + i * 0.001f, 1.f + i * 0.001f, 1.f });
+
+    for (int p=0; p<3; p++)
+    {
+      gl_LShaderProgram_bind(programs[p]);
+      gl_util_update_projection_matrix(locations[p], projection);
+      gl_util_update_modelview_matrix(locations[p], view);
+    }
+  }
+  glFinish();
+  double per_program_ms = now_ms_() - start;
+  gl_LShaderProgram_unbind(multicolor->program);
+
+  // frame constants, one buffer write regardless of number of programs
+  unsigned int uploads = gl_lframe_constants_upload_count();
+  glFinish();
+  start = now_ms_();
+  for (int i=0; i<resizes; i++)
+  {
+    glm_ortho(0.0, 640.0 + i, 480.0 + i, 0.0, -1.0, 1.0, projection);
+    glm_mat4_identity(view);
+    glm_scale(view, (vec3){ 1.f + i * 0.001f, 1.f + i * 0.001f, 1.f });
+
+    gl_lframe_constants_update(projection, view);
+  }
+  glFinish();
+  double frame_constants_ms = now_ms_() - start;
+  uploads = gl_lframe_constants_upload_count() - uploads;
+
+  gl_lframe_constants_update(original.projection_matrix, original.view_matrix);
+
+  SDL_Log("[benchmark] %d resizes across 3 programs, per-program uniforms: %.3f ms | frame constants: %.3f ms (%u uploads)",
+      resizes, per_program_ms, frame_constants_ms, uploads);
+
+  gl_ltextured_polygon_program2d_free(textured);
+  gl_lfont_polygon_program2d_free(font);
+  gl_lprogram_free(multicolor);
+}
+
+void bench_program_uniforms_()
+{
+  // sprites mostly drawn with the same tint, and a few distinct transforms
+  const int draws = 100000;
+
+  gl_lprogram* program = gl_lprogram_new();
+  if (!gl_lprogram_load_program(program, "res/shaders/l_textured_polygon_program2d.vert", "res/shaders/l_textured_polygon_program2d.frag", NULL, 0))
+  {
+    SDL_Log("[benchmark] Unable to load program");
+    gl_lprogram_free(program);
+    return;
+  }
+
+  mat4 transforms[4];
+  for (int i=0; i<4; i++)
+  {
+    glm_mat4_identity(transforms[i]);
+    glm_translate(transforms[i], (vec3){ i * 10.f, 0.f, 0.f });
+  }
+  vec4 tint = { 1.f, 1.f, 1.f, 1.f };
+
+  gl_LShaderProgram_bind(program->program);
+
+  // look up by name, and upload every draw
+  glFinish();
+  double start = now_ms_();
+  for (int i=0; i<draws; i++)
+  {
+    glUniformMatrix4fv(glGetUniformLocation(program->program->program_id, "modelview_matrix"), 1, GL_FALSE, transforms[(i / 64) % 4][0]);
+    glUniform4fv(glGetUniformLocation(program->program->program_id, "texture_color"), 1, tint);
+  }
+  glFinish();
+  double lookup_ms = now_ms_() - start;
+
+  // indices looked up once, redundant values skipped
+  const int modelview_index = gl_lprogram_uniform_index(program, "modelview_matrix");
+  const int tint_index = gl_lprogram_uniform_index(program, "texture_color");
+  glFinish();
+  start = now_ms_();
+  for (int i=0; i<draws; i++)
+  {
+    gl_lprogram_set_mat4(program, modelview_index, transforms[(i / 64) % 4]);
+    gl_lprogram_set_vec4(program, tint_index, tint);
+  }
+  glFinish();
+  double cached_ms = now_ms_() - start;
+
+  gl_LShaderProgram_unbind(program->program);
+
+  SDL_Log("[benchmark] %d draws of 2 uniforms, lookup by name: %.3f ms | reflected, cached setters: %.3f ms (%u uploads, %u skipped) | %d uniforms, %d attributes reflected",
+      draws, lookup_ms, cached_ms, program->uniform_uploads, program->uniform_skips, program->uniform_count, program->attrib_count);
+
+  gl_lprogram_free(program);
+}
+
+void bench_shader_variants_()
+{
+  // font program, plain, and distance field specialized from the same files
+  const int lookups = 10000;
+  const char* sdf[] = { "SDF" };
+  const char* sdf_tinted[] = { "SDF", "TINT=1" };
+  const char* tinted_sdf[] = { "TINT=1", "SDF" };
+
+  // build from source regardless of binary cache
+  gl_LShaderProgram_set_binary_cache_dir(NULL);
+
+  gl_lshader_variants* variants = gl_lshader_variants_new("res/shaders/l_font_program2d.vert", "res/shaders/l_font_program2d.frag");
+
+  double start = now_ms_();
+  gl_lprogram* plain = gl_lshader_variants_get(variants, NULL, 0);
+  gl_lprogram* distance = gl_lshader_variants_get(variants, sdf, 1);
+  gl_lprogram* distance_tinted = gl_lshader_variants_get(variants, sdf_tinted, 2);
+  glFinish();
+  double build_ms = now_ms_() - start;
+
+  // later requests are served from cache, order of defines doesn't matter
+  start = now_ms_();
+  int mismatches = 0;
+  for (int i=0; i<lookups; i++)
+  {
+    if (gl_lshader_variants_get(variants, tinted_sdf, 2) != distance_tinted ||
+        gl_lshader_variants_get(variants, sdf, 1) != distance ||
+        gl_lshader_variants_get(variants, NULL, 0) != plain)
+    {
+      mismatches++;
+    }
+  }
+  double lookup_ms = now_ms_() - start;
+
+  SDL_Log("[benchmark] shader variants, %u builds: %.3f ms | %d lookups: %.3f ms, mismatches: %d",
+      variants->builds, build_ms, lookups * 3, lookup_ms, mismatches);
+
+  gl_lshader_variants_free(variants);
+  gl_LShaderProgram_set_binary_cache_dir(BENCHMARK_SHADER_CACHE_DIR);
+}
+
+void bench_embedded_shaders_()
+{
+  // sources of all programs built at startup, includes resolved
+  const char* shaders[] = {
+    "res/shaders/l_textured_polygon_program2d.vert",
+    "res/shaders/l_textured_polygon_program2d.frag",
+    "res/shaders/l_font_program2d.vert",
+    "res/shaders/l_font_program2d.frag",
+    "res/shaders/l_font_instanced_program2d.vert",
+    "res/shaders/l_font_instanced_program2d.frag",
+    "res/shaders/l_double_multicolor_polygon_program2d.vert",
+    "res/shaders/l_double_multicolor_polygon_program2d.frag"
+  };
+  const int shader_count = sizeof(shaders) / sizeof(shaders[0]);
+  const int iterations = 100;
+
+  double elapsed_ms[2];
+  unsigned int file_loads[2];
+  for (int pass=0; pass<2; pass++)
+  {
+    // first pass reads files as before, second takes embedded sources
+    gl_lshader_source_set_read_from_disk(pass == 0);
+    const unsigned int file_loads_before = gl_lshader_source_get_stats().file_loads;
+
+    double start = now_ms_();
+    for (int n=0; n<iterations; n++)
+    {
+      for (int i=0; i<shader_count; i++)
+      {
+        free(gl_lshader_source_load(shaders[i], NULL, 0));
+      }
+    }
+    elapsed_ms[pass] = now_ms_() - start;
+    file_loads[pass] = gl_lshader_source_get_stats().file_loads - file_loads_before;
+  }
+#ifdef SHADERS_FROM_DISK
+  gl_lshader_source_set_read_from_disk(true);
+#else
+  gl_lshader_source_set_read_from_disk(false);
+#endif
+
+  SDL_Log("[benchmark] load %d shader sources x %d, from disk: %.3f ms (%u file reads), embedded: %.3f ms (%u file reads)",
+      shader_count, iterations, elapsed_ms[0], file_loads[0], elapsed_ms[1], file_loads[1]);
+}
+
+void bench_error_checks_()
+{
+  // small uploads as of per-sprite buffers, each followed by an error check
+  const int count = 10000;
+  GLuint indices[4] = { 0, 1, 2, 3 };
+
+  GLuint buffer = 0;
+  glGenBuffers(1, &buffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), NULL, GL_DYNAMIC_DRAW);
+  glFinish();
+
+  // glGetError() after every call as before
+  int errors = 0;
+  double start = now_ms_();
+  for (int i=0; i<count; i++)
+  {
+    indices[0] = i;
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(indices), indices);
+    if (glGetError() != GL_NO_ERROR)
+    {
+      errors++;
+    }
+  }
+  glFinish();
+  double always_ms = now_ms_() - start;
+
+  // as compiled, nothing in release build
+  start = now_ms_();
+  for (int i=0; i<count; i++)
+  {
+    indices[0] = i;
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(indices), indices);
+    if (GL_LDEBUG_GET_ERROR() != GL_NO_ERROR)
+    {
+      errors++;
+    }
+  }
+  glFinish();
+  double compiled_ms = now_ms_() - start;
+
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glDeleteBuffers(1, &buffer);
+
+#ifndef NDEBUG
+  const char* build = "debug";
+#else
+  const char* build = "release";
+#endif
+  SDL_Log("[benchmark] %d uploads, glGetError each: %.3f ms | GL_LDEBUG_GET_ERROR (%s build): %.3f ms, errors: %d, debug messages so far: %u",
+      count, always_ms, build, compiled_ms, errors, gl_ldebug_message_count());
+}
+
+void bench_samplers_()
+{
+  // toggle filtering of many textures back and forth, then draw-time binds
+  const int count = 256;
+  const int toggles = 20;
+  const int size = 16;
+
+  GLuint* pixels = calloc(size * size, sizeof(GLuint));
+  gl_LTexture** textures = malloc(count * sizeof(gl_LTexture*));
+  for (int i=0; i<count; i++)
+  {
+    textures[i] = gl_LTexture_new();
+    gl_LTexture_load_texture_from_pixels32(textures[i], pixels, size, size);
+  }
+  free(pixels);
+
+  gl_lsampler_desc nearest_desc = gl_lsampler_desc_default;
+  nearest_desc.min_filter = GL_NEAREST;
+  nearest_desc.mag_filter = GL_NEAREST;
+  const GLuint linear = gl_lsampler_cache_get(&gl_lsampler_desc_default);
+  const GLuint nearest = gl_lsampler_cache_get(&nearest_desc);
+  glFinish();
+
+  // per texture parameters, each texture has to be bound
+  double start = now_ms_();
+  for (int t=0; t<toggles; t++)
+  {
+    const GLenum filter = t % 2 == 0 ? GL_NEAREST : GL_LINEAR;
+    for (int i=0; i<count; i++)
+    {
+      glBindTexture(GL_TEXTURE_2D, textures[i]->texture_id);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    }
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glFinish();
+  double parameters_ms = now_ms_() - start;
+
+  // swap shared sampler, no GL call
+  start = now_ms_();
+  for (int t=0; t<toggles; t++)
+  {
+    const GLuint sampler = t % 2 == 0 ? nearest : linear;
+    for (int i=0; i<count; i++)
+    {
+      gl_LTexture_set_sampler(textures[i], sampler);
+    }
+  }
+  glFinish();
+  double samplers_ms = now_ms_() - start;
+
+  // textures sharing sampler, as drawn one after another
+  const gl_lsampler_cache_stats before = gl_lsampler_cache_get_stats();
+  start = now_ms_();
+  for (int i=0; i<count; i++)
+  {
+    glBindTexture(GL_TEXTURE_2D, textures[i]->texture_id);
+    gl_lsampler_cache_bind(0, textures[i]->sampler);
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glFinish();
+  double bind_ms = now_ms_() - start;
+  const gl_lsampler_cache_stats after = gl_lsampler_cache_get_stats();
+
+  for (int i=0; i<count; i++)
+  {
+    gl_LTexture_free(textures[i]);
+  }
+  free(textures);
+
+  SDL_Log("[benchmark] filter change of %d textures x %d, glTexParameteri: %.3f ms, sampler swap: %.3f ms | %d draw binds: %.3f ms, sampler binds %u, skipped %u, samplers %u",
+      count, toggles, parameters_ms, samplers_ms, count, bind_ms, after.binds - before.binds, after.skipped_binds - before.skipped_binds, after.samplers);
+}
+
+void bench_texture_array_()
+{
+  // sprites interleaved from many images, every sprite switches texture
+  const int image_count = 16;
+  const int sprite_count = 4096;
+  const int size = 32;
+
+  GLuint* pixels = malloc(size * size * sizeof(GLuint));
+  gl_LTexture** textures = malloc(image_count * sizeof(gl_LTexture*));
+  gl_ltexture_array* array = gl_ltexture_array_new();
+  if (!gl_ltexture_array_create(array, size, size, image_count))
+  {
+    SDL_Log("[benchmark] skip texture array, unable to create it");
+    gl_ltexture_array_free(array);
+    free(textures);
+    free(pixels);
+    return;
+  }
+  for (int i=0; i<image_count; i++)
+  {
+    for (int p=0; p<size * size; p++)
+    {
+      pixels[p] = 0xFF000000 | (i * 16);
+    }
+    textures[i] = gl_LTexture_new();
+    gl_LTexture_load_texture_from_pixels32(textures[i], pixels, size, size);
+    gl_ltexture_array_add_pixels32(array, pixels, size, size, size);
+  }
+  free(pixels);
+
+  const char* defines[] = { GL_LTEXTURE_ARRAY_DEFINE };
+  gl_lprogram* program = gl_lprogram_new();
+  if (!gl_lprogram_load_program_with_defines(program, "res/shaders/l_textured_polygon_program2d.vert", "res/shaders/l_textured_polygon_program2d.frag", defines, 1, NULL, 0))
+  {
+    SDL_Log("[benchmark] skip texture array, unable to load program");
+    gl_lprogram_free(program);
+    gl_ltexture_array_free(array);
+    for (int i=0; i<image_count; i++)
+    {
+      gl_LTexture_free(textures[i]);
+    }
+    free(textures);
+    return;
+  }
+  gl_ltexture_array_batch* batch = gl_ltexture_array_batch_new(array, program, 1024);
+
+  // one draw per sprite
+  gl_LShaderProgram_bind(shared_textured_shaderprogram->program);
+  glFinish();
+  double start = now_ms_();
+  for (int i=0; i<sprite_count; i++)
+  {
+    gl_LTexture_render(textures[i % image_count], (i % 64) * 4.f, (i / 64) * 4.f, NULL);
+  }
+  glFinish();
+  double separate_ms = now_ms_() - start;
+
+  // layers of texture array in batch
+  start = now_ms_();
+  for (int i=0; i<sprite_count; i++)
+  {
+    gl_ltexture_array_batch_add(batch, i % image_count, (i % 64) * 4.f, (i / 64) * 4.f, NULL);
+  }
+  gl_ltexture_array_batch_flush(batch);
+  glFinish();
+  double batched_ms = now_ms_() - start;
+
+  SDL_Log("[benchmark] %d sprites from %d images, separate textures: %.3f ms (%d draw calls) | texture array batch: %.3f ms (%u draw calls)",
+      sprite_count, image_count, separate_ms, sprite_count, batched_ms, batch->draw_calls);
+
+  // shared textured program is expected to be bound by others
+  gl_LShaderProgram_bind(shared_textured_shaderprogram->program);
+
+  gl_ltexture_array_batch_free(batch);
+  gl_lprogram_free(program);
+  gl_ltexture_array_free(array);
+  for (int i=0; i<image_count; i++)
+  {
+    gl_LTexture_free(textures[i]);
+  }
+  free(textures);
+}
+
+void bench_vertex_formats_()
+{
+  // spritesheet of small sprites, each rendered many times
+  const int size = 256;
+  const int sprite_size = 8;
+  const int sheet_sprites = (size / sprite_size) * (size / sprite_size);
+  const int sprite_count = 4096;
+  const LVertexFormat2D formats[2] = { LVERTEX_FORMAT_FLOAT, LVERTEX_FORMAT_COMPACT_SHORT };
+  double generate_ms[2];
+  double render_ms[2];
+
+  GLuint* pixels = malloc(size * size * sizeof(GLuint));
+  for (int p=0; p<size * size; p++)
+  {
+    pixels[p] = 0xFF000000 | p;
+  }
+
+  gl_LShaderProgram_bind(shared_textured_shaderprogram->program);
+  for (int f=0; f<2; f++)
+  {
+    gl_LTexture* texture = gl_LTexture_new();
+    gl_LTexture_load_texture_from_pixels32(texture, pixels, size, size);
+    gl_LSpritesheet* sheet = gl_LSpritesheet_new(texture);
+    sheet->vertex_format = formats[f];
+    for (int i=0; i<sheet_sprites; i++)
+    {
+      LRect clip = { (i % (size / sprite_size)) * sprite_size, (i / (size / sprite_size)) * sprite_size, sprite_size, sprite_size };
+      gl_LSpritesheet_add_clipsprite(sheet, &clip);
+    }
+
+    glFinish();
+    double start = now_ms_();
+    gl_LSpritesheet_generate_databuffer(sheet);
+    glFinish();
+    generate_ms[f] = now_ms_() - start;
+
+    start = now_ms_();
+    for (int i=0; i<sprite_count; i++)
+    {
+      gl_LSpritesheet_render_sprite(sheet, i % sheet_sprites, (i % 64) * 4.f, (i / 64) * 4.f);
+    }
+    glFinish();
+    render_ms[f] = now_ms_() - start;
+
+    // frees its texture too
+    gl_LSpritesheet_free(sheet);
+  }
+  free(pixels);
+
+  // sprites have no index buffer of their own, all share the same quad index buffer
+  SDL_Log("[benchmark] spritesheet %d sprites, float: %d bytes/sprite, generate %.3f ms, %d renders %.3f ms | compact: %d bytes/sprite, generate %.3f ms, %d renders %.3f ms | shared quad indices: %d bytes",
+      sheet_sprites,
+      4 * gl_lvertex_format_stride(LVERTEX_FORMAT_FLOAT), generate_ms[0], sprite_count, render_ms[0],
+      4 * gl_lvertex_format_stride(LVERTEX_FORMAT_COMPACT_SHORT), generate_ms[1], sprite_count, render_ms[1],
+      (int)(GL_LVERTEX_FORMAT_MAX_QUADS * 6 * sizeof(GLushort)));
+}
+
+#ifndef DISABLE_SDL_TTF_LIB
+void bench_text_cache_()
+{
+  if (gFont == NULL)
+  {
+    SDL_Log("[benchmark] skip text cache, no SDL_ttf font loaded");
+    return;
+  }
+
+  // window has OpenGL context but no renderer, rendered text goes to an offscreen software renderer instead
+  SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, 256, 256, 32, SDL_PIXELFORMAT_ABGR8888);
+  SDL_Renderer* renderer = target != NULL ? SDL_CreateSoftwareRenderer(target) : NULL;
+  if (renderer == NULL)
+  {
+    SDL_Log("[benchmark] skip text cache, unable to create software renderer: %s", SDL_GetError());
+    SDL_FreeSurface(target);
+    return;
+  }
+  SDL_Renderer* original_renderer = gWindow->renderer;
+  gWindow->renderer = renderer;
+
+  // HUD-like frame: a few static labels, and one counter changing every frame
+  const char* labels[] = { "Score", "Lives", "Level", "Time", "Ammo", "Health", "Armor", "Shield" };
+  const int label_count = sizeof(labels) / sizeof(labels[0]);
+  const int frames = 120;
+  const SDL_Color color = { 0xFF, 0xFF, 0xFF, 0xFF };
+  char counter[32];
+
+  // render every string every frame
+  unsigned int uncached_allocations = 0;
+  double start = now_ms_();
+  for (int f=0; f<frames; f++)
+  {
+    for (int i=0; i<label_count; i++)
+    {
+      LTexture* texture = LTexture_LoadFromRenderedText_withFont(labels[i], gFont, color, 0);
+      if (texture != NULL)
+      {
+        uncached_allocations++;
+        LTexture_Free(texture);
+      }
+    }
+    snprintf(counter, sizeof(counter), "%d", f);
+    LTexture* texture = LTexture_LoadFromRenderedText_withFont(counter, gFont, color, 0);
+    if (texture != NULL)
+    {
+      uncached_allocations++;
+      LTexture_Free(texture);
+    }
+  }
+  double uncached_ms = now_ms_() - start;
+
+  // through cache, only the counter is new each frame
+  LTextCache* cache = LTextCache_New(1024 * 1024);
+  unsigned int cached_allocations = 0;
+  size_t cached_upload_bytes = 0;
+  start = now_ms_();
+  for (int f=0; f<frames; f++)
+  {
+    LTextCache_BeginFrame(cache);
+    for (int i=0; i<label_count; i++)
+    {
+      LTextCache_Get(cache, labels[i], gFont, color, 0);
+    }
+    snprintf(counter, sizeof(counter), "%d", f);
+    LTextCache_Get(cache, counter, gFont, color, 0);
+
+    cached_allocations += cache->stats.frameAllocations;
+    cached_upload_bytes += cache->stats.frameUploadBytes;
+  }
+  double cached_ms = now_ms_() - start;
+
+  SDL_Log("[benchmark] %d frames of %d strings, uncached: %.3f ms, %.1f allocations/frame | text cache: %.3f ms, %.1f allocations/frame, %.0f upload bytes/frame, hits %u, misses %u, evictions %u",
+      frames, label_count + 1, uncached_ms, (float)uncached_allocations / frames,
+      cached_ms, (float)cached_allocations / frames, (double)cached_upload_bytes / frames,
+      cache->stats.hits, cache->stats.misses, cache->stats.evictions);
+  LTextCache_PrintStats(cache);
+
+  LTextCache_Free(cache);
+  gWindow->renderer = original_renderer;
+  SDL_DestroyRenderer(renderer);
+  SDL_FreeSurface(target);
+}
+#endif
+
+void benchmark_run_all()
+{
+  SDL_Log("[benchmark] begin");
+
+  bench_font_load_();
+  bench_texture_create_();
+  bench_asset_pack_();
+  bench_glyph_cache_();
+  bench_font_cache_();
+  bench_sdf_font_();
+  bench_font_load_many_();
+  bench_text_layout_();
+  bench_measure_strings_();
+  bench_font_registry_();
+  bench_bitmap_font_parse_();
+  bench_glyph_run_();
+  bench_program_binary_cache_();
+  bench_frame_constants_();
+  bench_program_uniforms_();
+  bench_shader_variants_();
+  bench_embedded_shaders_();
+  bench_error_checks_();
+  bench_samplers_();
+  bench_texture_array_();
+  bench_vertex_formats_();
+#ifndef DISABLE_SDL_TTF_LIB
+  bench_text_cache_();
+#endif
+
+  SDL_Log("[benchmark] end");
+}
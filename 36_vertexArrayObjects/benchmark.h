@@ -0,0 +1,14 @@
+#ifndef benchmark_h_
+#define benchmark_h_
+
+/// Micro benchmarks for library's hot paths.
+/// Results are printed via SDL_Log.
+/// Build with -DENABLE_BENCHMARK to run them once after media is loaded.
+/// It requires valid OpenGL context.
+
+///
+/// Run all benchmarks.
+///
+extern void benchmark_run_all();
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef DISABLE_SDL_TTF_LIB
+
+#include "LTextCache.h"
+#include "common.h"
+#include "krr_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+  /// cached texture, NULL if entry is free for reuse
+  LTexture* texture;
+  TTF_Font* font;
+  uint64_t textHash;
+  char* text;
+  SDL_Color color;
+  Uint32 wrapLength;
+  /// byte cost of texture
+  size_t bytes;
+  /// frame it's used last, entries used in the current frame are pinned
+  Uint32 lastFrame;
+  /// order of last use among entries
+  Uint64 lastUse;
+} LTextCacheEntry;
+
+static int FindEntry(LTextCache* cache, uint64_t textHash, const char* text, TTF_Font* font, SDL_Color color, Uint32 wrapLength);
+static void FreeEntry(LTextCache* cache, LTextCacheEntry* entry);
+static void EvictToFit(LTextCache* cache, size_t bytes);
+
+int FindEntry(LTextCache* cache, uint64_t textHash, const char* text, TTF_Font* font, SDL_Color color, Uint32 wrapLength)
+{
+  for (int i=0; i<cache->entries_->len; i++)
+  {
+    LTextCacheEntry* entry = vector_get(cache->entries_, i);
+    if (entry->texture != NULL &&
+        entry->textHash == textHash &&
+        entry->font == font &&
+        entry->wrapLength == wrapLength &&
+        entry->color.r == color.r &&
+        entry->color.g == color.g &&
+        entry->color.b == color.b &&
+        entry->color.a == color.a &&
+        strcmp(entry->text, text) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void FreeEntry(LTextCache* cache, LTextCacheEntry* entry)
+{
+  cache->stats.bytes -= entry->bytes;
+
+  LTexture_Free(entry->texture);
+  entry->texture = NULL;
+  free(entry->text);
+  entry->text = NULL;
+  entry->bytes = 0;
+}
+
+void EvictToFit(LTextCache* cache, size_t bytes)
+{
+  while (cache->stats.bytes + bytes > cache->byteBudget)
+  {
+    // least recently used entry which isn't used in the current frame
+    LTextCacheEntry* victim = NULL;
+    for (int i=0; i<cache->entries_->len; i++)
+    {
+      LTextCacheEntry* entry = vector_get(cache->entries_, i);
+      if (entry->texture != NULL &&
+          entry->lastFrame != cache->frame_ &&
+          (victim == NULL || entry->lastUse < victim->lastUse))
+      {
+        victim = entry;
+      }
+    }
+
+    // everything left is pinned, go over budget for now
+    if (victim == NULL)
+    {
+      return;
+    }
+
+    FreeEntry(cache, victim);
+    cache->stats.evictions++;
+  }
+}
+
+LTextCache* LTextCache_New(size_t byteBudget)
+{
+  LTextCache* out = malloc(sizeof(LTextCache));
+  memset(&out->stats, 0, sizeof(out->stats));
+  out->byteBudget = byteBudget;
+  out->entries_ = vector_new(16, sizeof(LTextCacheEntry));
+  // start at frame 1 as free entries have frame 0
+  out->frame_ = 1;
+  out->useStamp_ = 0;
+
+  return out;
+}
+
+void LTextCache_Free(LTextCache* cache)
+{
+  for (int i=0; i<cache->entries_->len; i++)
+  {
+    LTextCacheEntry* entry = vector_get(cache->entries_, i);
+    if (entry->texture != NULL)
+    {
+      FreeEntry(cache, entry);
+    }
+  }
+  vector_free(cache->entries_);
+  cache->entries_ = NULL;
+
+  free(cache);
+  cache = NULL;
+}
+
+void LTextCache_BeginFrame(LTextCache* cache)
+{
+  cache->frame_++;
+  cache->stats.frameAllocations = 0;
+  cache->stats.frameUploadBytes = 0;
+}
+
+LTexture* LTextCache_Get(LTextCache* cache, const char* textureText, TTF_Font* font, SDL_Color textColor, Uint32 wrapLength)
+{
+  if (font == NULL)
+  {
+    font = gFont;
+  }
+
+  uint64_t textHash = krr_hash_string(textureText);
+  int index = FindEntry(cache, textHash, textureText, font, textColor, wrapLength);
+  if (index != -1)
+  {
+    LTextCacheEntry* entry = vector_get(cache->entries_, index);
+    entry->lastFrame = cache->frame_;
+    entry->lastUse = ++cache->useStamp_;
+    cache->stats.hits++;
+    return entry->texture;
+  }
+  cache->stats.misses++;
+
+  LTexture* texture = LTexture_LoadFromRenderedText_withFont(textureText, font, textColor, wrapLength);
+  if (texture == NULL)
+  {
+    return NULL;
+  }
+  // textures created from surface are 32-bit
+  size_t bytes = (size_t)texture->width * texture->height * 4;
+  cache->stats.frameAllocations++;
+  cache->stats.frameUploadBytes += bytes;
+
+  EvictToFit(cache, bytes);
+
+  // find free entry for reuse, or add a new one
+  LTextCacheEntry* entry = NULL;
+  for (int i=0; i<cache->entries_->len && entry == NULL; i++)
+  {
+    LTextCacheEntry* e = vector_get(cache->entries_, i);
+    if (e->texture == NULL)
+    {
+      entry = e;
+    }
+  }
+  if (entry == NULL)
+  {
+    LTextCacheEntry empty;
+    memset(&empty, 0, sizeof(empty));
+    vector_add(cache->entries_, &empty);
+    entry = vector_get(cache->entries_, cache->entries_->len - 1);
+  }
+
+  entry->texture = texture;
+  entry->font = font;
+  entry->textHash = textHash;
+  entry->text = malloc(strlen(textureText) + 1);
+  strcpy(entry->text, textureText);
+  entry->color = textColor;
+  entry->wrapLength = wrapLength;
+  entry->bytes = bytes;
+  entry->lastFrame = cache->frame_;
+  entry->lastUse = ++cache->useStamp_;
+  cache->stats.bytes += bytes;
+
+  return texture;
+}
+
+void LTextCache_PrintStats(LTextCache* cache)
+{
+  unsigned int total = cache->stats.hits + cache->stats.misses;
+  SDL_Log("LTextCache: hits: %u, misses: %u (hit rate %.1f%%), evictions: %u, bytes: %zu / %zu, this frame: %u allocations, %zu bytes uploaded",
+      cache->stats.hits,
+      cache->stats.misses,
+      total > 0 ? cache->stats.hits * 100.0 / total : 0.0,
+      cache->stats.evictions,
+      cache->stats.bytes,
+      cache->byteBudget,
+      cache->stats.frameAllocations,
+      cache->stats.frameUploadBytes);
+}
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * LTextCache
+ *
+ * LRU cache of rendered text textures for SDL_Renderer path.
+ */
+
+#ifndef LTextCache_h_
+#define LTextCache_h_
+
+#ifndef DISABLE_SDL_TTF_LIB
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "SDL_ttf.h"
+#include "LTexture.h"
+#include "vector.h"
+
+/// Texture rendered via LTexture_LoadFromRenderedText_withFont() is kept keyed by (font, text, color, wrap length),
+/// so displaying the same string again neither renders it through SDL_ttf, nor uploads it again.
+///
+/// Cache keeps total texture bytes under its budget by evicting least recently used textures.
+/// Textures used in the current frame (see LTextCache_BeginFrame()) are never evicted, so
+/// budget can be exceeded temporarily when a single frame uses more than that.
+
+/// cache statistics
+typedef struct
+{
+  /// lookups satisfied by cached texture
+  unsigned int hits;
+  /// lookups that had to render text
+  unsigned int misses;
+  /// textures evicted to stay within budget
+  unsigned int evictions;
+
+  /// textures allocated in the current frame
+  unsigned int frameAllocations;
+  /// bytes uploaded in the current frame
+  size_t frameUploadBytes;
+
+  /// bytes of all textures currently cached
+  size_t bytes;
+} LTextCacheStats;
+
+typedef struct
+{
+  /// (read-only) statistics
+  LTextCacheStats stats;
+
+  /// (read-only) maximum bytes of textures to keep
+  size_t byteBudget;
+
+  /// (internal use) cached textures
+  vector* entries_;
+  /// (internal use) current frame number
+  Uint32 frame_;
+  /// (internal use) monotonic counter to order entries by last use
+  Uint64 useStamp_;
+} LTextCache;
+
+///
+/// Create a new text cache.
+///
+/// \param byteBudget Maximum bytes of textures to keep
+/// \return Newly created LTextCache
+///
+extern LTextCache* LTextCache_New(size_t byteBudget);
+
+///
+/// Free text cache along with all textures it holds.
+///
+/// \param cache LTextCache
+///
+extern void LTextCache_Free(LTextCache* cache);
+
+///
+/// Mark the start of a new frame.
+/// It resets per-frame allocation and upload counts, and unpins textures used in the previous frame.
+///
+/// \param cache LTextCache
+///
+extern void LTextCache_BeginFrame(LTextCache* cache);
+
+///
+/// Get texture of rendered text, render and cache it if it's not cached yet.
+/// Returned texture is owned by cache, don't free it. It's valid at least until the end of the current frame.
+///
+/// \param cache LTextCache
+/// \param textureText Text to render
+/// \param font Font to render text with. NULL to use global font.
+/// \param textColor Text color
+/// \param wrapLength Length in pixel to do wrapping with newline. Set to 0 to disable auto-wrapping.
+/// \return Texture of rendered text, or NULL if rendering failed.
+///
+extern LTexture* LTextCache_Get(LTextCache* cache, const char* textureText, TTF_Font* font, SDL_Color textColor, Uint32 wrapLength);
+
+///
+/// Print hit rate, memory, and allocations of the current frame.
+///
+/// \param cache LTextCache
+///
+extern void LTextCache_PrintStats(LTextCache* cache);
+
+#endif
+
+#endif /* LTextCache_h_ */
@@ -3,5 +3,47 @@
 
 // use -DNDEBUG to not include assert
 #include <assert.h>
+#include "SDL_log.h"
+
+// log levels
+// set via -DKRR_LOG_LEVEL=<level>, otherwise it's debug level for debug build, and error level for release build (-DNDEBUG)
+// logging below the level is compiled out along with evaluation of its arguments
+#define KRR_LOG_LEVEL_NONE 0
+#define KRR_LOG_LEVEL_ERROR 1
+#define KRR_LOG_LEVEL_WARN 2
+#define KRR_LOG_LEVEL_INFO 3
+#define KRR_LOG_LEVEL_DEBUG 4
+
+#ifndef KRR_LOG_LEVEL
+  #ifdef NDEBUG
+    #define KRR_LOG_LEVEL KRR_LOG_LEVEL_ERROR
+  #else
+    #define KRR_LOG_LEVEL KRR_LOG_LEVEL_DEBUG
+  #endif
+#endif
+
+#if KRR_LOG_LEVEL >= KRR_LOG_LEVEL_ERROR
+  #define KRR_LOGE(...) SDL_Log(__VA_ARGS__)
+#else
+  #define KRR_LOGE(...) ((void)0)
+#endif
+
+#if KRR_LOG_LEVEL >= KRR_LOG_LEVEL_WARN
+  #define KRR_LOGW(...) SDL_Log(__VA_ARGS__)
+#else
+  #define KRR_LOGW(...) ((void)0)
+#endif
+
+#if KRR_LOG_LEVEL >= KRR_LOG_LEVEL_INFO
+  #define KRR_LOGI(...) SDL_Log(__VA_ARGS__)
+#else
+  #define KRR_LOGI(...) ((void)0)
+#endif
+
+#if KRR_LOG_LEVEL >= KRR_LOG_LEVEL_DEBUG
+  #define KRR_LOGD(...) SDL_Log(__VA_ARGS__)
+#else
+  #define KRR_LOGD(...) ((void)0)
+#endif
 
 #endif /* common_debug_h_ */
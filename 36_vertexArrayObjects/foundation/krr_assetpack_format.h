@@ -0,0 +1,85 @@
+#ifndef krr_assetpack_format_h_
+#define krr_assetpack_format_h_
+
+#include <stdint.h>
+
+/// Binary layout of asset pack file.
+/// It's shared by packer tool (tools/assetpack.c), and engine's loader (gl/gl_lasset_pack.h).
+/// It has no dependency on OpenGL.
+///
+/// Layout
+///   [krr_assetpack_header]
+///   [krr_assetpack_entry] x entry_count, sorted by name_hash for binary search
+///   [data of each entry], each starts at KRR_ASSETPACK_ALIGNMENT aligned offset
+///
+/// All values are little-endian.
+
+#define KRR_ASSETPACK_MAGIC "KRRPACK"
+// 2: shader sources are stored with includes resolved
+#define KRR_ASSETPACK_VERSION 2
+#define KRR_ASSETPACK_ALIGNMENT 16
+#define KRR_ASSETPACK_MAX_NAME 64
+
+/// type of asset
+enum krr_assetpack_type
+{
+  /// texture's pixels ready to upload, see krr_assetpack_entry for its format
+  KRR_ASSETPACK_TYPE_TEXTURE = 1,
+  /// shader's source with includes resolved, null-terminated
+  KRR_ASSETPACK_TYPE_SHADER,
+  /// TTF font file's content
+  KRR_ASSETPACK_TYPE_FONT,
+  /// any other file's content as it is i.e. DDS
+  KRR_ASSETPACK_TYPE_RAW
+};
+
+/// pixel format of texture asset
+enum krr_assetpack_pixel_format
+{
+  /// 32-bit RGBA, 8-bit per channel
+  KRR_ASSETPACK_PIXEL_RGBA8 = 0,
+  /// 8-bit single channel
+  KRR_ASSETPACK_PIXEL_R8
+};
+
+typedef struct
+{
+  /// KRR_ASSETPACK_MAGIC with null-terminated
+  char magic[8];
+  /// KRR_ASSETPACK_VERSION
+  uint32_t version;
+  /// number of entries
+  uint32_t entry_count;
+} krr_assetpack_header;
+
+typedef struct
+{
+  /// asset name, usually its original path, null-terminated
+  char name[KRR_ASSETPACK_MAX_NAME];
+  /// krr_hash_string() of name
+  uint64_t name_hash;
+
+  /// offset of data from the beginning of file
+  uint64_t offset;
+  /// size of data in bytes
+  uint64_t size;
+
+  /// one of krr_assetpack_type
+  uint32_t type;
+
+  /// texture only
+  /// one of krr_assetpack_pixel_format
+  uint32_t pixel_format;
+  /// texture only, image dimensions
+  uint32_t width;
+  uint32_t height;
+  /// texture only, dimensions of stored pixels (level 0) which are padded to power-of-two
+  uint32_t physical_width;
+  uint32_t physical_height;
+  /// texture only, number of mipmap levels stored consecutively starting from level 0
+  uint32_t mip_count;
+  /// padding to keep structure size multiple of 8
+  uint32_t reserved_;
+} krr_assetpack_entry;
+
+#endif
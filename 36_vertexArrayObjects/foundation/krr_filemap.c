@@ -0,0 +1,122 @@
+// mmap(), and fstat() are hidden by -std=c99 without this
+#define _POSIX_C_SOURCE 200809L
+
+#include "krr_filemap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "SDL_log.h"
+
+#if defined __APPLE__ || defined __linux__
+#define HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifndef HAS_MMAP
+// fallback for platforms without mmap(), read the whole file into heap memory
+static bool read_whole_file_(krr_filemap* map, const char* path);
+
+bool read_whole_file_(krr_filemap* map, const char* path)
+{
+  FILE* file = fopen(path, "rb");
+  if (file == NULL)
+  {
+    SDL_Log("Unable to open file for read %s", path);
+    return false;
+  }
+
+  fseek(file, 0, SEEK_END);
+  long file_size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  if (file_size <= 0)
+  {
+    SDL_Log("File %s has zero bytes", path);
+    fclose(file);
+    return false;
+  }
+
+  void* buffer = malloc(file_size);
+  if (fread(buffer, file_size, 1, file) != 1)
+  {
+    SDL_Log("Read error for file %s", path);
+    free(buffer);
+    fclose(file);
+    return false;
+  }
+  fclose(file);
+
+  map->data = buffer;
+  map->size = file_size;
+  map->mapped_ = false;
+  return true;
+}
+#endif
+
+bool krr_filemap_open(krr_filemap* map, const char* path)
+{
+  map->data = NULL;
+  map->size = 0;
+  map->mapped_ = false;
+
+#ifdef HAS_MMAP
+  int fd = open(path, O_RDONLY);
+  if (fd == -1)
+  {
+    SDL_Log("Unable to open file for read %s", path);
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == -1 || st.st_size <= 0)
+  {
+    SDL_Log("Unable to get size of file %s, or it has zero bytes", path);
+    close(fd);
+    return false;
+  }
+
+  void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // mapping stays valid after closing its file descriptor
+  close(fd);
+
+  if (data == MAP_FAILED)
+  {
+    SDL_Log("Unable to memory-map file %s", path);
+    return false;
+  }
+
+  map->data = data;
+  map->size = st.st_size;
+  map->mapped_ = true;
+  return true;
+#else
+  return read_whole_file_(map, path);
+#endif
+}
+
+void krr_filemap_close(krr_filemap* map)
+{
+  if (map->data == NULL)
+  {
+    return;
+  }
+
+#ifdef HAS_MMAP
+  if (map->mapped_)
+  {
+    munmap((void*)map->data, map->size);
+  }
+  else
+  {
+    free((void*)map->data);
+  }
+#else
+  free((void*)map->data);
+#endif
+
+  map->data = NULL;
+  map->size = 0;
+  map->mapped_ = false;
+}
@@ -0,0 +1,39 @@
+#ifndef krr_filemap_h_
+#define krr_filemap_h_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/// Read-only view of a whole file's content.
+/// On Linux, Unix, and macOS file is memory-mapped so only touched pages are read from disk.
+/// On other platforms it falls back to read the whole file into heap memory.
+typedef struct
+{
+  /// pointer to file's content (read-only)
+  const void* data;
+
+  /// size of file's content in bytes
+  size_t size;
+
+  /// (internal use) true if data is memory-mapped, false if it's read into heap memory
+  bool mapped_;
+} krr_filemap;
+
+///
+/// Open file then map its whole content for read.
+///
+/// \param map Pointer to krr_filemap to be filled
+/// \param path Path to file
+/// \return True if successfully open, otherwise return false.
+///
+extern bool krr_filemap_open(krr_filemap* map, const char* path);
+
+///
+/// Close file map.
+/// After this call, data pointer is no longer valid.
+///
+/// \param map Pointer to krr_filemap
+///
+extern void krr_filemap_close(krr_filemap* map);
+
+#endif
@@ -0,0 +1,60 @@
+#include "krr_hash.h"
+#include <string.h>
+
+#define PRIME1 0x9E3779B185EBCA87ULL
+#define PRIME2 0xC2B2AE3D27D4EB4FULL
+#define PRIME3 0x165667B19E3779F9ULL
+
+static inline uint64_t rotl64_(uint64_t x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t mix_(uint64_t h, uint64_t k)
+{
+  k *= PRIME2;
+  k = rotl64_(k, 31);
+  k *= PRIME1;
+  h ^= k;
+  return rotl64_(h, 27) * PRIME1 + PRIME3;
+}
+
+uint64_t krr_hash_bytes(const void* data, size_t size, uint64_t seed)
+{
+  const unsigned char* p = data;
+  uint64_t h = seed ^ (size * PRIME1);
+
+  // bulk of data, 8 bytes at a time
+  // memcpy() avoids unaligned access, compiler turns it into a single load
+  size_t words = size / 8;
+  for (size_t i=0; i<words; i++)
+  {
+    uint64_t k;
+    memcpy(&k, p, 8);
+    h = mix_(h, k);
+    p += 8;
+  }
+
+  // remaining bytes
+  uint64_t tail = 0;
+  size_t remain = size & 7;
+  if (remain > 0)
+  {
+    memcpy(&tail, p, remain);
+    h = mix_(h, tail);
+  }
+
+  // final avalanche
+  h ^= h >> 33;
+  h *= PRIME2;
+  h ^= h >> 29;
+  h *= PRIME3;
+  h ^= h >> 32;
+
+  return h;
+}
+
+uint64_t krr_hash_string(const char* str)
+{
+  return krr_hash_bytes(str, strlen(str), 0);
+}
@@ -0,0 +1,29 @@
+#ifndef krr_hash_h_
+#define krr_hash_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Fast non-cryptographic 64-bit hash.
+/// It processes input 8 bytes at a time, good for large buffers i.e. image pixels.
+/// Don't use it for anything security related.
+
+///
+/// Hash bytes.
+///
+/// \param data Pointer to data
+/// \param size Size of data in bytes
+/// \param seed Seed value, use different seed to get different hash for the same data
+/// \return 64-bit hash value
+///
+extern uint64_t krr_hash_bytes(const void* data, size_t size, uint64_t seed);
+
+///
+/// Hash null-terminated string.
+///
+/// \param str Input string
+/// \return 64-bit hash value
+///
+extern uint64_t krr_hash_string(const char* str);
+
+#endif
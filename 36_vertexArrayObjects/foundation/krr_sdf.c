@@ -0,0 +1,202 @@
+#include "krr_sdf.h"
+#include "SDL_thread.h"
+#include "SDL_cpuinfo.h"
+#include <stdlib.h>
+#include <math.h>
+#include <stdbool.h>
+
+// distance larger than any bitmap, squared value still fits in int
+#define FAR_AWAY 9999
+
+// offset to the nearest seed pixel
+typedef struct
+{
+  int dx;
+  int dy;
+} point_;
+
+// work shared with worker thread
+typedef struct
+{
+  const krr_sdf_job* jobs;
+  int job_count;
+  int spread;
+  // process jobs of index thread_index, thread_index + thread_count, ...
+  int thread_index;
+  int thread_count;
+} worker_args_;
+
+static inline int dist2_(point_ p);
+static inline void compare_(point_* grid, int w, int h, point_* p, int x, int y, int ox, int oy);
+static void transform_(point_* grid, int w, int h);
+static int worker_run_(void* data);
+
+int dist2_(point_ p)
+{
+  return p.dx * p.dx + p.dy * p.dy;
+}
+
+void compare_(point_* grid, int w, int h, point_* p, int x, int y, int ox, int oy)
+{
+  int nx = x + ox;
+  int ny = y + oy;
+  if (nx < 0 || ny < 0 || nx >= w || ny >= h)
+  {
+    return;
+  }
+
+  // neighbor's nearest seed as seen from this pixel
+  point_ other = grid[ny * w + nx];
+  other.dx += ox;
+  other.dy += oy;
+
+  if (dist2_(other) < dist2_(*p))
+  {
+    *p = other;
+  }
+}
+
+void transform_(point_* grid, int w, int h)
+{
+  // pass 1, top to bottom
+  for (int y=0; y<h; y++)
+  {
+    for (int x=0; x<w; x++)
+    {
+      point_* p = &grid[y * w + x];
+      compare_(grid, w, h, p, x, y, -1,  0);
+      compare_(grid, w, h, p, x, y,  0, -1);
+      compare_(grid, w, h, p, x, y, -1, -1);
+      compare_(grid, w, h, p, x, y,  1, -1);
+    }
+    for (int x=w-1; x>=0; x--)
+    {
+      compare_(grid, w, h, &grid[y * w + x], x, y, 1, 0);
+    }
+  }
+
+  // pass 2, bottom to top
+  for (int y=h-1; y>=0; y--)
+  {
+    for (int x=w-1; x>=0; x--)
+    {
+      point_* p = &grid[y * w + x];
+      compare_(grid, w, h, p, x, y,  1,  0);
+      compare_(grid, w, h, p, x, y,  0,  1);
+      compare_(grid, w, h, p, x, y, -1,  1);
+      compare_(grid, w, h, p, x, y,  1,  1);
+    }
+    for (int x=0; x<w; x++)
+    {
+      compare_(grid, w, h, &grid[y * w + x], x, y, -1, 0);
+    }
+  }
+}
+
+void krr_sdf_generate(const krr_sdf_job* job, int spread)
+{
+  const int w = job->width + 2 * spread;
+  const int h = job->height + 2 * spread;
+  const point_ seed = { 0, 0 };
+  const point_ empty = { FAR_AWAY, FAR_AWAY };
+
+  // inside_grid finds distance to the nearest inside pixel (for outside pixels)
+  // outside_grid finds distance to the nearest outside pixel (for inside pixels)
+  point_* inside_grid = malloc(w * h * sizeof(point_));
+  point_* outside_grid = malloc(w * h * sizeof(point_));
+
+  for (int y=0; y<h; y++)
+  {
+    for (int x=0; x<w; x++)
+    {
+      int sx = x - spread;
+      int sy = y - spread;
+      bool inside = sx >= 0 && sy >= 0 && sx < job->width && sy < job->height && job->src[sy * job->pitch + sx] >= 128;
+
+      inside_grid[y * w + x] = inside ? seed : empty;
+      outside_grid[y * w + x] = inside ? empty : seed;
+    }
+  }
+
+  transform_(inside_grid, w, h);
+  transform_(outside_grid, w, h);
+
+  // positive distance is outside
+  // each pixel is a seed in exactly one grid, edge lies half a pixel from seed's center
+  const float scale = 0.5f / spread;
+  for (int i=0; i<w*h; i++)
+  {
+    int outside_d2 = dist2_(inside_grid[i]);
+    float d = outside_d2 > 0 ? sqrtf((float)outside_d2) - 0.5f : 0.5f - sqrtf((float)dist2_(outside_grid[i]));
+    float v = 0.5f - d * scale;
+    if (v < 0.f) v = 0.f;
+    if (v > 1.f) v = 1.f;
+    job->dst[i] = (unsigned char)(v * 255.f + 0.5f);
+  }
+
+  free(inside_grid);
+  free(outside_grid);
+}
+
+int worker_run_(void* data)
+{
+  const worker_args_* args = data;
+  for (int i=args->thread_index; i<args->job_count; i+=args->thread_count)
+  {
+    krr_sdf_generate(&args->jobs[i], args->spread);
+  }
+  return 0;
+}
+
+void krr_sdf_generate_many(const krr_sdf_job* jobs, int job_count, int spread, int thread_count)
+{
+  if (thread_count <= 0)
+  {
+    thread_count = SDL_GetCPUCount();
+  }
+  if (thread_count > job_count)
+  {
+    thread_count = job_count;
+  }
+  if (thread_count <= 1)
+  {
+    for (int i=0; i<job_count; i++)
+    {
+      krr_sdf_generate(&jobs[i], spread);
+    }
+    return;
+  }
+
+  worker_args_* args = malloc(thread_count * sizeof(worker_args_));
+  SDL_Thread** threads = malloc(thread_count * sizeof(SDL_Thread*));
+
+  // calling thread takes part as worker 0
+  for (int t=0; t<thread_count; t++)
+  {
+    args[t].jobs = jobs;
+    args[t].job_count = job_count;
+    args[t].spread = spread;
+    args[t].thread_index = t;
+    args[t].thread_count = thread_count;
+
+    threads[t] = t == 0 ? NULL : SDL_CreateThread(worker_run_, "krr_sdf", &args[t]);
+    // fallback to do its share on calling thread if thread cannot be created
+    if (t > 0 && threads[t] == NULL)
+    {
+      worker_run_(&args[t]);
+    }
+  }
+
+  worker_run_(&args[0]);
+
+  for (int t=1; t<thread_count; t++)
+  {
+    if (threads[t] != NULL)
+    {
+      SDL_WaitThread(threads[t], NULL);
+    }
+  }
+
+  free(threads);
+  free(args);
+}
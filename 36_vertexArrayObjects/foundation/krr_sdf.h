@@ -0,0 +1,45 @@
+#ifndef krr_sdf_h_
+#define krr_sdf_h_
+
+/// Signed distance field generation from 8-bit coverage bitmap i.e. glyph rendered by FreeType.
+/// It uses 8-point sequential signed Euclidean distance transform (8SSEDT) which runs in linear time.
+///
+/// Output is 8-bit, 128 is at the edge, higher values are inside the shape, lower values are outside.
+/// Distance in range [-spread, spread] pixels maps to [0, 255].
+
+/// a single bitmap to generate distance field for
+typedef struct
+{
+  /// source coverage bitmap, pixel is considered inside when its value >= 128
+  const unsigned char* src;
+  /// source dimensions in pixels
+  int width;
+  int height;
+  /// number of bytes per row of source
+  int pitch;
+
+  /// output of (width + 2*spread) x (height + 2*spread) bytes, tightly packed
+  /// source is centered, extra spread pixels on each side hold distance fall-off outside of shape
+  unsigned char* dst;
+} krr_sdf_job;
+
+///
+/// Generate distance field for a single bitmap.
+///
+/// \param job Job with source, and output to write into
+/// \param spread Maximum distance in pixels to encode
+///
+extern void krr_sdf_generate(const krr_sdf_job* job, int spread);
+
+///
+/// Generate distance fields for multiple bitmaps in parallel using worker threads.
+/// Jobs are independent so they are spread across threads, this function returns when all are done.
+///
+/// \param jobs Array of jobs
+/// \param job_count Number of jobs
+/// \param spread Maximum distance in pixels to encode
+/// \param thread_count Number of threads to use, 0 to use number of CPU cores
+///
+extern void krr_sdf_generate_many(const krr_sdf_job* jobs, int job_count, int spread, int thread_count);
+
+#endif
@@ -0,0 +1,79 @@
+#include "krr_utf8.h"
+
+uint32_t krr_utf8_next(const char** str)
+{
+  const unsigned char* s = (const unsigned char*)*str;
+
+  // end of string
+  if (s[0] == 0)
+  {
+    return 0;
+  }
+
+  // ASCII, the most common case
+  if (s[0] < 0x80)
+  {
+    *str += 1;
+    return s[0];
+  }
+
+  // determine length of sequence from leading byte
+  int length = 0;
+  uint32_t cp = 0;
+  uint32_t min_cp = 0;
+  if ((s[0] & 0xE0) == 0xC0)
+  {
+    length = 2;
+    cp = s[0] & 0x1F;
+    min_cp = 0x80;
+  }
+  else if ((s[0] & 0xF0) == 0xE0)
+  {
+    length = 3;
+    cp = s[0] & 0x0F;
+    min_cp = 0x800;
+  }
+  else if ((s[0] & 0xF8) == 0xF0)
+  {
+    length = 4;
+    cp = s[0] & 0x07;
+    min_cp = 0x10000;
+  }
+  else
+  {
+    // stray continuation byte, or invalid leading byte
+    *str += 1;
+    return KRR_UTF8_REPLACEMENT;
+  }
+
+  // continuation bytes, stops at null-terminator as it's not a continuation byte
+  for (int i=1; i<length; i++)
+  {
+    if ((s[i] & 0xC0) != 0x80)
+    {
+      *str += 1;
+      return KRR_UTF8_REPLACEMENT;
+    }
+    cp = (cp << 6) | (s[i] & 0x3F);
+  }
+
+  // reject overlong encoding, surrogates, and out of range
+  if (cp < min_cp || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+  {
+    *str += 1;
+    return KRR_UTF8_REPLACEMENT;
+  }
+
+  *str += length;
+  return cp;
+}
+
+int krr_utf8_length(const char* str)
+{
+  int count = 0;
+  while (krr_utf8_next(&str) != 0)
+  {
+    count++;
+  }
+  return count;
+}
@@ -0,0 +1,28 @@
+#ifndef krr_utf8_h_
+#define krr_utf8_h_
+
+#include <stdint.h>
+
+/// UTF-8 decoding.
+/// Invalid, or truncated sequence is decoded as KRR_UTF8_REPLACEMENT and skipped one byte at a time.
+
+/// code point returned for invalid sequence (U+FFFD)
+#define KRR_UTF8_REPLACEMENT 0xFFFD
+
+///
+/// Decode next code point from UTF-8 string, then advance string pointer past it.
+///
+/// \param str Pointer to pointer of null-terminated UTF-8 string. It will be advanced to the next code point.
+/// \return Decoded code point, or 0 when reached end of string (pointer is not advanced).
+///
+extern uint32_t krr_utf8_next(const char** str);
+
+///
+/// Count number of code points in UTF-8 string.
+///
+/// \param str Null-terminated UTF-8 string
+/// \return Number of code points
+///
+extern int krr_utf8_length(const char* str);
+
+#endif
@@ -8,19 +8,206 @@
 #include "gl/gl_LShaderProgram.h"
 #include "gl/gl_LFont_internals.h"
 #include "gl/gl_lfont_polygon_program2d.h"
-
-// spacing when render between character in pixel
-#define BETWEEN_CHAR_SPACING 4
+#include "gl/gl_ltext_layout.h"
+#include "gl/gl_ltexture_manager_internals.h"
+#include "gl/gl_lsampler_cache.h"
+#include "gl/gl_lvertex_format.h"
+#include "foundation/krr_filemap.h"
+#include "foundation/krr_hash.h"
+#include "foundation/krr_sdf.h"
+#include "foundation/krr_math.h"
+#include "foundation/krr_utf8.h"
+#include "SDL_thread.h"
+#include "SDL_mutex.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_timer.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 struct gl_lfont_polygon_program2d_* shared_font_shaderprogram = NULL;
 
+// baked font cache file, see gl_LFont_load_freetype_cached()
+#define FONT_CACHE_MAGIC "KRRFONT"
+// bump whenever baking result, or layout of cache file changes
+#define FONT_CACHE_VERSION 2
+#define FONT_CACHE_ALIGNMENT 16
+
+// layout: [header][LRect clips x clip_count][gl_LFont_kerning_pair x kerning_count][padding][8-bit pixels of physical_width x physical_height]
+typedef struct
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t pixel_size;
+  // hash of TTF file's content, cache is stale when font file changed
+  uint64_t font_hash;
+
+  uint32_t width;
+  uint32_t height;
+  uint32_t physical_width;
+  uint32_t physical_height;
+
+  uint32_t clip_count;
+  uint32_t kerning_count;
+  GLfloat space;
+  GLfloat line_height;
+  GLfloat newline;
+
+  uint64_t pixels_offset;
+} font_cache_header_;
+
+// maximum threads to bake a single font
+#define MAX_BAKE_THREADS 8
+
+// parsed bitmap font metrics cache file, see gl_LFont_load_bitmap_cached()
+#define BITMAP_METRICS_MAGIC "KRRBMET"
+#define BITMAP_METRICS_VERSION 1
+
+// layout: [header][LRect clips x clip_count]
+typedef struct
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t clip_count;
+  // hash of bitmap's pixels, cache is stale when image changed
+  uint64_t pixels_hash;
+
+  uint32_t width;
+  uint32_t height;
+  GLfloat space;
+  GLfloat line_height;
+  GLfloat newline;
+} bitmap_metrics_header_;
+
 // freetype font library
 // single shared variable for all instance of gl_LFont during lifetime of application
 static FT_Library freetype_library_ = NULL;
+// guards creating, and destroying faces of freetype_library_ from multiple threads
+static SDL_mutex* freetype_mutex_ = NULL;
+
+// where to open face from, either file path or TTF file's content in memory
+typedef struct
+{
+  const char* path;
+  const void* data;
+  size_t size;
+} font_source_;
+
+// rasterized glyph
+typedef struct
+{
+  FT_Glyph_Metrics metrics;
+  // tightly packed 8-bit pixels, NULL if glyph failed to rasterize
+  GLubyte* bitmap;
+  int width;
+  int rows;
+} glyph_bitmap_;
+
+// glyph's pixels to copy into atlas
+typedef struct
+{
+  const GLubyte* src;
+  int width;
+  int height;
+  int dst_x;
+  int dst_y;
+} glyph_blit_;
+
+// work of a single rasterizing thread
+typedef struct
+{
+  const font_source_* source;
+  GLuint pixel_size;
+  glyph_bitmap_* glyphs;
+  // 256 x 256 kerning table indexed by [left * 256 + right]
+  GLshort* kerning;
+  // range of glyphs [first, last), also range of left glyphs of kerning pairs
+  int first;
+  int last;
+  bool result;
+} rasterize_args_;
+
+// work of a single atlas assembling thread
+typedef struct
+{
+  gl_LTexture* atlas;
+  const glyph_blit_* blits;
+  // range of glyphs [first, last)
+  int first;
+  int last;
+} blit_args_;
+
+// parsed cell of bitmap font
+typedef struct
+{
+  LRect clip;
+  // first, and last row with non-background pixel relative to cell, -1 if cell is empty
+  int top;
+  int bottom;
+} bitmap_cell_;
+
+// work of a single bitmap font parsing thread
+typedef struct
+{
+  const gl_LTexture* texture;
+  GLfloat cell_width;
+  GLfloat cell_height;
+  bitmap_cell_* cells;
+  // range of cells [first, last)
+  int first;
+  int last;
+} parse_cells_args_;
+
+// work of a single font baking thread of gl_LFont_load_freetype_many()
+typedef struct
+{
+  gl_LFont_load_request* request;
+  int thread_count;
+} font_bake_args_;
 
 static void init_defaults_(gl_LFont* font);
 static void free_internals_(gl_LFont* font);
 static void report_freetype_error_(const FT_Error* error);
+// init shared freetype library if not yet, must be called on main thread
+static bool acquire_freetype_();
+// open face of source, and set its pixel size, it's thread-safe
+static bool open_face_(const font_source_* source, GLuint pixel_size, FT_Face* out_face);
+static void close_face_(FT_Face face);
+static int worker_thread_count_(int job_count);
+// run fn for each of count args, all but the first on worker threads, then wait for all
+static void run_parallel_(int (*fn)(void*), void* args, size_t arg_size, int count);
+static int rasterize_worker_(void* data);
+// rasterize all 256 glyphs, ranges of glyphs are rasterized in parallel each with its own face
+static bool rasterize_glyphs_(const font_source_* source, GLuint pixel_size, glyph_bitmap_* glyphs, GLshort* kerning, int thread_count);
+static void free_glyphs_(glyph_bitmap_* glyphs);
+static void set_kerning_(gl_LFont* font, const GLshort* kerning);
+static int compare_kerning_pair_(const void* a, const void* b);
+static int blit_worker_(void* data);
+// copy glyphs into atlas' pixels in parallel
+static void assemble_atlas_(gl_LTexture* atlas, const glyph_blit_* blits, int thread_count);
+// bake glyphs into spritesheet's pixels, clips, and spacing variables on CPU
+static bool bake_freetype_(gl_LFont* font, const font_source_* source, GLuint pixel_size, int thread_count);
+// bake signed distance field of glyphs
+static bool bake_freetype_sdf_(gl_LFont* font, const font_source_* source, GLuint pixel_size, GLuint spread, int thread_count);
+static int bake_font_worker_(void* data);
+// upload baked pixels, and build spritesheet's buffers
+static bool upload_baked_(gl_LFont* font);
+static void font_cache_file_path_(char* out, size_t out_size, const char* cache_dir, const char* path, GLuint pixel_size);
+static bool load_font_cache_(gl_LFont* font, const char* cache_file, uint64_t font_hash, GLuint pixel_size);
+static bool save_font_cache_(gl_LFont* font, const char* cache_file, uint64_t font_hash, GLuint pixel_size);
+static void render_layout_(gl_LFont* font, const gl_ltext_layout* layout, GLfloat x, GLfloat y);
+static void build_advances_(gl_LFont* font);
+static GLfloat measure_ascii_run_(const GLfloat* advances, const char** str);
+static LSize measure_string_(gl_LFont* font, const char* text);
+static int find_first_nonzero_(const GLubyte* pixels, int count);
+static int find_last_nonzero_(const GLubyte* pixels, int count);
+static int parse_cells_worker_(void* data);
+static bool load_bitmap_metrics_(gl_LFont* font, const char* cache_file, uint64_t pixels_hash);
+static bool save_bitmap_metrics_(gl_LFont* font, const char* cache_file, uint64_t pixels_hash);
 
 void init_defaults_(gl_LFont* font)
 {
@@ -28,6 +215,9 @@ void init_defaults_(gl_LFont* font)
   font->space = 0.f;
   font->line_height = 0.f;
   font->newline = 0.f;
+  font->padding = 0.f;
+  font->kerning_ = NULL;
+  font->advances_ = NULL;
 }
 
 void report_freetype_error_(const FT_Error* error)
@@ -37,11 +227,21 @@ void report_freetype_error_(const FT_Error* error)
 
 void free_internals_(gl_LFont* font)
 {
+  gl_ltext_layout_invalidate_font(font);
   gl_LSpritesheet_free(font->spritesheet);
 
+  if (font->kerning_ != NULL)
+  {
+    vector_free(font->kerning_);
+    font->kerning_ = NULL;
+  }
+  free(font->advances_);
+  font->advances_ = NULL;
+
   font->space = 0.f;
   font->line_height = 0.f;
   font->newline = 0.f;
+  font->padding = 0.f;
 }
 
 gl_LFont* gl_LFont_new(gl_LSpritesheet* spritesheet)
@@ -63,263 +263,135 @@ void gl_LFont_free(gl_LFont* font)
   font = NULL;
 }
 
-bool gl_LFont_load_bitmap(gl_LFont* font, const char* path)
-{
-  // expect image that is grayscale, in 16x16 ASCII order
-
-  // now gl_LTexture supports 8-bit grayscale image
-  // so black color is 0x0
-  const GLubyte black_pixel = 0x00;
 
-  // get rid of the font if it exists
-  gl_LFont_free_font(font);
+bool acquire_freetype_()
+{
+  if (freetype_library_ != NULL)
+  {
+    return true;
+  }
 
-  // image pixels loaded
-  gl_LTexture* texture = font->spritesheet->ltexture;
-  // load from grayscale 8-bit image
-  if (!gl_LTexture_load_pixels_from_file8(texture, path))
+  FT_Error error = FT_Init_FreeType(&freetype_library_);
+  if (error)
   {
-    SDL_Log("Unable to load pixels from file");
+    report_freetype_error_(&error);
+    freetype_library_ = NULL;
     return false;
   }
 
-  // get cell dimensions
-  // image has 16x16 cells
-  GLfloat cell_width = texture->width / 16.f;
-  GLfloat cell_height = texture->height / 16.f;
-
-  // get letter top and bottom
-  GLuint top = cell_height;
-  GLuint bottom = 0.f;
-  GLuint a_bottom = 0.f;
-
-  // current pixel coordinate
-  int p_x = 0;
-  int p_y = 0;
-
-  // base cell offsets
-  int b_x = 0;
-  int b_y = 0;
-
-  // begin parsing bitmap font
-  GLuint current_char = 0;
-  LRect next_clip = { 0.f, 0.f, cell_width, cell_height };
-
-  // go through cell rows
-  for (int row = 0; row < 16; row++)
-  {
-    // go through each cell column in the row
-    for (int col = 0; col < 16; col++)
-    {
-      // begin cell parsing
-      // set base offsets
-      b_x = cell_width * col;
-      b_y = cell_height * row;
-      
-      // initialize clip
-      next_clip.x = b_x;
-      next_clip.y = b_y;
-
-      next_clip.w = cell_width;
-      next_clip.h = cell_height;
-
-      // find boundary for character
-      // left side
-      for (int p_col = 0; p_col < cell_width; p_col++)
-      {
-        for (int p_row = 0; p_row < cell_height; p_row++)
-        {
-          // set pixel offset
-          p_x = b_x + p_col;
-          p_y = b_y + p_row;
-
-          // non-background pixel found
-          if (gl_LTexture_get_pixel8(texture, p_x, p_y) != black_pixel)
-          {
-            // set sprite's x offset
-            next_clip.x = p_x;
-
-            // break the loop
-            p_col = cell_width;
-            p_row = cell_height;
-          }
-        }
-      }
-
-      // right side
-      for (int p_col = cell_width-1; p_col >= 0; p_col--)
-      {
-        for (int p_row = 0; p_row < cell_height; p_row++)
-        {
-          // set pixel offset
-          p_x = b_x + p_col;
-          p_y = b_y + p_row;
-
-          // non background pixel found
-          if (gl_LTexture_get_pixel8(texture, p_x, p_y) != black_pixel)
-          {
-            // set sprite's width
-            next_clip.w = (p_x - next_clip.x) + 1;
-
-            // break the loop
-            p_col = -1;
-            p_row = cell_height;
-          }
-        }
-      }
+  freetype_mutex_ = SDL_CreateMutex();
+  return true;
+}
 
-      // find top
-      for (int p_row = 0; p_row < cell_height; p_row++)
-      {
-        for (int p_col = 0; p_col < cell_width; p_col++)
-        {
-          // set pixel offset
-          p_x = b_x + p_col;
-          p_y = b_y + p_row;
-
-          // non background pixel found
-          if (gl_LTexture_get_pixel8(texture, p_x, p_y) != black_pixel)
-          {
-            // new top found
-            if (p_row < top)
-            {
-              top = p_row;
-            }
-
-            // break the loop
-            p_row = cell_height;
-            p_col = cell_width;
-          }
-        }
-      }
+void gl_LFont_free_shared_freetype()
+{
+  if (freetype_library_ != NULL)
+  {
+    FT_Done_FreeType(freetype_library_);
+    freetype_library_ = NULL;
+  }
+  if (freetype_mutex_ != NULL)
+  {
+    SDL_DestroyMutex(freetype_mutex_);
+    freetype_mutex_ = NULL;
+  }
+}
 
-      // find bottom
-      for (int p_row = cell_height - 1; p_row >= 0; p_row--)
-      {
-        for (int p_col = 0; p_col < cell_width; p_col++)
-        {
-          // set pixel offset
-          p_x = b_x + p_col;
-          p_y = b_y + p_row;
-
-          // non background pixel found
-          if (gl_LTexture_get_pixel8(texture, p_x, p_y) != black_pixel)
-          {
-            // set baseline
-            if (current_char == 'A')
-            {
-              a_bottom = p_row;
-            }
-
-            // new bottom found
-            if (p_row > bottom)
-            {
-              bottom = p_row;
-            }
-
-            // break the loop
-            p_row = -1;
-            p_col = cell_width;
-          }
-        }
-      }
+bool open_face_(const font_source_* source, GLuint pixel_size, FT_Face* out_face)
+{
+  FT_Face face = NULL;
 
-      // go to the next character
-      vector_add(font->spritesheet->clips, &next_clip);
-      current_char++;
-    }
+  // creating, and destroying face modifies library so it has to be serialized
+  SDL_LockMutex(freetype_mutex_);
+  FT_Error error = 0;
+  if (source->path != NULL)
+  {
+    error = FT_New_Face(freetype_library_, source->path, 0, &face);
   }
-
-  // set top
-  // by lopping off extra height from all the character sprites
-  vector* clips = font->spritesheet->clips;
-  for (int t = 0; t < clips->len; t++)
+  else
   {
-    // get LRect
-    LRect* rect = (LRect*)vector_get(clips, t);
-
-    // update back
-    rect->y += top;
-    rect->h -= top;
+    // memory must stay valid until face is done
+    error = FT_New_Memory_Face(freetype_library_, (const FT_Byte*)source->data, source->size, 0, &face);
   }
+  SDL_UnlockMutex(freetype_mutex_);
 
-  // create texture from manipulated pixels
-  if (!gl_LTexture_load_texture_from_precreated_pixels8(texture))
+  // error 0 means success for FreeType
+  if (error)
   {
-    SDL_Log("Unable to create texture from precreated pixels");
+    report_freetype_error_(&error);
     return false;
   }
 
-  // build vertex buffer from spritesheet data
-  if (!gl_LSpritesheet_generate_databuffer(font->spritesheet))
+  error = FT_Set_Pixel_Sizes(face, 0, pixel_size);
+  if (error)
   {
-    SDL_Log("Unable to generate databuffer for spritesheet");
+    report_freetype_error_(&error);
+    close_face_(face);
     return false;
   }
 
-  // set texture wrap
-  glBindTexture(GL_TEXTURE_2D, texture->texture_id);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  // set spacing variables
-  font->space = cell_width / 2.f;
-  font->newline = a_bottom - top;
-  font->line_height = bottom - top;
-
+  *out_face = face;
   return true;
 }
 
-bool gl_LFont_load_freetype(gl_LFont* font, const char* path, GLuint pixel_size)
+void close_face_(FT_Face face)
 {
-  // free previously loaded font
-  gl_LFont_free_font(font);
+  SDL_LockMutex(freetype_mutex_);
+  FT_Done_Face(face);
+  SDL_UnlockMutex(freetype_mutex_);
+}
 
-  // init freetype
-  FT_Error error = 0;
+int worker_thread_count_(int job_count)
+{
+  int thread_count = krr_math_min(SDL_GetCPUCount(), MAX_BAKE_THREADS);
+  return krr_math_max(1, krr_math_min(thread_count, job_count));
+}
 
-  error = FT_Init_FreeType(&freetype_library_);
-  if (error)
+void run_parallel_(int (*fn)(void*), void* args, size_t arg_size, int count)
+{
+  SDL_Thread* threads[MAX_BAKE_THREADS];
+
+  // calling thread does the first share
+  for (int t=1; t<count; t++)
   {
-    report_freetype_error_(&error);
-    return false;
+    threads[t] = SDL_CreateThread(fn, "gl_LFont", (char*)args + t * arg_size);
+    // do its share on calling thread if thread cannot be created
+    if (threads[t] == NULL)
+    {
+      fn((char*)args + t * arg_size);
+    }
   }
 
-  // get cell dimensions
-  GLuint cell_width = 0;
-  GLuint cell_height = 0;
-  int max_bearing = 0;
-  int min_hang = 0;
+  fn(args);
 
-  // character data
-  // this is an array of pointer to gl_LTexture
-  gl_LTexture* bitmaps[256];
-  FT_Glyph_Metrics metrics[256];
-  
-  // load face
-  FT_Face face = NULL;
-  error = FT_New_Face(freetype_library_, path, 0, &face);
-  // error 0 means success for FreeType
-  if (error)
+  for (int t=1; t<count; t++)
   {
-    report_freetype_error_(&error);
-    return false;
+    if (threads[t] != NULL)
+    {
+      SDL_WaitThread(threads[t], NULL);
+    }
   }
+}
 
-  // set face size
-  error = FT_Set_Pixel_Sizes(face, 0, pixel_size);
-  if (error)
+int rasterize_worker_(void* data)
+{
+  rasterize_args_* args = data;
+  args->result = true;
+
+  // each thread has its own face as face is not thread-safe
+  FT_Face face = NULL;
+  if (!open_face_(args->source, args->pixel_size, &face))
   {
-    report_freetype_error_(&error);
-    return false;
+    args->result = false;
+    return 0;
   }
 
-  // go through extended ASCII to get glyph data
-  for (int i=0; i<256; i++)
+  for (int i=args->first; i<args->last; i++)
   {
+    glyph_bitmap_* glyph = &args->glyphs[i];
+
     // load and render glyph
-    error = FT_Load_Char(face, i, FT_LOAD_RENDER);
+    FT_Error error = FT_Load_Char(face, i, FT_LOAD_RENDER);
     if (error)
     {
       report_freetype_error_(&error);
@@ -327,350 +399,775 @@ bool gl_LFont_load_freetype(gl_LFont* font, const char* path, GLuint pixel_size)
       continue;
     }
 
-    // get metrics
-    metrics[i] = face->glyph->metrics;
-
-    // initialize gl_LTexture inside bitmaps array
-    bitmaps[i] = gl_LTexture_new();
-
-    // copy glyph bitmap
-    gl_LTexture_copy_pixels8(bitmaps[i], face->glyph->bitmap.buffer, face->glyph->bitmap.width, face->glyph->bitmap.rows);
-
-    // calculate max bearing
-    // as in http://lazyfoo.net/tutorials/OpenGL/23_freetype_fonts/index.php
-    // author claims that 1 point = 64 pixels
-    if (metrics[i].horiBearingY / 64 > max_bearing)
+    // copy glyph bitmap as glyph slot is reused for the next glyph
+    const FT_Bitmap* bitmap = &face->glyph->bitmap;
+    glyph->metrics = face->glyph->metrics;
+    glyph->width = bitmap->width;
+    glyph->rows = bitmap->rows;
+    glyph->bitmap = malloc(bitmap->width * bitmap->rows + 1);
+    for (unsigned int row=0; row<bitmap->rows; row++)
     {
-      max_bearing = metrics[i].horiBearingY / 64;
+      memcpy(glyph->bitmap + row * bitmap->width, bitmap->buffer + row * bitmap->pitch, bitmap->width);
     }
+  }
 
-    // calculate max width
-    if (metrics[i].width / 64 > cell_width)
+  // kerning pairs whose left glyph is in this thread's range
+  memset(args->kerning + args->first * 256, 0, (args->last - args->first) * 256 * sizeof(GLshort));
+  if (FT_HAS_KERNING(face))
+  {
+    FT_UInt indices[256];
+    for (int i=0; i<256; i++)
     {
-      cell_width = metrics[i].width / 64;
+      indices[i] = FT_Get_Char_Index(face, i);
     }
 
-    // calculate glyph hang
-    int glyph_hang = (metrics[i].horiBearingY - metrics[i].height) / 64;
-    if (glyph_hang < min_hang)
+    for (int left=args->first; left<args->last; left++)
     {
-      min_hang = glyph_hang;
+      if (indices[left] == 0)
+      {
+        continue;
+      }
+      for (int right=0; right<256; right++)
+      {
+        FT_Vector delta;
+        if (indices[right] != 0 && FT_Get_Kerning(face, indices[left], indices[right], FT_KERNING_DEFAULT, &delta) == 0)
+        {
+          // grid-fitted, in 26.6 fixed point
+          args->kerning[left * 256 + right] = delta.x / 64;
+        }
+      }
     }
   }
 
-  // create bitmap font
-  cell_height = max_bearing - min_hang;
-  // 16 by 16 cells in creation
-  gl_LTexture_create_pixels8(font->spritesheet->ltexture, cell_width * 16, cell_height * 16);
-  
-  // begin creating bitmap font
-  GLuint current_char = 0;
-  LRect next_clip = { 0.f, 0.f, cell_width, cell_height };
-
-  // blitting coordinates
-  int b_x = 0;
-  int b_y = 0;
+  close_face_(face);
+  return 0;
+}
 
-  // go through cell rows
-  for (unsigned int rows = 0; rows < 16; rows++)
+bool rasterize_glyphs_(const font_source_* source, GLuint pixel_size, glyph_bitmap_* glyphs, GLshort* kerning, int thread_count)
+{
+  for (int i=0; i<256; i++)
   {
-    // go through each cell column in the row
-    for (unsigned int cols = 0; cols < 16; cols++)
-    {
-      // set base offsets
-      b_x = cell_width * cols;
-      b_y = cell_height * rows;
-
-      // initialize clip
-      next_clip.x = b_x;
-      next_clip.y = b_y;
-      next_clip.w = metrics[current_char].width / 64;
-      next_clip.h = cell_height;
-
-      // blit character
-      gl_LTexture_blit_pixels8(bitmaps[current_char], b_x, b_y + max_bearing - metrics[current_char].horiBearingY / 64, font->spritesheet->ltexture);
+    memset(&glyphs[i], 0, sizeof(glyph_bitmap_));
+  }
 
-      // go to the next character
-      vector_add(font->spritesheet->clips, &next_clip);
-      current_char++;
-    }
+  // split glyphs into contiguous ranges, one per thread
+  rasterize_args_ args[MAX_BAKE_THREADS];
+  for (int t=0; t<thread_count; t++)
+  {
+    args[t].source = source;
+    args[t].pixel_size = pixel_size;
+    args[t].glyphs = glyphs;
+    args[t].kerning = kerning;
+    args[t].first = 256 * t / thread_count;
+    args[t].last = 256 * (t + 1) / thread_count;
+    args[t].result = false;
   }
 
-  // we are done with bitmaps
-  // free them all now
-  // free all allocated bitmaps
-  for (int i=0; i<256; i++)
+  run_parallel_(rasterize_worker_, args, sizeof(rasterize_args_), thread_count);
+
+  for (int t=0; t<thread_count; t++)
   {
-    if (bitmaps[i] != NULL)
+    if (!args[t].result)
     {
-      gl_LTexture_free(bitmaps[i]);
-      bitmaps[i] = NULL;
+      free_glyphs_(glyphs);
+      return false;
     }
   }
+  return true;
+}
 
-  // make texture power of two
-  gl_LTexture_pad_pixels8(font->spritesheet->ltexture);
-
-  // create texture
-  if (!gl_LTexture_load_texture_from_precreated_pixels8(font->spritesheet->ltexture))
+void free_glyphs_(glyph_bitmap_* glyphs)
+{
+  for (int i=0; i<256; i++)
   {
-    SDL_Log("Unable to create texture from pre-created pixels8");
-    return false;
+    free(glyphs[i].bitmap);
+    glyphs[i].bitmap = NULL;
   }
+}
 
-  // build vertex buffer from sprite sheet data
-  if (!gl_LSpritesheet_generate_databuffer(font->spritesheet))
+void set_kerning_(gl_LFont* font, const GLshort* kerning)
+{
+  // keep only non-zero pairs, most fonts kern a small fraction of them
+  // pairs are added in order of key, so it's already sorted
+  for (int i=0; i<256 * 256; i++)
   {
-    SDL_Log("Unable to geneate databuffer");
-    return false;
+    if (kerning[i] != 0)
+    {
+      if (font->kerning_ == NULL)
+      {
+        font->kerning_ = vector_new(64, sizeof(gl_LFont_kerning_pair));
+      }
+      gl_LFont_kerning_pair pair = { i, kerning[i] };
+      vector_add(font->kerning_, &pair);
+    }
   }
-
-  // set texture wrap
-  glBindTexture(GL_TEXTURE_2D, font->spritesheet->ltexture->texture_id);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  // set spacing variables
-  font->space = cell_width / 2.0f;
-  font->line_height = cell_height;
-  font->newline = max_bearing;
-
-  // free face
-  FT_Done_Face(face);
-  face = NULL;
-
-  // free freetype
-  FT_Done_FreeType(freetype_library_);
-  freetype_library_ = NULL;
-
-  return true;
 }
 
-void gl_LFont_free_font(gl_LFont* font)
+int compare_kerning_pair_(const void* a, const void* b)
 {
-  // clear the sheet
-  gl_LSpritesheet_free_sheet(font->spritesheet);
-  // clear the underlying 
-  gl_LTexture_free_internal_texture(font->spritesheet->ltexture);
-
-  // reinitialize spacing constants
-  font->space = 0.f;
-  font->line_height = 0.f;
-  font->newline = 0.f;
+  return (int)((const gl_LFont_kerning_pair*)a)->key - (int)((const gl_LFont_kerning_pair*)b)->key;
 }
 
-void gl_LFont_render_text(gl_LFont* font, const char* text, GLfloat x, GLfloat y)
+GLfloat gl_LFont_get_kerning(gl_LFont* font, GLuint left, GLuint right)
 {
-  // if there is texture to render from
-  if (font->spritesheet->ltexture->texture_id != 0)
+  if (font->kerning_ == NULL || left > 255 || right > 255)
   {
-    // get spritesheet
-    gl_LSpritesheet* ss = font->spritesheet;
-    // get texture id
-    GLuint texture_id = ss->ltexture->texture_id;
-
-    // draw position
-    GLfloat render_x = x;
-    GLfloat render_y = y;
-
-    // save current state of modelview matrix
-    mat4 original_modelview_matrix;
-    // copy the current modelview matrix to original one, then we will work further on modelview matrix attached to shared_font_shaderprogram
-    glm_mat4_copy(shared_font_shaderprogram->modelview_matrix, original_modelview_matrix);
-
-    // translate to rendering position
-    glm_translate(shared_font_shaderprogram->modelview_matrix, (vec3){x, y, 0.f});
-    // issue update to gpu
-    gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
-
-    // set texture
-    glBindTexture(GL_TEXTURE_2D, texture_id);
-
-    // enable all attribute pointers
-    gl_lfont_polygon_program2d_enable_attrib_pointers(shared_font_shaderprogram);
+    return 0.f;
+  }
 
-    // bind vertex data
-    glBindBuffer(GL_ARRAY_BUFFER, ss->vertex_data_buffer);
+  gl_LFont_kerning_pair needle = { left << 8 | right, 0 };
+  const gl_LFont_kerning_pair* pair = bsearch(&needle, font->kerning_->buffer, font->kerning_->len, sizeof(gl_LFont_kerning_pair), compare_kerning_pair_);
+  return pair != NULL ? pair->amount : 0.f;
+}
 
-    // set texture coordinate attrib pointer
-    gl_lfont_polygon_program2d_set_texcoord_pointer(shared_font_shaderprogram, sizeof(LVertexData2D), (GLvoid*)offsetof(LVertexData2D, texcoord));
-    // set vertex data attrib pointer
-    gl_lfont_polygon_program2d_set_vertex_pointer(shared_font_shaderprogram, sizeof(LVertexData2D), (GLvoid*)offsetof(LVertexData2D, position));
+int blit_worker_(void* data)
+{
+  const blit_args_* args = data;
+  gl_LTexture* atlas = args->atlas;
 
-    // go through string
-    int text_length = strlen(text);
-    for (int i=0; i<text_length; i++)
+  for (int i=args->first; i<args->last; i++)
+  {
+    const glyph_blit_* blit = &args->blits[i];
+    for (int row=0; row<blit->height; row++)
     {
-      // space
-      if (text[i] == ' ')
-      {
-        // translate modelview matrix
-        glm_translate_x(shared_font_shaderprogram->modelview_matrix, font->space);
-        // issue update to gpu
-        gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
-        render_x += font->space;
-      }
-      else if (text[i] == '\n')
-      {
-        // translate modelview matrix
-        glm_translate(shared_font_shaderprogram->modelview_matrix, (vec3){ x - render_x, font->newline, 0.f});
-        // issue update to gpu
-        gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
-        render_y += font->newline;
-        render_x += x - render_x;
-      }
-      else
-      {
-        // get ascii
-        GLuint ascii = (unsigned char)text[i];
-
-        // draw quad using vertex data and index data
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ss->index_buffers[ascii]);
-        glDrawElements(GL_TRIANGLE_FAN, 4, GL_UNSIGNED_INT, NULL);
-
-        // get clip
-        LRect* clip = (LRect*)vector_get(ss->clips, ascii);
-        // move over
-        glm_translate_x(shared_font_shaderprogram->modelview_matrix, clip->w + BETWEEN_CHAR_SPACING);
-        // issue update to gpu
-        gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
-        render_x += clip->w + BETWEEN_CHAR_SPACING;
-      }
+      memcpy(atlas->pixels8 + (blit->dst_y + row) * atlas->physical_width_ + blit->dst_x, blit->src + row * blit->width, blit->width);
     }
+  }
 
-    // unbind
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-    // disable all attribute pointers
-    gl_lfont_polygon_program2d_disable_attrib_pointers(shared_font_shaderprogram);
+  return 0;
+}
 
-    // set modelview matrix back to original one
-    glm_mat4_copy(original_modelview_matrix, shared_font_shaderprogram->modelview_matrix);
+void assemble_atlas_(gl_LTexture* atlas, const glyph_blit_* blits, int thread_count)
+{
+  // glyphs land on disjoint cells, so each thread blits its own range without locking
+  blit_args_ args[MAX_BAKE_THREADS];
+  for (int t=0; t<thread_count; t++)
+  {
+    args[t].atlas = atlas;
+    args[t].blits = blits;
+    args[t].first = 256 * t / thread_count;
+    args[t].last = 256 * (t + 1) / thread_count;
   }
+
+  run_parallel_(blit_worker_, args, sizeof(blit_args_), thread_count);
 }
 
-void gl_LFont_render_textex(gl_LFont* font, const char* text, GLfloat x, GLfloat y, const LSize* area_size, int align)
+bool bake_freetype_(gl_LFont* font, const font_source_* source, GLuint pixel_size, int thread_count)
 {
-  // get spritesheet
-  gl_LSpritesheet* ss = font->spritesheet;
-  // get texture id
-  GLuint texture_id = ss->ltexture->texture_id;
+  glyph_bitmap_ glyphs[256];
+  GLshort* kerning = malloc(256 * 256 * sizeof(GLshort));
+  if (!rasterize_glyphs_(source, pixel_size, glyphs, kerning, thread_count))
+  {
+    free(kerning);
+    return false;
+  }
+  set_kerning_(font, kerning);
+  free(kerning);
 
-  // draw position
-  GLfloat render_x = x;
-  GLfloat render_y = y;
+  // get cell dimensions
+  GLuint cell_width = 0;
+  GLuint cell_height = 0;
+  int max_bearing = 0;
+  int min_hang = 0;
 
-  // if the text needs to be aligned
-  if (area_size != NULL)
+  for (int i=0; i<256; i++)
   {
-    // correct empty alignment
-    if (align == 0)
-    {
-      align = gl_LFont_TEXT_ALIGN_LEFT | gl_LFont_TEXT_ALIGN_TOP;
-    }
+    const FT_Glyph_Metrics* metrics = &glyphs[i].metrics;
 
-    // handle horizontal alignment
-    if (align & gl_LFont_TEXT_ALIGN_CENTERED_H)
-    {
-      render_x = x + (area_size->w - gl_LFont_string_width(font, text)) / 2.f;
-    }
-    else if (align & gl_LFont_TEXT_ALIGN_RIGHT)
+    // calculate max bearing
+    // as in http://lazyfoo.net/tutorials/OpenGL/23_freetype_fonts/index.php
+    // author claims that 1 point = 64 pixels
+    if (metrics->horiBearingY / 64 > max_bearing)
     {
-      render_x = x + area_size->w - gl_LFont_string_width(font, text);
+      max_bearing = metrics->horiBearingY / 64;
     }
 
-    // handle vertical alignment
-    if (align & gl_LFont_TEXT_ALIGN_CENTERED_V)
+    // calculate max width
+    if (metrics->width / 64 > cell_width)
     {
-      render_y = y + (area_size->h - gl_LFont_string_height(font, text)) / 2.f;
+      cell_width = metrics->width / 64;
     }
-    else if (align & gl_LFont_TEXT_ALIGN_BOTTOM)
+
+    // calculate glyph hang
+    int glyph_hang = (metrics->horiBearingY - metrics->height) / 64;
+    if (glyph_hang < min_hang)
     {
-      render_y = y + area_size->h - gl_LFont_string_height(font, text);
+      min_hang = glyph_hang;
     }
   }
 
-  // save current state of modelview matrix
-  mat4 original_modelview_matrix;
-  // from this frame, we will operate on top of current modelview matrix then when done
-  // we will set back original modelview matrix back (pretty much similar to fixed-function pipeline)
-  glm_mat4_copy(shared_font_shaderprogram->modelview_matrix, original_modelview_matrix);
+  // create bitmap font
+  cell_height = max_bearing - min_hang;
+  // 16 by 16 cells in creation
+  gl_LTexture_create_pixels8(font->spritesheet->ltexture, cell_width * 16, cell_height * 16);
 
-  // translate to render position
-  glm_translate(shared_font_shaderprogram->modelview_matrix, (vec3){render_x, render_y, 0.f});
-  // update modelview matrix immediately
-  gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
+  // lay out glyphs in cells
+  glyph_blit_ blits[256];
+  for (int i=0; i<256; i++)
+  {
+    // set base offsets
+    int b_x = cell_width * (i % 16);
+    int b_y = cell_height * (i / 16);
+
+    LRect next_clip = { b_x, b_y, glyphs[i].metrics.width / 64, cell_height };
+    vector_add(font->spritesheet->clips, &next_clip);
+
+    blits[i].src = glyphs[i].bitmap;
+    blits[i].width = glyphs[i].bitmap != NULL ? glyphs[i].width : 0;
+    blits[i].height = glyphs[i].bitmap != NULL ? glyphs[i].rows : 0;
+    blits[i].dst_x = b_x;
+    blits[i].dst_y = b_y + max_bearing - glyphs[i].metrics.horiBearingY / 64;
+  }
 
-  // set texture
-  glBindTexture(GL_TEXTURE_2D, texture_id);
+  // blit characters
+  assemble_atlas_(font->spritesheet->ltexture, blits, thread_count);
 
-  // enable all attribute pointers
-  gl_lfont_polygon_program2d_enable_attrib_pointers(shared_font_shaderprogram);
+  // we are done with bitmaps
+  free_glyphs_(glyphs);
 
-  // bind vertex data
-  glBindBuffer(GL_ARRAY_BUFFER, ss->vertex_data_buffer);
+  // make texture power of two
+  gl_LTexture_pad_pixels8(font->spritesheet->ltexture);
 
-  // set texcoord vertex pointer
-  gl_lfont_polygon_program2d_set_texcoord_pointer(shared_font_shaderprogram, sizeof(LVertexData2D), (GLvoid*)offsetof(LVertexData2D, texcoord));
-  gl_lfont_polygon_program2d_set_vertex_pointer(shared_font_shaderprogram, sizeof(LVertexData2D), (GLvoid*)offsetof(LVertexData2D, position));
+  // set spacing variables
+  font->space = cell_width / 2.0f;
+  font->line_height = cell_height;
+  font->newline = max_bearing;
+
+  return true;
+}
 
-  // go through string
-  int text_length = strlen(text);
-  for (int i=0; i<text_length; i++)
+bool bake_freetype_sdf_(gl_LFont* font, const font_source_* source, GLuint pixel_size, GLuint spread, int thread_count)
+{
+  glyph_bitmap_ glyphs[256];
+  GLshort* kerning = malloc(256 * 256 * sizeof(GLshort));
+  if (!rasterize_glyphs_(source, pixel_size, glyphs, kerning, thread_count))
+  {
+    free(kerning);
+    return false;
+  }
+  set_kerning_(font, kerning);
+  free(kerning);
+
+  krr_sdf_job jobs[256];
+  int job_count = 0;
+  GLubyte* fields[256];
+  int max_width = 0;
+  int max_bearing = 0;
+  int min_hang = 0;
+
+  for (int i=0; i<256; i++)
   {
-    // space
-    if (text[i] == ' ')
+    const FT_Glyph_Metrics* metrics = &glyphs[i].metrics;
+    fields[i] = NULL;
+
+    if (glyphs[i].bitmap != NULL)
+    {
+      fields[i] = malloc((glyphs[i].width + 2 * spread) * (glyphs[i].rows + 2 * spread));
+
+      krr_sdf_job* job = &jobs[job_count++];
+      job->src = glyphs[i].bitmap;
+      job->width = glyphs[i].width;
+      job->height = glyphs[i].rows;
+      job->pitch = glyphs[i].width;
+      job->dst = fields[i];
+    }
+
+    // 1 pixel = 64 units in 26.6 fixed point
+    if (metrics->horiBearingY / 64 > max_bearing)
     {
-      // translate modelview matrix
-      glm_translate_x(shared_font_shaderprogram->modelview_matrix, font->space);
-      // immediately issue udpate to gpu
-      gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
-      render_x += font->space;
+      max_bearing = metrics->horiBearingY / 64;
     }
-    // newlines
-    else if (text[i] == '\n')
+    if (metrics->width / 64 > max_width)
     {
-      // handle horizontal alignment
-      GLfloat target_x = x;
+      max_width = metrics->width / 64;
+    }
+    int glyph_hang = (metrics->horiBearingY - metrics->height) / 64;
+    if (glyph_hang < min_hang)
+    {
+      min_hang = glyph_hang;
+    }
+  }
 
-      if (area_size != NULL)
-      {
-        // handle horizontal alignment
-        if (align & gl_LFont_TEXT_ALIGN_CENTERED_H)
-        {
-          target_x += (area_size->w - gl_LFont_string_width(font, text + i + 1)) / 2.f;
-        }
-        else if (align & gl_LFont_TEXT_ALIGN_RIGHT)
-        {
-          target_x += area_size->w - gl_LFont_string_width(font, text + i + 1);
-        }
-      }
-      // translate modelview matrix
-      glm_translate(shared_font_shaderprogram->modelview_matrix, (vec3){target_x - render_x, font->newline, 0.f});
-      // issue update to gpu immediately
-      gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
-      render_y += font->newline;
-      render_x += target_x - render_x;
+  // compute all distance fields in parallel
+  krr_sdf_generate_many(jobs, job_count, spread, 0);
+
+  // each cell has spread pixels of padding on every side
+  const int cell_width = max_width + 2 * spread;
+  const int cell_height = max_bearing - min_hang + 2 * spread;
+  gl_LTexture_create_pixels8(font->spritesheet->ltexture, cell_width * 16, cell_height * 16);
+
+  glyph_blit_ blits[256];
+  for (int i=0; i<256; i++)
+  {
+    int b_x = cell_width * (i % 16);
+    int b_y = cell_height * (i / 16);
+
+    LRect clip = { b_x, b_y, glyphs[i].metrics.width / 64 + 2 * spread, cell_height };
+    vector_add(font->spritesheet->clips, &clip);
+
+    // distance field's first row is spread pixels above glyph's top, so it lands on cell's top padding
+    blits[i].src = fields[i];
+    blits[i].width = fields[i] != NULL ? glyphs[i].width + 2 * spread : 0;
+    blits[i].height = fields[i] != NULL ? glyphs[i].rows + 2 * spread : 0;
+    blits[i].dst_x = b_x;
+    blits[i].dst_y = b_y + max_bearing - glyphs[i].metrics.horiBearingY / 64;
+  }
+
+  assemble_atlas_(font->spritesheet->ltexture, blits, thread_count);
+
+  for (int i=0; i<256; i++)
+  {
+    free(fields[i]);
+  }
+  free_glyphs_(glyphs);
+
+  // make texture power of two
+  gl_LTexture_pad_pixels8(font->spritesheet->ltexture);
+
+  // set spacing variables, exclude padding
+  font->space = max_width / 2.0f;
+  font->line_height = cell_height - 2 * spread;
+  font->newline = max_bearing;
+  font->padding = spread;
+
+  return true;
+}
+
+bool upload_baked_(gl_LFont* font)
+{
+  // create texture
+  if (!gl_LTexture_load_texture_from_precreated_pixels8(font->spritesheet->ltexture))
+  {
+    SDL_Log("Unable to create texture from pre-created pixels8");
+    return false;
+  }
+
+  // build vertex buffer from sprite sheet data
+  if (!gl_LSpritesheet_generate_databuffer(font->spritesheet))
+  {
+    SDL_Log("Unable to geneate databuffer");
+    return false;
+  }
+
+  // set texture wrap
+  gl_LTexture_set_sampler(font->spritesheet->ltexture, gl_lsampler_cache_get(&gl_lsampler_desc_clamp_to_border));
+
+  return true;
+}
+
+bool gl_LFont_load_freetype(gl_LFont* font, const char* path, GLuint pixel_size)
+{
+  Uint64 start = SDL_GetPerformanceCounter();
+
+  // free previously loaded font
+  gl_LFont_free_font(font);
+
+  if (!acquire_freetype_())
+  {
+    return false;
+  }
+
+  font_source_ source = { path, NULL, 0 };
+  if (!bake_freetype_(font, &source, pixel_size, worker_thread_count_(256)) || !upload_baked_(font))
+  {
+    return false;
+  }
+
+  SDL_Log("Loaded font %s (%upx) in %.3f ms", path, pixel_size, (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency());
+  return true;
+}
+
+bool gl_LFont_load_freetype_sdf(gl_LFont* font, const char* path, GLuint pixel_size, GLuint spread)
+{
+  Uint64 start = SDL_GetPerformanceCounter();
+
+  // free previously loaded font
+  gl_LFont_free_font(font);
+
+  if (!acquire_freetype_())
+  {
+    return false;
+  }
+
+  font_source_ source = { path, NULL, 0 };
+  if (!bake_freetype_sdf_(font, &source, pixel_size, spread, worker_thread_count_(256)) || !upload_baked_(font))
+  {
+    return false;
+  }
+
+  SDL_Log("Loaded SDF font %s (%upx) in %.3f ms", path, pixel_size, (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency());
+  return true;
+}
+
+bool gl_LFont_load_freetype_from_memory(gl_LFont* font, const void* data, size_t size, GLuint pixel_size)
+{
+  // free previously loaded font
+  gl_LFont_free_font(font);
+
+  if (!acquire_freetype_())
+  {
+    return false;
+  }
+
+  font_source_ source = { NULL, data, size };
+  return bake_freetype_(font, &source, pixel_size, worker_thread_count_(256)) && upload_baked_(font);
+}
+
+bool gl_LFont_bake_freetype_from_memory(gl_LFont* font, const void* data, size_t size, GLuint pixel_size)
+{
+  // free previously loaded font
+  gl_LFont_free_font(font);
+
+  if (!acquire_freetype_())
+  {
+    return false;
+  }
+
+  font_source_ source = { NULL, data, size };
+  return bake_freetype_(font, &source, pixel_size, worker_thread_count_(256));
+}
+
+bool gl_LFont_upload_baked(gl_LFont* font)
+{
+  return upload_baked_(font);
+}
+
+int bake_font_worker_(void* data)
+{
+  font_bake_args_* args = data;
+  gl_LFont_load_request* request = args->request;
+
+  Uint64 start = SDL_GetPerformanceCounter();
+  font_source_ source = { request->path, NULL, 0 };
+  request->result = bake_freetype_(request->font, &source, request->pixel_size, args->thread_count);
+  request->load_ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+  return 0;
+}
+
+bool gl_LFont_load_freetype_many(gl_LFont_load_request* requests, int count)
+{
+  if (count <= 0)
+  {
+    return true;
+  }
+
+  // GL resources can only be freed on this thread
+  for (int i=0; i<count; i++)
+  {
+    gl_LFont_free_font(requests[i].font);
+    requests[i].result = false;
+    requests[i].load_ms = 0.0;
+  }
+
+  if (!acquire_freetype_())
+  {
+    return false;
+  }
+
+  // bake fonts concurrently, split threads among them
+  font_bake_args_* args = malloc(count * sizeof(font_bake_args_));
+  SDL_Thread** threads = malloc(count * sizeof(SDL_Thread*));
+  const int threads_per_font = krr_math_max(1, worker_thread_count_(256) / count);
+  for (int i=0; i<count; i++)
+  {
+    args[i].request = &requests[i];
+    args[i].thread_count = threads_per_font;
+
+    threads[i] = i == 0 ? NULL : SDL_CreateThread(bake_font_worker_, "gl_LFont_bake", &args[i]);
+    if (i > 0 && threads[i] == NULL)
+    {
+      bake_font_worker_(&args[i]);
+    }
+  }
+  bake_font_worker_(&args[0]);
+  for (int i=1; i<count; i++)
+  {
+    if (threads[i] != NULL)
+    {
+      SDL_WaitThread(threads[i], NULL);
+    }
+  }
+  free(threads);
+  free(args);
+
+  // upload on this thread as it owns OpenGL context
+  bool all_loaded = true;
+  for (int i=0; i<count; i++)
+  {
+    gl_LFont_load_request* request = &requests[i];
+    if (request->result)
+    {
+      Uint64 start = SDL_GetPerformanceCounter();
+      request->result = upload_baked_(request->font);
+      request->load_ms += (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    }
+
+    if (request->result)
+    {
+      SDL_Log("Loaded font %s (%upx) in %.3f ms", request->path, request->pixel_size, request->load_ms);
     }
     else
     {
-      // get ascii
-      GLuint ascii = (unsigned char)text[i];
+      SDL_Log("Unable to load font %s (%upx)", request->path, request->pixel_size);
+      all_loaded = false;
+    }
+  }
 
-      // draw quad using vertex data and index data
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ss->index_buffers[ascii]);
-      glDrawElements(GL_TRIANGLE_FAN, 4, GL_UNSIGNED_INT, NULL);
+  return all_loaded;
+}
+
+void font_cache_file_path_(char* out, size_t out_size, const char* cache_dir, const char* path, GLuint pixel_size)
+{
+  // font path and size are in the name, content hash is validated from header
+  snprintf(out, out_size, "%s/%016llx_%u.fontcache", cache_dir, (unsigned long long)krr_hash_string(path), pixel_size);
+}
 
-      // get clip
-      LRect* clip = (LRect*)vector_get(ss->clips, ascii);
-      // move over
-      glm_translate_x(shared_font_shaderprogram->modelview_matrix, clip->w + BETWEEN_CHAR_SPACING);
-      // issue update to gpu
-      gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
-      render_x += clip->w + BETWEEN_CHAR_SPACING;
+bool load_font_cache_(gl_LFont* font, const char* cache_file, uint64_t font_hash, GLuint pixel_size)
+{
+  krr_filemap map;
+  if (!krr_filemap_open(&map, cache_file))
+  {
+    // no cache yet
+    return false;
+  }
+
+  // validate header, any mismatch means stale cache which will be re-baked
+  const font_cache_header_* header = map.data;
+  if (map.size < sizeof(font_cache_header_) ||
+      strncmp(header->magic, FONT_CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != FONT_CACHE_VERSION ||
+      header->pixel_size != pixel_size ||
+      header->font_hash != font_hash ||
+      map.size < sizeof(font_cache_header_) + header->clip_count * sizeof(LRect) + header->kerning_count * sizeof(gl_LFont_kerning_pair) ||
+      map.size < header->pixels_offset + (uint64_t)header->physical_width * header->physical_height)
+  {
+    SDL_Log("Font cache %s is stale, re-bake", cache_file);
+    krr_filemap_close(&map);
+    return false;
+  }
+
+  // upload pixels straight from mapped file
+  const GLubyte* pixels = (const GLubyte*)map.data + header->pixels_offset;
+  gl_LTexture* texture = font->spritesheet->ltexture;
+  if (!gl_LTexture_load_texture_from_memory(texture, pixels, GL_RED, header->width, header->height, header->physical_width, header->physical_height, 1))
+  {
+    SDL_Log("Unable to create texture from font cache %s", cache_file);
+    krr_filemap_close(&map);
+    return false;
+  }
+
+  // clips follow header
+  const LRect* clips = (const LRect*)(header + 1);
+  for (uint32_t i=0; i<header->clip_count; i++)
+  {
+    LRect clip = clips[i];
+    vector_add(font->spritesheet->clips, &clip);
+  }
+
+  // kerning pairs follow clips, already sorted
+  const gl_LFont_kerning_pair* pairs = (const gl_LFont_kerning_pair*)(clips + header->clip_count);
+  for (uint32_t i=0; i<header->kerning_count; i++)
+  {
+    if (font->kerning_ == NULL)
+    {
+      font->kerning_ = vector_new(header->kerning_count, sizeof(gl_LFont_kerning_pair));
     }
+    gl_LFont_kerning_pair pair = pairs[i];
+    vector_add(font->kerning_, &pair);
+  }
+
+  font->space = header->space;
+  font->line_height = header->line_height;
+  font->newline = header->newline;
+
+  krr_filemap_close(&map);
+
+  // build vertex buffer from sprite sheet data
+  if (!gl_LSpritesheet_generate_databuffer(font->spritesheet))
+  {
+    SDL_Log("Unable to geneate databuffer");
+    return false;
+  }
+
+  // set texture wrap
+  gl_LTexture_set_sampler(texture, gl_lsampler_cache_get(&gl_lsampler_desc_clamp_to_border));
+
+  return true;
+}
+
+bool save_font_cache_(gl_LFont* font, const char* cache_file, uint64_t font_hash, GLuint pixel_size)
+{
+  const gl_LTexture* texture = font->spritesheet->ltexture;
+  const vector* clips = font->spritesheet->clips;
+
+  font_cache_header_ header;
+  memset(&header, 0, sizeof(header));
+  strncpy(header.magic, FONT_CACHE_MAGIC, sizeof(header.magic));
+  header.version = FONT_CACHE_VERSION;
+  header.pixel_size = pixel_size;
+  header.font_hash = font_hash;
+  header.width = texture->width;
+  header.height = texture->height;
+  header.physical_width = texture->physical_width_;
+  header.physical_height = texture->physical_height_;
+  header.clip_count = clips->len;
+  header.kerning_count = font->kerning_ != NULL ? font->kerning_->len : 0;
+  header.space = font->space;
+  header.line_height = font->line_height;
+  header.newline = font->newline;
+
+  size_t clips_end = sizeof(header) + clips->len * sizeof(LRect) + header.kerning_count * sizeof(gl_LFont_kerning_pair);
+  header.pixels_offset = (clips_end + FONT_CACHE_ALIGNMENT - 1) / FONT_CACHE_ALIGNMENT * FONT_CACHE_ALIGNMENT;
+
+  // write to temporary file then rename, so a crash never leaves half-written cache behind
+  char tmp_file[512];
+  snprintf(tmp_file, sizeof(tmp_file), "%s.tmp", cache_file);
+
+  FILE* file = fopen(tmp_file, "wb");
+  if (file == NULL)
+  {
+    SDL_Log("Unable to open font cache %s for write", tmp_file);
+    return false;
+  }
+
+  const GLubyte padding[FONT_CACHE_ALIGNMENT] = {0};
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+    (clips->len == 0 || fwrite(clips->buffer, sizeof(LRect), clips->len, file) == (size_t)clips->len) &&
+    (header.kerning_count == 0 || fwrite(font->kerning_->buffer, sizeof(gl_LFont_kerning_pair), header.kerning_count, file) == header.kerning_count) &&
+    (header.pixels_offset == clips_end || fwrite(padding, header.pixels_offset - clips_end, 1, file) == 1) &&
+    fwrite(texture->pixels8, (size_t)texture->physical_width_ * texture->physical_height_, 1, file) == 1;
+  ok = fclose(file) == 0 && ok;
+  file = NULL;
+
+  if (!ok)
+  {
+    SDL_Log("Unable to write font cache %s", tmp_file);
+    remove(tmp_file);
+    return false;
+  }
+
+  // rename doesn't replace existing file on every platform
+  remove(cache_file);
+  if (rename(tmp_file, cache_file) != 0)
+  {
+    SDL_Log("Unable to rename font cache %s to %s", tmp_file, cache_file);
+    remove(tmp_file);
+    return false;
+  }
+
+  return true;
+}
+
+bool gl_LFont_load_freetype_cached(gl_LFont* font, const char* path, GLuint pixel_size, const char* cache_dir)
+{
+  // free previously loaded font
+  gl_LFont_free_font(font);
+
+  // map font file once, its content is both hashed, and fed to FreeType if needed
+  krr_filemap font_map;
+  if (!krr_filemap_open(&font_map, path))
+  {
+    return false;
+  }
+  uint64_t font_hash = krr_hash_bytes(font_map.data, font_map.size, 0);
+
+  char cache_file[512];
+  font_cache_file_path_(cache_file, sizeof(cache_file), cache_dir, path, pixel_size);
+
+  // cached load
+  if (load_font_cache_(font, cache_file, font_hash, pixel_size))
+  {
+    krr_filemap_close(&font_map);
+    return true;
+  }
+
+  // cold load, bake with FreeType then save before upload
+  gl_LFont_free_font(font);
+  font_source_ source = { NULL, font_map.data, font_map.size };
+  if (!acquire_freetype_() || !bake_freetype_(font, &source, pixel_size, worker_thread_count_(256)))
+  {
+    krr_filemap_close(&font_map);
+    return false;
+  }
+  krr_filemap_close(&font_map);
+
+  // failing to save cache is not fatal, next load will just bake again
+  save_font_cache_(font, cache_file, font_hash, pixel_size);
+
+  return upload_baked_(font);
+}
+
+void gl_LFont_free_font(gl_LFont* font)
+{
+  // layouts depend on glyphs of this font
+  gl_ltext_layout_invalidate_font(font);
+
+  if (font->kerning_ != NULL)
+  {
+    vector_free(font->kerning_);
+    font->kerning_ = NULL;
+  }
+  free(font->advances_);
+  font->advances_ = NULL;
+
+  // clear the sheet
+  gl_LSpritesheet_free_sheet(font->spritesheet);
+  // clear the underlying 
+  gl_LTexture_free_internal_texture(font->spritesheet->ltexture);
+
+  // reinitialize spacing constants
+  font->space = 0.f;
+  font->line_height = 0.f;
+  font->newline = 0.f;
+  font->padding = 0.f;
+}
+
+void render_layout_(gl_LFont* font, const gl_ltext_layout* layout, GLfloat x, GLfloat y)
+{
+  // if there is texture to render from
+  if (font->spritesheet->ltexture->texture_id == 0)
+  {
+    return;
+  }
+
+  // get spritesheet
+  gl_LSpritesheet* ss = font->spritesheet;
+  // mark as used for texture manager
+  gl_ltexture_manager_touch(ss->ltexture);
+
+  // save current state of modelview matrix
+  // from this frame, we will operate on top of current modelview matrix then when done
+  // we will set back original modelview matrix back (pretty much similar to fixed-function pipeline)
+  mat4 original_modelview_matrix;
+  glm_mat4_copy(shared_font_shaderprogram->modelview_matrix, original_modelview_matrix);
+
+  // set texture
+  glBindTexture(GL_TEXTURE_2D, ss->ltexture->texture_id);
+  gl_lsampler_cache_bind(0, ss->ltexture->sampler);
+
+  // enable all attribute pointers
+  gl_lfont_polygon_program2d_enable_attrib_pointers(shared_font_shaderprogram);
+
+  // bind vertex data
+  glBindBuffer(GL_ARRAY_BUFFER, ss->vertex_data_buffer);
+
+  // set texcoord, and vertex pointer for sheet's layout
+  gl_lfont_polygon_program2d_set_attrib_pointers(shared_font_shaderprogram, ss->vertex_format, NULL);
+
+  // glyphs are already positioned, place each one relative to original modelview matrix
+  for (int i=0; i<layout->glyph_count; i++)
+  {
+    const gl_ltext_layout_glyph* glyph = &layout->glyphs[i];
+
+    // glyph's padding (if any) lies before its visible content
+    glm_mat4_copy(original_modelview_matrix, shared_font_shaderprogram->modelview_matrix);
+    glm_translate(shared_font_shaderprogram->modelview_matrix, (vec3){x + glyph->x - font->padding, y + glyph->y - font->padding, 0.f});
+    // issue update to gpu
+    gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
+
+    // draw glyph's quad using vertex data and shared index data
+    gl_lvertex_format_draw_quads(glyph->glyph, 1);
   }
 
   // unbind buffers
@@ -679,92 +1176,479 @@ void gl_LFont_render_textex(gl_LFont* font, const char* text, GLfloat x, GLfloat
 
   // disable all attribute pointers
   gl_lfont_polygon_program2d_disable_attrib_pointers(shared_font_shaderprogram);
+
+  // set modelview matrix back to original one
+  glm_mat4_copy(original_modelview_matrix, shared_font_shaderprogram->modelview_matrix);
+}
+
+void gl_LFont_render_text(gl_LFont* font, const char* text, GLfloat x, GLfloat y)
+{
+  render_layout_(font, gl_ltext_layout_get(font, text, NULL, 0), x, y);
+}
+
+void gl_LFont_render_textex(gl_LFont* font, const char* text, GLfloat x, GLfloat y, const LSize* area_size, int align)
+{
+  // layout is cached, so measuring then rendering the same text lays it out only once
+  render_layout_(font, gl_ltext_layout_get(font, text, area_size, align), x, y);
+}
+
+LSize gl_LFont_get_string_area_size(gl_LFont* font, const char* text)
+{
+  return gl_ltext_layout_get(font, text, NULL, 0)->size;
+}
+
+void build_advances_(gl_LFont* font)
+{
+  font->advances_ = malloc(256 * sizeof(GLfloat));
+  for (int i=0; i<256; i++)
+  {
+    const LRect* clip = vector_get(font->spritesheet->clips, i);
+    font->advances_[i] = clip->w - 2.f * font->padding + BETWEEN_CHAR_SPACING;
+  }
+  // space doesn't render, it just moves pen
+  font->advances_[' '] = font->space;
 }
 
-GLfloat gl_LFont_string_width(gl_LFont* font, const char* string)
+GLfloat measure_ascii_run_(const GLfloat* advances, const char** str)
 {
-  GLfloat width = 0.f;
+  const unsigned char* p = (const unsigned char*)*str;
+
+  // independent sums to not wait on a single chain of additions
+  GLfloat w0 = 0.f, w1 = 0.f, w2 = 0.f, w3 = 0.f;
 
-  // go through string
-  for (int i=0; string[i] != '\0' && string[i] != '\n'; i++)
+#if defined(__SSE2__)
+  // scalar until 16-byte aligned, aligned loads never cross page boundary so it's safe to read past the end of string
+  while (((uintptr_t)p & 15) != 0)
   {
-    // space
-    if (string[i] == ' ')
+    if (*p == '\0' || *p == '\n' || *p >= 0x80)
     {
-      width += font->space + BETWEEN_CHAR_SPACING;
+      *str = (const char*)p;
+      return w0;
     }
-    // character
-    else
+    w0 += advances[*p++];
+  }
+
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i newline = _mm_set1_epi8('\n');
+  for (;;)
+  {
+    // find the first byte that stops the run: end of string, newline, or non-ASCII (high bit set)
+    __m128i chunk = _mm_load_si128((const __m128i*)p);
+    int stops = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, zero), _mm_cmpeq_epi8(chunk, newline))) | _mm_movemask_epi8(chunk);
+    int n = stops != 0 ? __builtin_ctz(stops) : 16;
+
+    int i = 0;
+    for (; i+4<=n; i+=4)
+    {
+      w0 += advances[p[i]];
+      w1 += advances[p[i+1]];
+      w2 += advances[p[i+2]];
+      w3 += advances[p[i+3]];
+    }
+    for (; i<n; i++)
     {
-      // get ASCII
-      GLuint ascii = (unsigned char)string[i];
-      // note: will possibly be bottleneck later as it needs to convert data type here
-      // consider has a specific type of vector here later?
-      width += (*(LRect*)vector_get(font->spritesheet->clips, ascii)).w + BETWEEN_CHAR_SPACING;
+      w0 += advances[p[i]];
     }
-  } 
+    p += n;
 
-  return width;
+    if (stops != 0)
+    {
+      break;
+    }
+  }
+#else
+  while (*p != '\0' && *p != '\n' && *p < 0x80)
+  {
+    w0 += advances[*p++];
+  }
+#endif
+
+  *str = (const char*)p;
+  return (w0 + w1) + (w2 + w3);
 }
 
-GLfloat gl_LFont_string_height(gl_LFont* font, const char* string)
+LSize measure_string_(gl_LFont* font, const char* text)
 {
-  GLfloat height = font->line_height;
+  LSize size = { 0.f, font->line_height };
+  GLfloat line_width = 0.f;
+  const bool kerned = font->kerning_ != NULL;
+  // previous glyph for kerning, -1 at line start
+  int prev_glyph = -1;
+
+  const char* p = text;
+  for (;;)
+  {
+    // fast path, kerning needs pair of glyphs so it can't be summed independently
+    if (!kerned)
+    {
+      line_width += measure_ascii_run_(font->advances_, &p);
+    }
 
-  // go through string
-  for (int i=0; string[i] != '\0'; i++)
+    uint32_t codepoint = krr_utf8_next(&p);
+    if (codepoint == 0)
+    {
+      break;
+    }
+    else if (codepoint == '\n')
+    {
+      if (line_width > size.w)
+      {
+        size.w = line_width;
+      }
+      line_width = 0.f;
+      size.h += font->line_height;
+      prev_glyph = -1;
+    }
+    else
+    {
+      // same as text layout, code points beyond the font's glyphs are '?'
+      GLuint glyph = codepoint < 256 ? codepoint : '?';
+      // pen just moves over space, there's no kerning before it
+      if (prev_glyph >= 0 && glyph != ' ')
+      {
+        line_width += gl_LFont_get_kerning(font, prev_glyph, glyph);
+      }
+      line_width += font->advances_[glyph];
+      prev_glyph = glyph;
+    }
+  }
+
+  if (line_width > size.w)
+  {
+    size.w = line_width;
+  }
+  return size;
+}
+
+void gl_LFont_measure_strings(gl_LFont* font, const char* const* texts, int count, LSize* out_sizes)
+{
+  if (font->spritesheet->clips->len < 256)
   {
-    // more space accumulated
-    if (string[i] == '\n')
+    // no font is loaded
+    for (int i=0; i<count; i++)
     {
-      height += font->line_height;
+      out_sizes[i] = (LSize){ 0.f, 0.f };
     }
+    return;
+  }
+
+  if (font->advances_ == NULL)
+  {
+    build_advances_(font);
   }
 
-  return height;
+  for (int i=0; i<count; i++)
+  {
+    out_sizes[i] = measure_string_(font, texts[i]);
+  }
 }
 
-LSize gl_LFont_get_string_area_size(gl_LFont* font, const char* text)
+bool gl_LFont_load_bitmap(gl_LFont* font, const char* path)
 {
-  // initialize area
-  GLfloat sub_width = 0.f;
-  LSize area = {sub_width, font->line_height};
+  // get rid of the font if it exists
+  gl_LFont_free_font(font);
 
-  // go through string
-  for (int i=0; i<strlen(text); i++)
+  // load from grayscale 8-bit image
+  if (!gl_LTexture_load_pixels_from_file8(font->spritesheet->ltexture, path))
   {
-    // space
-    if (text[i] == ' ')
+    SDL_Log("Unable to load pixels from file");
+    return false;
+  }
+
+  gl_LFont_parse_bitmap(font);
+  return upload_baked_(font);
+}
+
+bool gl_LFont_load_bitmap_cached(gl_LFont* font, const char* path, const char* cache_dir)
+{
+  // get rid of the font if it exists
+  gl_LFont_free_font(font);
+
+  gl_LTexture* texture = font->spritesheet->ltexture;
+  if (!gl_LTexture_load_pixels_from_file8(texture, path))
+  {
+    SDL_Log("Unable to load pixels from file");
+    return false;
+  }
+
+  // metrics are only valid for the exact same pixels
+  uint64_t pixels_hash = krr_hash_bytes(texture->pixels8, (size_t)texture->physical_width_ * texture->physical_height_, 0);
+
+  char cache_file[512];
+  snprintf(cache_file, sizeof(cache_file), "%s/%016llx.bitmapfont", cache_dir, (unsigned long long)krr_hash_string(path));
+
+  if (!load_bitmap_metrics_(font, cache_file, pixels_hash))
+  {
+    gl_LFont_parse_bitmap(font);
+    // failing to save cache is not fatal, next load will just parse again
+    save_bitmap_metrics_(font, cache_file, pixels_hash);
+  }
+
+  return upload_baked_(font);
+}
+
+int find_first_nonzero_(const GLubyte* pixels, int count)
+{
+  int i = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i+16<=count; i+=16)
+  {
+    int nonzero = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(pixels + i)), zero)) & 0xFFFF;
+    if (nonzero != 0)
     {
-      sub_width += font->space + BETWEEN_CHAR_SPACING;
+      return i + __builtin_ctz(nonzero);
     }
-    // newline
-    else if (text[i] == '\n')
+  }
+#endif
+  for (; i<count; i++)
+  {
+    if (pixels[i] != 0)
     {
-      // add another line
-      area.h += font->line_height;
+      return i;
+    }
+  }
+  return -1;
+}
 
-      // check for max width to update max width
-      if (sub_width > area.w)
+int find_last_nonzero_(const GLubyte* pixels, int count)
+{
+  int i = count;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i-16>=0; i-=16)
+  {
+    int nonzero = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(pixels + i - 16)), zero)) & 0xFFFF;
+    if (nonzero != 0)
+    {
+      return i - 16 + (31 - __builtin_clz(nonzero));
+    }
+  }
+#endif
+  for (; i>0; i--)
+  {
+    if (pixels[i-1] != 0)
+    {
+      return i - 1;
+    }
+  }
+  return -1;
+}
+
+int parse_cells_worker_(void* data)
+{
+  const parse_cells_args_* args = data;
+  const gl_LTexture* texture = args->texture;
+  const int stride = texture->physical_width_;
+  // number of pixel rows, and columns to scan in a cell
+  const int cell_cols = (int)ceilf(args->cell_width);
+  const int cell_rows = (int)ceilf(args->cell_height);
+
+  for (int i=args->first; i<args->last; i++)
+  {
+    bitmap_cell_* cell = &args->cells[i];
+
+    // set base offsets
+    int b_x = args->cell_width * (i % 16);
+    int b_y = args->cell_height * (i / 16);
+
+    // empty cell covers the whole cell
+    cell->clip = (LRect){ b_x, b_y, args->cell_width, args->cell_height };
+    cell->top = -1;
+    cell->bottom = -1;
+
+    // a single pass over rows of cell, each row's pixels are contiguous in memory
+    int left = cell_cols;
+    int right = -1;
+    for (int row=0; row<cell_rows; row++)
+    {
+      const GLubyte* pixels = texture->pixels8 + (b_y + row) * stride + b_x;
+      int first = find_first_nonzero_(pixels, cell_cols);
+      if (first == -1)
+      {
+        continue;
+      }
+
+      if (cell->top == -1)
+      {
+        cell->top = row;
+      }
+      cell->bottom = row;
+
+      if (first < left)
       {
-        area.w = sub_width;
-        sub_width = 0.f;
+        left = first;
+      }
+      // only pixels right of current right side can extend it
+      if (right < cell_cols - 1)
+      {
+        int last = find_last_nonzero_(pixels + right + 1, cell_cols - right - 1);
+        if (last != -1)
+        {
+          right = right + 1 + last;
+        }
       }
     }
-    // Character
-    else
+
+    if (right != -1)
     {
-      // get ascii
-      GLuint ascii = (unsigned char)text[i];
-      sub_width += (*(LRect*)vector_get(font->spritesheet->clips, ascii)).w + BETWEEN_CHAR_SPACING;
+      cell->clip.x = b_x + left;
+      cell->clip.w = right - left + 1;
     }
   }
 
-  // check for max width
-  if (sub_width > area.w)
+  return 0;
+}
+
+void gl_LFont_parse_bitmap(gl_LFont* font)
+{
+  // expect image that is grayscale, in 16x16 ASCII order with black (0x0) background
+  gl_LTexture* texture = font->spritesheet->ltexture;
+
+  // get cell dimensions
+  // image has 16x16 cells
+  GLfloat cell_width = texture->width / 16.f;
+  GLfloat cell_height = texture->height / 16.f;
+
+  // parse cells in parallel, each thread writes to its own range of cells
+  bitmap_cell_ cells[256];
+  parse_cells_args_ args[MAX_BAKE_THREADS];
+  const int thread_count = worker_thread_count_(256);
+  for (int t=0; t<thread_count; t++)
+  {
+    args[t].texture = texture;
+    args[t].cell_width = cell_width;
+    args[t].cell_height = cell_height;
+    args[t].cells = cells;
+    args[t].first = 256 * t / thread_count;
+    args[t].last = 256 * (t + 1) / thread_count;
+  }
+  run_parallel_(parse_cells_worker_, args, sizeof(parse_cells_args_), thread_count);
+
+  // get letter top and bottom across all cells
+  GLuint top = cell_height;
+  GLuint bottom = 0;
+  GLuint a_bottom = 0;
+  for (int i=0; i<256; i++)
+  {
+    if (cells[i].top != -1 && cells[i].top < top)
+    {
+      top = cells[i].top;
+    }
+    if (cells[i].bottom != -1 && cells[i].bottom > bottom)
+    {
+      bottom = cells[i].bottom;
+    }
+  }
+  // baseline
+  if (cells['A'].bottom != -1)
+  {
+    a_bottom = cells['A'].bottom;
+  }
+
+  // set top
+  // by lopping off extra height from all the character sprites
+  for (int i=0; i<256; i++)
+  {
+    LRect clip = cells[i].clip;
+    clip.y += top;
+    clip.h -= top;
+    vector_add(font->spritesheet->clips, &clip);
+  }
+
+  // set spacing variables
+  font->space = cell_width / 2.f;
+  font->newline = a_bottom - top;
+  font->line_height = bottom - top;
+}
+
+bool load_bitmap_metrics_(gl_LFont* font, const char* cache_file, uint64_t pixels_hash)
+{
+  krr_filemap map;
+  if (!krr_filemap_open(&map, cache_file))
+  {
+    // no cache yet
+    return false;
+  }
+
+  // validate header, any mismatch means stale cache which will be parsed again
+  const bitmap_metrics_header_* header = map.data;
+  if (map.size < sizeof(bitmap_metrics_header_) ||
+      strncmp(header->magic, BITMAP_METRICS_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != BITMAP_METRICS_VERSION ||
+      header->pixels_hash != pixels_hash ||
+      header->width != (uint32_t)font->spritesheet->ltexture->width ||
+      header->height != (uint32_t)font->spritesheet->ltexture->height ||
+      map.size < sizeof(bitmap_metrics_header_) + header->clip_count * sizeof(LRect))
+  {
+    SDL_Log("Bitmap font cache %s is stale, parse again", cache_file);
+    krr_filemap_close(&map);
+    return false;
+  }
+
+  // clips follow header
+  const LRect* clips = (const LRect*)(header + 1);
+  for (uint32_t i=0; i<header->clip_count; i++)
+  {
+    LRect clip = clips[i];
+    vector_add(font->spritesheet->clips, &clip);
+  }
+
+  font->space = header->space;
+  font->line_height = header->line_height;
+  font->newline = header->newline;
+
+  krr_filemap_close(&map);
+  return true;
+}
+
+bool save_bitmap_metrics_(gl_LFont* font, const char* cache_file, uint64_t pixels_hash)
+{
+  const vector* clips = font->spritesheet->clips;
+
+  bitmap_metrics_header_ header;
+  memset(&header, 0, sizeof(header));
+  strncpy(header.magic, BITMAP_METRICS_MAGIC, sizeof(header.magic));
+  header.version = BITMAP_METRICS_VERSION;
+  header.clip_count = clips->len;
+  header.pixels_hash = pixels_hash;
+  header.width = font->spritesheet->ltexture->width;
+  header.height = font->spritesheet->ltexture->height;
+  header.space = font->space;
+  header.line_height = font->line_height;
+  header.newline = font->newline;
+
+  // write to temporary file then rename, so a crash never leaves half-written cache behind
+  char tmp_file[512];
+  snprintf(tmp_file, sizeof(tmp_file), "%s.tmp", cache_file);
+
+  FILE* file = fopen(tmp_file, "wb");
+  if (file == NULL)
   {
-    area.w = sub_width;
+    SDL_Log("Unable to open bitmap font cache %s for write", tmp_file);
+    return false;
   }
 
-  return area;
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+    (clips->len == 0 || fwrite(clips->buffer, sizeof(LRect), clips->len, file) == (size_t)clips->len);
+  ok = fclose(file) == 0 && ok;
+  file = NULL;
+
+  if (!ok)
+  {
+    SDL_Log("Unable to write bitmap font cache %s", tmp_file);
+    remove(tmp_file);
+    return false;
+  }
+
+  // rename doesn't replace existing file on every platform
+  remove(cache_file);
+  if (rename(tmp_file, cache_file) != 0)
+  {
+    SDL_Log("Unable to rename bitmap font cache %s to %s", tmp_file, cache_file);
+    remove(tmp_file);
+    return false;
+  }
+
+  return true;
 }
@@ -37,8 +37,32 @@ typedef struct
   GLfloat line_height;
   // how much spacing when found '\n' (newline)
   GLfloat newline;
+
+  /// (read-only) empty space around each glyph in its clip, non-zero for signed distance field font
+  GLfloat padding;
+
+  /// (internal use) kerning pairs sorted by key, NULL if font has no kerning
+  vector* kerning_;
+  /// (internal use) advance of each glyph in pixels for measuring text, built on first use
+  GLfloat* advances_;
 } gl_LFont;
 
+/// font to load with gl_LFont_load_freetype_many()
+typedef struct
+{
+  /// font to load into
+  gl_LFont* font;
+  /// path to TTF file
+  const char* path;
+  /// pixel size of font
+  GLuint pixel_size;
+
+  /// (output) true if successfully loaded
+  bool result;
+  /// (output) time took to load this font in milliseconds
+  double load_ms;
+} gl_LFont_load_request;
+
 ///
 /// Create a new bitmap font.
 /// gl_LSpritesheet will be managed and automatically freed memory when done.
@@ -67,8 +91,22 @@ extern void gl_LFont_free(gl_LFont* font);
 ///
 extern bool gl_LFont_load_bitmap(gl_LFont* font, const char* path);
 
+///
+/// Load bitmap through parsed metrics cache on disk.
+/// On the first load, glyph clips, and spacing variables are parsed from bitmap as usual then saved into a cache file
+/// inside cache_dir. Later loads read them from such file instead of parsing bitmap again.
+/// Cache is re-parsed whenever bitmap's pixels changed.
+///
+/// \param font Pointer to gl_LFont
+/// \param path Path to bitmap file to load
+/// \param cache_dir Existing directory to keep cache files in
+/// \return True if successfully load, otherwise return false
+///
+extern bool gl_LFont_load_bitmap_cached(gl_LFont* font, const char* path, const char* cache_dir);
+
 ///
 /// Load FreeType font
+/// Glyphs are rasterized in parallel on worker threads.
 ///
 /// \param font Pointer to gl_LFont
 /// \param path Path to load TTF file
@@ -77,6 +115,64 @@ extern bool gl_LFont_load_bitmap(gl_LFont* font, const char* path);
 ///
 extern bool gl_LFont_load_freetype(gl_LFont* font, const char* path, GLuint pixel_size);
 
+///
+/// Load multiple FreeType fonts at once.
+/// Fonts are baked concurrently on worker threads, then uploaded on calling thread.
+/// Load time of each font is reported via SDL_Log, and in its request.
+///
+/// \param requests Array of fonts to load
+/// \param count Number of requests
+/// \return True if all fonts are loaded successfully, otherwise return false. Check each request's result for detail.
+///
+extern bool gl_LFont_load_freetype_many(gl_LFont_load_request* requests, int count);
+
+///
+/// Free FreeType library shared by all gl_LFont.
+/// Call it when no more font will be loaded i.e. when application closes.
+///
+extern void gl_LFont_free_shared_freetype();
+
+///
+/// Load FreeType font as signed distance field (SDF).
+/// Each glyph's distance field is computed from its FreeType bitmap in parallel, then packed into a single atlas.
+/// Render it with program loaded by gl_lfont_polygon_program2d_load_sdf_program() set to shared_font_shaderprogram,
+/// then it stays crisp at any scale, or rotation applied to modelview matrix. So a single font can serve
+/// multiple text sizes.
+///
+/// \param font Pointer to gl_LFont
+/// \param path Path to load TTF file
+/// \param pixel_size Base pixel size to rasterize glyphs at. 32 - 64 is good enough for most uses.
+/// \param spread Maximum distance in pixels encoded around glyph's edge, it's also glyph's padding. 4 - 8 is typical.
+/// \return True if load successfully, otherwise return false.
+///
+extern bool gl_LFont_load_freetype_sdf(gl_LFont* font, const char* path, GLuint pixel_size, GLuint spread);
+
+///
+/// Load FreeType font from TTF file's content in memory i.e. memory-mapped asset pack.
+///
+/// \param font Pointer to gl_LFont
+/// \param data Pointer to TTF file's content
+/// \param size Size of data in bytes
+/// \param pixel_size Pixel size of font to generate bitmap font from TTF data
+/// \return True if load successfully, otherwise return false.
+///
+extern bool gl_LFont_load_freetype_from_memory(gl_LFont* font, const void* data, size_t size, GLuint pixel_size);
+
+///
+/// Load FreeType font through baked font cache on disk.
+/// On the first load, font is baked with FreeType as usual then its atlas pixels, clips, and spacing variables
+/// are saved into a cache file inside cache_dir. Later loads memory-map such file then upload it directly
+/// without touching FreeType at all.
+/// Cache file is named after font's path and pixel size, and it's re-baked whenever font file's content changed.
+///
+/// \param font Pointer to gl_LFont
+/// \param path Path to load TTF file
+/// \param pixel_size Pixel size of font to generate bitmap font from TTF file
+/// \param cache_dir Existing directory to keep cache files in
+/// \return True if load successfully, otherwise return false.
+///
+extern bool gl_LFont_load_freetype_cached(gl_LFont* font, const char* path, GLuint pixel_size, const char* cache_dir);
+
 ///
 /// Free gl_LFont's font.
 /// This doesn't free or destroy gl_LFont itself.
@@ -116,4 +212,16 @@ extern void gl_LFont_render_textex(gl_LFont* font, const char* text, GLfloat x,
 ///
 extern LSize gl_LFont_get_string_area_size(gl_LFont* font, const char* text);
 
+///
+/// Get rendering area size for multiple texts at once i.e. labels during UI layout pass.
+/// Result is the same as of gl_LFont_get_string_area_size() for each text, but texts are measured directly
+/// without going through layout cache, and runs of ASCII characters are scanned 16 bytes at a time.
+///
+/// \param font Pointer to font
+/// \param texts Array of null-terminated UTF-8 texts
+/// \param count Number of texts
+/// \param out_sizes Array of at least count LSize to receive rendering area size of each text
+///
+extern void gl_LFont_measure_strings(gl_LFont* font, const char* const* texts, int count, LSize* out_sizes);
+
 #endif
@@ -3,27 +3,62 @@
 
 #include "gl/glLOpenGL.h"
 #include "gl/gl_LFont.h"
+#include <stddef.h>
+#include <stdint.h>
 
 /// This header is meant to be used internally by library itself.
 /// If you include this, you should know what you're doing.
 
+// spacing when render between character in pixel
+#define BETWEEN_CHAR_SPACING 4
+
+/// kerning adjustment between pair of glyphs
+typedef struct
+{
+  /// left glyph index in high 8 bits, right glyph index in low 8 bits
+  uint16_t key;
+  /// horizontal adjustment in pixels
+  int16_t amount;
+} gl_LFont_kerning_pair;
+
+///
+/// Get kerning adjustment between pair of glyphs.
+///
+/// \param font Pointer to gl_LFont
+/// \param left Left glyph index
+/// \param right Right glyph index
+/// \return Horizontal adjustment in pixels to apply before rendering right glyph, usually negative. 0 if there's none.
+///
+extern GLfloat gl_LFont_get_kerning(gl_LFont* font, GLuint left, GLuint right);
+
+///
+/// Parse glyph clips, and spacing variables of bitmap font from its spritesheet texture's 8-bit pixels.
+/// Pixels are expected to be 16x16 cells in ASCII order with black background.
+/// Cells are parsed in parallel on worker threads.
+///
+/// \param font Pointer to gl_LFont with pixels loaded, and no clips yet
+///
+extern void gl_LFont_parse_bitmap(gl_LFont* font);
+
 ///
-/// Return the width of input string according to the current loaded font.
-/// It will return the width until it reaches '\n' or '\0'.
+/// Bake FreeType font from TTF file's content in memory into spritesheet's 8-bit pixels, and clips without uploading.
+/// Font is ready to render after gl_LFont_upload_baked(), or after its pixels are placed into another texture
+/// then spritesheet's data buffer is generated.
 ///
 /// \param font Pointer to gl_LFont
-/// \param string Input string
-/// \return String width
+/// \param data Pointer to TTF file's content
+/// \param size Size of data in bytes
+/// \param pixel_size Pixel size of font
+/// \return True if successfully baked, otherwise return false.
 ///
-extern GLfloat gl_LFont_string_width(gl_LFont* font, const char* string);
+extern bool gl_LFont_bake_freetype_from_memory(gl_LFont* font, const void* data, size_t size, GLuint pixel_size);
 
 ///
-/// Return string's height required to render it according to current loaded font.
+/// Upload font baked by gl_LFont_bake_freetype_from_memory() into its own texture.
 ///
 /// \param font Pointer to gl_LFont
-/// \param string Input string
-/// \return String's height
+/// \return True if successfully uploaded, otherwise return false.
 ///
-extern GLfloat gl_LFont_string_height(gl_LFont* font, const char* string);
+extern bool gl_LFont_upload_baked(gl_LFont* font);
 
 #endif
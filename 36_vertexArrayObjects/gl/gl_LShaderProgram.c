@@ -1,15 +1,88 @@
 #include "gl_LShaderProgram.h"
 #include "gl_LShaderProgram_internals.h"
 #include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "gl/gl_lframe_constants.h"
+#include "gl/gl_lshader_source.h"
 #include "foundation/krr_util.h"
+#include "foundation/krr_hash.h"
+#include "foundation/krr_filemap.h"
+#include "foundation/vector.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include "SDL_log.h"
+#include "SDL_timer.h"
+
+// program binary cache file, see gl_LShaderProgram_set_binary_cache_dir()
+#define PROGRAM_BINARY_MAGIC "KRRPBIN"
+#define PROGRAM_BINARY_VERSION 1
+
+// layout: [header][program binary x binary_size]
+typedef struct
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t binary_format;
+  // hash of sources, attribute locations, and GL vendor, renderer, and version
+  // binary is only valid for the exact same driver
+  uint64_t key;
+  uint64_t binary_size;
+} program_binary_header_;
+
+// directory to keep program binaries in, NULL if binary cache is disabled
+static char* binary_cache_dir_ = NULL;
+// whether driver can save, and restore program binary. -1 if not checked yet
+static int binary_supported_ = -1;
+static gl_LShaderProgram_cache_stats cache_stats_ = { 0, 0, 0, 0.0 };
+
+// program submitted but its link status isn't checked yet
+typedef struct
+{
+  gl_LShaderProgram* shader_program;
+  // program being linked, or restored from binary
+  GLuint program_id;
+  // attached shaders kept for compile log until checked, 0 if restored from binary
+  GLuint vertex_shader_id;
+  GLuint fragment_shader_id;
+  // kept to compile again in case driver rejects binary
+  char* vertex_source;
+  char* fragment_source;
+  gl_LShaderProgram_attrib_location* attrib_locations;
+  int attrib_location_count;
+  // for timing report
+  char* name;
+  // binary cache key, and file. empty cache file if binary cache isn't used
+  uint64_t key;
+  char cache_file[512];
+  gl_LShaderProgram_on_linked on_linked;
+  void* user_data;
+  // performance counter at submission
+  Uint64 submit_counter;
+} pending_build_;
+
+// programs submitted, and not checked yet
+static vector* pending_builds_ = NULL;
+// whether build is deferred until gl_LShaderProgram_wait_all()
+static bool batching_ = false;
+
+static bool is_binary_supported_();
+static uint64_t program_key_(const char* vertex_source, const char* fragment_source, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count);
+static GLuint compile_shader_(const char* source, GLenum shader_type);
+static void submit_link_(pending_build_* build, bool retrievable);
+static GLuint restore_program_binary_(const char* cache_file, uint64_t key);
+static bool finish_build_(int index, double* out_ms);
+static bool is_complete_(const pending_build_* build);
+static int find_pending_(gl_LShaderProgram* shader_program);
+static void free_pending_(pending_build_* build);
+static bool save_program_binary_(GLuint program_id, const char* cache_file, uint64_t key);
+static bool submit_build_(gl_LShaderProgram* shader_program, char* name, char* vertex_source, char* fragment_source, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count, gl_LShaderProgram_on_linked on_linked, void* user_data);
 
 void gl_LShaderProgram_init_defaults(gl_LShaderProgram* shader_program)
 {
   shader_program->program_id = 0;
+  shader_program->pending_ = false;
 }
 
 gl_LShaderProgram* gl_LShaderProgram_new()
@@ -32,74 +105,27 @@ void gl_LShaderProgram_free(gl_LShaderProgram* shader_program)
 
 GLuint gl_LShaderProgram_load_shader_from_file(const char* path, GLenum shader_type)
 {
-  // open file for read
-  FILE* file = fopen(path, "r");
-  if (file == NULL)
+  char* shader_source = gl_lshader_source_load(path, NULL, 0);
+  if (shader_source == NULL)
   {
-    SDL_Log("Unable to open file for read %s", path);
     // return 0 for failed case
     return 0;
   }
 
-  // find the total byte size of file
-  fseek(file, 0, SEEK_END);
-  const long file_size = ftell(file);
-  fseek(file, 0, SEEK_SET);
-
-  // check if file size is zero
-  if (file_size <= 0)
-  {
-    SDL_Log("Shader file has zero bytes");
-
-    // close the file
-    fclose(file);
-    file = NULL;
-
-    return 0;
-  }
-
-  // have enough space to hold file's content
-  char shader_source[file_size+1];
-  memset(shader_source, 0, file_size+1);
+  GLuint shader_id = gl_LShaderProgram_load_shader_from_source(shader_source, shader_type);
+  free(shader_source);
 
-  // FIXME: should we fix this to read line-by-line or chunk by chunk in case the limitation of RAM?
-  // read the whole file as once
-  if (fread(shader_source, file_size, 1, file) != 1)
-  {
-    // something wrong happen
-    // check if it's end-of-file error
-    if (feof(file))
-    {
-      SDL_Log("Read error, end-of-file detected");
-      // close the file
-      fclose(file);
-      file = NULL;
-
-      return 0;
-    }
-
-    // there's something else
-    if (ferror(file))
-    {
-      SDL_Log("Read error");
-      // close the file
-      fclose(file);
-      file = NULL;
-
-      return 0;
-    }
-  }
-
-  // close the file
-  fclose(file);
-  file = NULL;
+  return shader_id;
+}
 
+GLuint gl_LShaderProgram_load_shader_from_source(const char* shader_source, GLenum shader_type)
+{
   // create shader id
   GLuint shader_id = glCreateShader(shader_type);
 
   // satisfy parameter type
   // glShaderSource needs 3rd parameter of const GLchar**
-  const char* str_ptr = (const char*)shader_source;
+  const char* str_ptr = shader_source;
 
   // set shader source
   glShaderSource(shader_id, 1, &str_ptr, NULL);
@@ -123,8 +149,519 @@ GLuint gl_LShaderProgram_load_shader_from_file(const char* path, GLenum shader_t
   return shader_id;
 }
 
+bool is_binary_supported_()
+{
+  if (binary_supported_ == -1)
+  {
+    // some drivers expose the extension but no binary format at all
+    GLint num_formats = 0;
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+    {
+      glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+    }
+    binary_supported_ = num_formats > 0 ? 1 : 0;
+
+    if (!binary_supported_)
+    {
+      SDL_Log("Program binary is not supported, programs will always be compiled");
+    }
+  }
+  return binary_supported_ == 1;
+}
+
+uint64_t program_key_(const char* vertex_source, const char* fragment_source, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count)
+{
+  uint64_t h = krr_hash_string(vertex_source);
+  h = krr_hash_bytes(fragment_source, strlen(fragment_source), h);
+  for (int i=0; i<attrib_location_count; i++)
+  {
+    h = krr_hash_bytes(&attrib_locations[i].location, sizeof(attrib_locations[i].location), h);
+    h = krr_hash_bytes(attrib_locations[i].name, strlen(attrib_locations[i].name), h);
+  }
+
+  // binary is driver specific
+  const GLenum driver_strings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+  for (int i=0; i<3; i++)
+  {
+    const char* str = (const char*)glGetString(driver_strings[i]);
+    if (str != NULL)
+    {
+      h = krr_hash_bytes(str, strlen(str), h);
+    }
+  }
+  return h;
+}
+
+GLuint compile_shader_(const char* source, GLenum shader_type)
+{
+  // compile without checking, status is queried only when program is checked
+  GLuint shader_id = glCreateShader(shader_type);
+  glShaderSource(shader_id, 1, &source, NULL);
+  glCompileShader(shader_id);
+  return shader_id;
+}
+
+void submit_link_(pending_build_* build, bool retrievable)
+{
+  build->vertex_shader_id = compile_shader_(build->vertex_source, GL_VERTEX_SHADER);
+  build->fragment_shader_id = compile_shader_(build->fragment_source, GL_FRAGMENT_SHADER);
+
+  GLuint program_id = glCreateProgram();
+  glAttachShader(program_id, build->vertex_shader_id);
+  glAttachShader(program_id, build->fragment_shader_id);
+
+  for (int i=0; i<build->attrib_location_count; i++)
+  {
+    glBindAttribLocation(program_id, build->attrib_locations[i].location, build->attrib_locations[i].name);
+  }
+  if (retrievable)
+  {
+    glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
+  // link program, driver may do it in background
+  glLinkProgram(program_id);
+  build->program_id = program_id;
+}
+
+GLuint restore_program_binary_(const char* cache_file, uint64_t key)
+{
+  krr_filemap map;
+  if (!krr_filemap_open(&map, cache_file))
+  {
+    // no cache yet
+    return 0;
+  }
+
+  const program_binary_header_* header = map.data;
+  if (map.size < sizeof(program_binary_header_) ||
+      strncmp(header->magic, PROGRAM_BINARY_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != PROGRAM_BINARY_VERSION ||
+      header->key != key ||
+      map.size < sizeof(program_binary_header_) + header->binary_size)
+  {
+    SDL_Log("Program binary cache %s is stale, compile again", cache_file);
+    krr_filemap_close(&map);
+    return 0;
+  }
+
+  // binary follows header
+  // driver can still reject it i.e. after its update, that's checked along with link status
+  GLuint program_id = glCreateProgram();
+  glProgramBinary(program_id, header->binary_format, header + 1, (GLsizei)header->binary_size);
+  krr_filemap_close(&map);
+
+  return program_id;
+}
+
+bool is_complete_(const pending_build_* build)
+{
+  // without parallel compile, checking status is the only way to know, and it blocks
+  if (!(GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile))
+  {
+    return true;
+  }
+
+  GLint completed = GL_FALSE;
+  glGetProgramiv(build->program_id, GL_COMPLETION_STATUS_KHR, &completed);
+  return completed == GL_TRUE;
+}
+
+int find_pending_(gl_LShaderProgram* shader_program)
+{
+  if (pending_builds_ == NULL)
+  {
+    return -1;
+  }
+
+  for (int i=0; i<pending_builds_->len; i++)
+  {
+    pending_build_* build = vector_get(pending_builds_, i);
+    if (build->shader_program == shader_program)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void free_pending_(pending_build_* build)
+{
+  if (build->vertex_shader_id != 0)
+  {
+    glDeleteShader(build->vertex_shader_id);
+    build->vertex_shader_id = 0;
+  }
+  if (build->fragment_shader_id != 0)
+  {
+    glDeleteShader(build->fragment_shader_id);
+    build->fragment_shader_id = 0;
+  }
+  free(build->vertex_source);
+  free(build->fragment_source);
+  for (int i=0; i<build->attrib_location_count; i++)
+  {
+    free((char*)build->attrib_locations[i].name);
+  }
+  free(build->attrib_locations);
+  free(build->name);
+}
+
+bool finish_build_(int index, double* out_ms)
+{
+  // work on a copy, callback may submit, or free programs
+  pending_build_ build = *(pending_build_*)vector_get(pending_builds_, index);
+  vector_remove(pending_builds_, index);
+  build.shader_program->pending_ = false;
+
+  // blocks until driver is done
+  GLint linked = GL_FALSE;
+  glGetProgramiv(build.program_id, GL_LINK_STATUS, &linked);
+
+  const bool from_binary = build.vertex_shader_id == 0;
+  if (linked != GL_TRUE && from_binary)
+  {
+    SDL_Log("Program binary cache %s is rejected by driver, compile again", build.cache_file);
+    glDeleteProgram(build.program_id);
+
+    submit_link_(&build, true);
+    glGetProgramiv(build.program_id, GL_LINK_STATUS, &linked);
+  }
+
+  if (linked != GL_TRUE)
+  {
+    SDL_Log("Error building program %s", build.name);
+
+    // find out which stage failed
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(build.vertex_shader_id, GL_COMPILE_STATUS, &compiled);
+    if (compiled != GL_TRUE)
+    {
+      SDL_Log("Unable to compile vertex shader %u", build.vertex_shader_id);
+      gl_LShaderProgram_print_shader_log(build.vertex_shader_id);
+    }
+    glGetShaderiv(build.fragment_shader_id, GL_COMPILE_STATUS, &compiled);
+    if (compiled != GL_TRUE)
+    {
+      SDL_Log("Unable to compile fragment shader %u", build.fragment_shader_id);
+      gl_LShaderProgram_print_shader_log(build.fragment_shader_id);
+    }
+    gl_LShaderProgram_print_program_log(build.program_id);
+
+    glDeleteProgram(build.program_id);
+    free_pending_(&build);
+    return false;
+  }
+
+  if (build.vertex_shader_id == 0)
+  {
+    cache_stats_.binary_hits++;
+  }
+  else
+  {
+    cache_stats_.compiles++;
+
+    // failing to save cache is not fatal, next run will just compile again
+    if (build.cache_file[0] != '\0' && save_program_binary_(build.program_id, build.cache_file, build.key))
+    {
+      cache_stats_.binary_stores++;
+    }
+  }
+
+  double elapsed = (SDL_GetPerformanceCounter() - build.submit_counter) * 1000.0 / SDL_GetPerformanceFrequency();
+  cache_stats_.build_ms += elapsed;
+  if (out_ms != NULL)
+  {
+    *out_ms = elapsed;
+  }
+
+  // replace previous program if any
+  gl_LShaderProgram_free_program(build.shader_program);
+  build.shader_program->program_id = build.program_id;
+
+  // block binding is not part of program binary, set it after every link
+  gl_lframe_constants_bind_program(build.program_id);
+
+  if (build.on_linked != NULL)
+  {
+    build.on_linked(build.user_data);
+  }
+
+  free_pending_(&build);
+  return true;
+}
+
+bool save_program_binary_(GLuint program_id, const char* cache_file, uint64_t key)
+{
+  GLint binary_length = 0;
+  glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+  if (binary_length <= 0)
+  {
+    return false;
+  }
+
+  void* binary = malloc(binary_length);
+  GLenum binary_format = 0;
+  glGetProgramBinary(program_id, binary_length, &binary_length, &binary_format, binary);
+
+  program_binary_header_ header;
+  memset(&header, 0, sizeof(header));
+  strncpy(header.magic, PROGRAM_BINARY_MAGIC, sizeof(header.magic));
+  header.version = PROGRAM_BINARY_VERSION;
+  header.binary_format = binary_format;
+  header.key = key;
+  header.binary_size = binary_length;
+
+  // write to temporary file then rename, so a crash never leaves half-written cache behind
+  char tmp_file[512];
+  snprintf(tmp_file, sizeof(tmp_file), "%s.tmp", cache_file);
+
+  FILE* file = fopen(tmp_file, "wb");
+  if (file == NULL)
+  {
+    SDL_Log("Unable to open program binary cache %s for write", tmp_file);
+    free(binary);
+    return false;
+  }
+
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+    fwrite(binary, binary_length, 1, file) == 1;
+  ok = fclose(file) == 0 && ok;
+  file = NULL;
+  free(binary);
+
+  if (!ok)
+  {
+    SDL_Log("Unable to write program binary cache %s", tmp_file);
+    remove(tmp_file);
+    return false;
+  }
+
+  // rename doesn't replace existing file on every platform
+  remove(cache_file);
+  if (rename(tmp_file, cache_file) != 0)
+  {
+    SDL_Log("Unable to rename program binary cache %s to %s", tmp_file, cache_file);
+    remove(tmp_file);
+    return false;
+  }
+
+  return true;
+}
+
+void gl_LShaderProgram_set_binary_cache_dir(const char* dir)
+{
+  free(binary_cache_dir_);
+  binary_cache_dir_ = NULL;
+
+  if (dir != NULL)
+  {
+    binary_cache_dir_ = malloc(strlen(dir) + 1);
+    strcpy(binary_cache_dir_, dir);
+  }
+}
+
+bool gl_LShaderProgram_build_program(gl_LShaderProgram* shader_program, const char* vertex_shader_path, const char* fragment_shader_path, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count, gl_LShaderProgram_on_linked on_linked, void* user_data)
+{
+  return gl_LShaderProgram_build_program_with_defines(shader_program, vertex_shader_path, fragment_shader_path, NULL, 0, attrib_locations, attrib_location_count, on_linked, user_data);
+}
+
+bool gl_LShaderProgram_build_program_with_defines(gl_LShaderProgram* shader_program, const char* vertex_shader_path, const char* fragment_shader_path, const char* const* defines, int define_count, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count, gl_LShaderProgram_on_linked on_linked, void* user_data)
+{
+  // defines are part of preprocessed sources, thus of binary cache key too
+  char* vertex_source = gl_lshader_source_load(vertex_shader_path, defines, define_count);
+  char* fragment_source = gl_lshader_source_load(fragment_shader_path, defines, define_count);
+  if (vertex_source == NULL || fragment_source == NULL)
+  {
+    SDL_Log("Unable to read shader sources %s, %s", vertex_shader_path, fragment_shader_path);
+    free(vertex_source);
+    free(fragment_source);
+    return false;
+  }
+
+  // name for timing report, along with defines of variant
+  size_t name_len = strlen(vertex_shader_path) + strlen(fragment_shader_path) + 4;
+  for (int i=0; i<define_count; i++)
+  {
+    name_len += strlen(defines[i]) + 3;
+  }
+  char* name = malloc(name_len);
+  sprintf(name, "%s + %s", vertex_shader_path, fragment_shader_path);
+  for (int i=0; i<define_count; i++)
+  {
+    strcat(name, i == 0 ? " [" : ", ");
+    strcat(name, defines[i]);
+    strcat(name, i == define_count - 1 ? "]" : "");
+  }
+
+  return submit_build_(shader_program, name, vertex_source, fragment_source, attrib_locations, attrib_location_count, on_linked, user_data);
+}
+
+bool gl_LShaderProgram_build_program_from_sources(gl_LShaderProgram* shader_program, const char* name, const char* vertex_source, const char* fragment_source, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count, gl_LShaderProgram_on_linked on_linked, void* user_data)
+{
+  // sources are kept until program is linked
+  char* name_copy = malloc(strlen(name) + 1);
+  strcpy(name_copy, name);
+  char* vertex_copy = malloc(strlen(vertex_source) + 1);
+  strcpy(vertex_copy, vertex_source);
+  char* fragment_copy = malloc(strlen(fragment_source) + 1);
+  strcpy(fragment_copy, fragment_source);
+
+  return submit_build_(shader_program, name_copy, vertex_copy, fragment_copy, attrib_locations, attrib_location_count, on_linked, user_data);
+}
+
+bool submit_build_(gl_LShaderProgram* shader_program, char* name, char* vertex_source, char* fragment_source, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count, gl_LShaderProgram_on_linked on_linked, void* user_data)
+{
+  // build takes ownership of name, and sources
+  pending_build_ build;
+  memset(&build, 0, sizeof(build));
+  build.shader_program = shader_program;
+  build.name = name;
+  build.vertex_source = vertex_source;
+  build.fragment_source = fragment_source;
+  build.on_linked = on_linked;
+  build.user_data = user_data;
+  build.submit_counter = SDL_GetPerformanceCounter();
+
+  // own a copy of attribute locations until program is linked
+  build.attrib_location_count = attrib_location_count;
+  build.attrib_locations = malloc(attrib_location_count * sizeof(gl_LShaderProgram_attrib_location) + 1);
+  for (int i=0; i<attrib_location_count; i++)
+  {
+    build.attrib_locations[i].location = attrib_locations[i].location;
+    char* name = malloc(strlen(attrib_locations[i].name) + 1);
+    strcpy(name, attrib_locations[i].name);
+    build.attrib_locations[i].name = name;
+  }
+
+  const bool use_cache = binary_cache_dir_ != NULL && is_binary_supported_();
+  if (use_cache)
+  {
+    build.key = program_key_(build.vertex_source, build.fragment_source, attrib_locations, attrib_location_count);
+    snprintf(build.cache_file, sizeof(build.cache_file), "%s/%016llx.glprogram", binary_cache_dir_, (unsigned long long)build.key);
+
+    build.program_id = restore_program_binary_(build.cache_file, build.key);
+  }
+  if (build.program_id == 0)
+  {
+    submit_link_(&build, use_cache);
+  }
+
+  // a program submitted again replaces its previous submission
+  int index = find_pending_(shader_program);
+  if (index != -1)
+  {
+    pending_build_* previous = vector_get(pending_builds_, index);
+    glDeleteProgram(previous->program_id);
+    free_pending_(previous);
+    vector_remove(pending_builds_, index);
+  }
+
+  if (pending_builds_ == NULL)
+  {
+    pending_builds_ = vector_new(8, sizeof(pending_build_));
+  }
+  vector_add(pending_builds_, &build);
+  shader_program->pending_ = true;
+
+  // outside of batch, program is ready on return
+  if (!batching_)
+  {
+    return finish_build_(pending_builds_->len - 1, NULL);
+  }
+  return true;
+}
+
+void gl_LShaderProgram_begin_batch()
+{
+  // let driver compile on its own threads, only needs to be set once
+  static bool threads_set = false;
+  if (!threads_set)
+  {
+    if (GLEW_KHR_parallel_shader_compile)
+    {
+      glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    }
+    else if (GLEW_ARB_parallel_shader_compile)
+    {
+      glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+    }
+    threads_set = true;
+  }
+
+  batching_ = true;
+}
+
+bool gl_LShaderProgram_wait_all()
+{
+  batching_ = false;
+  if (pending_builds_ == NULL)
+  {
+    return true;
+  }
+
+  bool result = true;
+  Uint64 start = SDL_GetPerformanceCounter();
+
+  // check whichever program driver has finished first, so timings reflect when each one became ready
+  while (pending_builds_->len > 0)
+  {
+    int index = -1;
+    for (int i=0; i<pending_builds_->len && index == -1; i++)
+    {
+      if (is_complete_(vector_get(pending_builds_, i)))
+      {
+        index = i;
+      }
+    }
+    if (index == -1)
+    {
+      SDL_Delay(0);
+      continue;
+    }
+
+    // name is freed when finished
+    pending_build_* build = vector_get(pending_builds_, index);
+    char name[512];
+    snprintf(name, sizeof(name), "%s", build->name);
+    const bool from_binary = build->vertex_shader_id == 0;
+
+    double ms = 0.0;
+    if (finish_build_(index, &ms))
+    {
+      SDL_Log("Program %s ready in %.3f ms (%s)", name, ms, from_binary ? "binary" : "compiled");
+    }
+    else
+    {
+      result = false;
+    }
+  }
+
+  SDL_Log("All programs ready in %.3f ms", (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency());
+
+  vector_free(pending_builds_);
+  pending_builds_ = NULL;
+  return result;
+}
+
+gl_LShaderProgram_cache_stats gl_LShaderProgram_get_cache_stats()
+{
+  return cache_stats_;
+}
+
 void gl_LShaderProgram_free_program(gl_LShaderProgram* shader_program)
 {
+  // drop submission not checked yet
+  if (shader_program->pending_)
+  {
+    int index = find_pending_(shader_program);
+    pending_build_* build = vector_get(pending_builds_, index);
+    glDeleteProgram(build->program_id);
+    free_pending_(build);
+    vector_remove(pending_builds_, index);
+    shader_program->pending_ = false;
+  }
+
   // delete program
   glDeleteProgram(shader_program->program_id);
   shader_program->program_id = 0;
@@ -132,6 +669,12 @@ void gl_LShaderProgram_free_program(gl_LShaderProgram* shader_program)
 
 bool gl_LShaderProgram_bind(gl_LShaderProgram* shader_program)
 {
+  // program submitted in batch is checked when it's first needed
+  if (shader_program->pending_ && !finish_build_(find_pending_(shader_program), NULL))
+  {
+    return false;
+  }
+
 	// check whether we need to bind again
 	GLint current_bound;
 	glGetIntegerv(GL_CURRENT_PROGRAM, &current_bound);
@@ -139,7 +682,7 @@ bool gl_LShaderProgram_bind(gl_LShaderProgram* shader_program)
 	// if such program is already bound, then return now
 	if (current_bound == shader_program->program_id)
 	{
-		SDL_Log("Program is already bound, no need to bind again");
+		KRR_LOGD("Program is already bound, no need to bind again");
 		return true;
 	}
 
@@ -147,7 +690,7 @@ bool gl_LShaderProgram_bind(gl_LShaderProgram* shader_program)
   glUseProgram(shader_program->program_id);
 
   // check for error
-  GLenum error = glGetError();
+  GLenum error = GL_LDEBUG_GET_ERROR();
   if (error != GL_NO_ERROR)
   {
     krr_util_print_callstack();
@@ -8,8 +8,36 @@ typedef struct
 {
   // program id
   GLuint program_id;
+
+  /// (internal use) true while program is submitted in batch, and its link status isn't checked yet
+  bool pending_;
 } gl_LShaderProgram;
 
+/// called once program is linked successfully i.e. to look up its attribute, and uniform locations
+typedef void (*gl_LShaderProgram_on_linked)(void* user_data);
+
+/// attribute to bind to fixed location before linking
+typedef struct
+{
+  /// attribute location
+  GLuint location;
+  /// attribute name in vertex shader
+  const char* name;
+} gl_LShaderProgram_attrib_location;
+
+/// program binary cache statistics
+typedef struct
+{
+  /// programs restored from binary cache
+  unsigned int binary_hits;
+  /// programs compiled, and linked from source
+  unsigned int compiles;
+  /// program binaries written into cache
+  unsigned int binary_stores;
+  /// total time spent building programs in milliseconds
+  double build_ms;
+} gl_LShaderProgram_cache_stats;
+
 ///
 /// Create a new shader program.
 ///
@@ -26,6 +54,7 @@ extern void gl_LShaderProgram_free(gl_LShaderProgram* shader_program);
 
 ///
 /// Load shader from file according to type.
+/// Its #include lines are resolved (see gl_lshader_source).
 ///
 /// \param path Path to shader file
 /// \param shader_type Type of shader
@@ -33,6 +62,105 @@ extern void gl_LShaderProgram_free(gl_LShaderProgram* shader_program);
 ///
 extern GLuint gl_LShaderProgram_load_shader_from_file(const char* path, GLenum shader_type);
 
+///
+/// Load shader from source string according to type.
+///
+/// \param source Null-terminated shader source
+/// \param shader_type Type of shader
+/// \return Return id of a compiled shader, or 0 if failed.
+///
+extern GLuint gl_LShaderProgram_load_shader_from_source(const char* source, GLenum shader_type);
+
+///
+/// Set directory to keep linked program binaries in.
+/// Programs built via gl_LShaderProgram_build_program() are then restored from it on later runs
+/// instead of being compiled, as long as sources, attribute locations, and GL vendor, renderer and version
+/// stay the same.
+/// Directory must exist. It has no effect if driver doesn't support program binary.
+///
+/// \param dir Directory path, it will be copied. NULL to disable binary cache, it's disabled by default.
+///
+extern void gl_LShaderProgram_set_binary_cache_dir(const char* dir);
+
+///
+/// Build program from vertex, and fragment shader files then set it to shader program.
+/// Shader files may #include other files relative to their own directory (see gl_lshader_source).
+/// Linked program is restored from binary cache if available (see gl_LShaderProgram_set_binary_cache_dir()),
+/// otherwise it's compiled from source then stored into cache.
+///
+/// Between gl_LShaderProgram_begin_batch(), and gl_LShaderProgram_wait_all() program is only submitted to driver,
+/// its status is checked, and on_linked is called when it's first bound, or when all programs are waited.
+/// Otherwise program is ready, and on_linked is already called when this function returns.
+/// If program declares FrameConstants uniform block, it's bound to shared frame constants (see gl_lframe_constants).
+///
+/// \param shader_program Pointer to gl_LShaderProgram
+/// \param vertex_shader_path Path to vertex shader file
+/// \param fragment_shader_path Path to fragment shader file
+/// \param attrib_locations Attributes to bind to fixed locations before linking. It can be NULL.
+/// \param attrib_location_count Number of attribute locations
+/// \param on_linked Function to call once program is linked. It can be NULL.
+/// \param user_data User data passed to on_linked
+/// \return True if program is built, or submitted successfully, otherwise return false.
+///
+extern bool gl_LShaderProgram_build_program(gl_LShaderProgram* shader_program, const char* vertex_shader_path, const char* fragment_shader_path, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count, gl_LShaderProgram_on_linked on_linked, void* user_data);
+
+///
+/// Build program the same as gl_LShaderProgram_build_program() but with defines injected into both shaders
+/// to specialize it at compile time (see gl_lshader_source). Each set of defines is its own program,
+/// and its own binary cache entry.
+///
+/// \param shader_program Pointer to gl_LShaderProgram
+/// \param vertex_shader_path Path to vertex shader file
+/// \param fragment_shader_path Path to fragment shader file
+/// \param defines Defines to inject, each either "NAME", or "NAME=VALUE". It can be NULL.
+/// \param define_count Number of defines
+/// \param attrib_locations Attributes to bind to fixed locations before linking. It can be NULL.
+/// \param attrib_location_count Number of attribute locations
+/// \param on_linked Function to call once program is linked. It can be NULL.
+/// \param user_data User data passed to on_linked
+/// \return True if program is built, or submitted successfully, otherwise return false.
+///
+extern bool gl_LShaderProgram_build_program_with_defines(gl_LShaderProgram* shader_program, const char* vertex_shader_path, const char* fragment_shader_path, const char* const* defines, int define_count, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count, gl_LShaderProgram_on_linked on_linked, void* user_data);
+
+///
+/// Build program the same as gl_LShaderProgram_build_program() but from sources already in memory,
+/// i.e. embedded into executable, or read from asset pack. Sources are used as they are, #include
+/// lines are not resolved.
+///
+/// \param shader_program Pointer to gl_LShaderProgram
+/// \param name Name of program for timing report
+/// \param vertex_source Null-terminated vertex shader source, it will be copied.
+/// \param fragment_source Null-terminated fragment shader source, it will be copied.
+/// \param attrib_locations Attributes to bind to fixed locations before linking. It can be NULL.
+/// \param attrib_location_count Number of attribute locations
+/// \param on_linked Function to call once program is linked. It can be NULL.
+/// \param user_data User data passed to on_linked
+/// \return True if program is built, or submitted successfully, otherwise return false.
+///
+extern bool gl_LShaderProgram_build_program_from_sources(gl_LShaderProgram* shader_program, const char* name, const char* vertex_source, const char* fragment_source, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count, gl_LShaderProgram_on_linked on_linked, void* user_data);
+
+///
+/// Start submitting programs without waiting for each one.
+/// Programs built until gl_LShaderProgram_wait_all() are compiled, and linked by driver in overlap,
+/// on its own threads if GL_KHR_parallel_shader_compile is available.
+///
+extern void gl_LShaderProgram_begin_batch();
+
+///
+/// Wait for all submitted programs, check their status, and report time each one took to be ready.
+/// It ends batch started by gl_LShaderProgram_begin_batch().
+///
+/// \return True if all programs are built successfully, otherwise return false.
+///
+extern bool gl_LShaderProgram_wait_all();
+
+///
+/// Get program binary cache statistics.
+///
+/// \return Statistics since start
+///
+extern gl_LShaderProgram_cache_stats gl_LShaderProgram_get_cache_stats();
+
 ///
 /// Free shader program
 ///
@@ -3,7 +3,11 @@
 #include "foundation/krr_math.h"
 #include "foundation/krr_util.h"
 #include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "gl/gl_lsampler_cache.h"
+#include "gl/gl_lvertex_format.h"
 #include "gl/gl_ltextured_polygon_program2d.h"
+#include "gl/gl_ltexture_manager_internals.h"
 #include "SDL_log.h"
 #include "SDL_image.h"
 #include <stdio.h>
@@ -19,10 +23,17 @@ static GLenum DEFAULT_TEXTURE_WRAP = GL_REPEAT;
 static void init_defaults(gl_LTexture* texture);
 // find next POT value from input value
 static int find_next_pot(int value);
+// pick default sampler with min filter for texture unless caller set one
+static void use_sampler_(gl_LTexture* texture, GLenum min_filter);
 
-// initialize VBO and IBO
-static void init_VBO_IBO(gl_LTexture* texture);
-static void free_VBO_IBO(gl_LTexture* texture);
+// shared unit quad geometry used to render all textures
+// each draw transforms it via modelview matrix, and maps its texture coordinates via texcoord clip
+// unit quad is exact in compact layout, and drawn from shared quad index buffer (see gl_lvertex_format)
+#define SHARED_QUAD_FORMAT LVERTEX_FORMAT_COMPACT_SHORT
+static GLuint shared_quad_VBO_id_ = 0;
+
+// initialize shared quad's VBO if not yet
+static void init_shared_quad_();
 
 void init_defaults(gl_LTexture* texture)
 {
@@ -32,14 +43,46 @@ void init_defaults(gl_LTexture* texture)
   texture->pixels = NULL;
   texture->pixels8 = NULL;
   texture->pixel_format = 0;
+  texture->sampler = 0;
   texture->physical_width_ = 0;
   texture->physical_height_ = 0;
-  texture->VBO_id = 0;
-  texture->IBO_id = 0;
+  texture->manager_handle_ = -1;
+  texture->sampler_overridden_ = false;
+}
+
+void use_sampler_(gl_LTexture* texture, GLenum min_filter)
+{
+  gl_lsampler_desc desc = gl_lsampler_desc_default;
+  desc.min_filter = min_filter;
+  desc.wrap_s = DEFAULT_TEXTURE_WRAP;
+  desc.wrap_t = DEFAULT_TEXTURE_WRAP;
+
+  // what's loaded now decides filtering, previous load's sampler may not fit it
+  if (!texture->sampler_overridden_)
+  {
+    texture->sampler = gl_lsampler_cache_get(&desc);
+
+    // texture has no filtering of its own, without sampler its default min filter
+    // of GL_NEAREST_MIPMAP_LINEAR would leave it incomplete
+    if (texture->sampler == 0)
+    {
+      SDL_Log("Unable to get sampler for texture, falling back to default one");
+      texture->sampler = gl_lsampler_cache_get(&gl_lsampler_desc_default);
+    }
+  }
+}
+
+void gl_LTexture_set_sampler(gl_LTexture* texture, GLuint sampler)
+{
+  texture->sampler = sampler;
+  texture->sampler_overridden_ = true;
 }
 
 void gl_LTexture_free_internal_texture(gl_LTexture* texture)
 {
+  // GPU memory is no longer used
+  gl_ltexture_manager_on_release(texture);
+
   if (texture != NULL && texture->texture_id != 0)
   {
     glDeleteTextures(1, &texture->texture_id);
@@ -63,8 +106,6 @@ void gl_LTexture_free_internal_texture(gl_LTexture* texture)
   texture->physical_width_ = 0;
   texture->physical_height_ = 0;
   texture->pixel_format = 0;
-
-  free_VBO_IBO(texture);
 }
 
 gl_LTexture* gl_LTexture_new()
@@ -117,32 +158,34 @@ struct DDS_Header {
 
 static void _print_dds_header_struct(struct DDS_Header* header)
 {
-  SDL_Log("DDS_Header");
-  SDL_Log("- size of struct (should be 124): %d", header->size);
-  SDL_Log("- flags: 0x%X", header->flags);
-  SDL_Log("- height: %d", header->height);
-  SDL_Log("- width: %d", header->width);
-  SDL_Log("- pitch or linear size: %d", header->pitch_or_linear_size);
-  SDL_Log("- depth (for volume texture): %d", header->depth);
-  SDL_Log("- mipmap count: %d", header->mipmap_count);
-  SDL_Log("- DDS_PixelFormat");
-  SDL_Log("\t- size of struct (should be 32): %d", header->dds_pixel_format.size);
-  SDL_Log("\t- flags: 0x%X", header->dds_pixel_format.flags);
+  KRR_LOGD("DDS_Header");
+  KRR_LOGD("- size of struct (should be 124): %d", header->size);
+  KRR_LOGD("- flags: 0x%X", header->flags);
+  KRR_LOGD("- height: %d", header->height);
+  KRR_LOGD("- width: %d", header->width);
+  KRR_LOGD("- pitch or linear size: %d", header->pitch_or_linear_size);
+  KRR_LOGD("- depth (for volume texture): %d", header->depth);
+  KRR_LOGD("- mipmap count: %d", header->mipmap_count);
+  KRR_LOGD("- DDS_PixelFormat");
+  KRR_LOGD("\t- size of struct (should be 32): %d", header->dds_pixel_format.size);
+  KRR_LOGD("\t- flags: 0x%X", header->dds_pixel_format.flags);
   char fourcc_chrs[5];
   memset(fourcc_chrs, 0, sizeof(fourcc_chrs));
   strncpy(fourcc_chrs, (char*)&header->dds_pixel_format.fourcc, 4);
-  SDL_Log("\t- fourCC: %s [0x%X]", fourcc_chrs, header->dds_pixel_format.fourcc);
-  SDL_Log("\t- RGB bit count: %d", header->dds_pixel_format.rgb_bitcount);
-  SDL_Log("\t- R bitmask: %d", header->dds_pixel_format.r_bitmask);
-  SDL_Log("\t- G bitmask: %d", header->dds_pixel_format.g_bitmask);
-  SDL_Log("\t- B bitmask: %d", header->dds_pixel_format.b_bitmask);
-  SDL_Log("\t- A bitmask: %d", header->dds_pixel_format.a_bitmask);
+  KRR_LOGD("\t- fourCC: %s [0x%X]", fourcc_chrs, header->dds_pixel_format.fourcc);
+  KRR_LOGD("\t- RGB bit count: %d", header->dds_pixel_format.rgb_bitcount);
+  KRR_LOGD("\t- R bitmask: %d", header->dds_pixel_format.r_bitmask);
+  KRR_LOGD("\t- G bitmask: %d", header->dds_pixel_format.g_bitmask);
+  KRR_LOGD("\t- B bitmask: %d", header->dds_pixel_format.b_bitmask);
+  KRR_LOGD("\t- A bitmask: %d", header->dds_pixel_format.a_bitmask);
 }
 
 void gl_LTexture_free(gl_LTexture* texture)
 {
   if (texture != NULL)
   {
+    // unregister from texture manager
+    gl_ltexture_manager_on_free(texture);
     // free internal texture
     gl_LTexture_free_internal_texture(texture);
     // free allocated memory
@@ -162,7 +205,7 @@ bool gl_LTexture_load_texture_from_file(gl_LTexture* texture, const char* path)
     return false;
   }
   
-  SDL_Log("format loaded surface: %s", SDL_GetPixelFormatName(loaded_surface->format->format));
+  KRR_LOGD("format loaded surface: %s", SDL_GetPixelFormatName(loaded_surface->format->format));
 
   // convert pixel format
   SDL_Surface* converted_surface = SDL_ConvertSurfaceFormat(loaded_surface, SDL_PIXELFORMAT_ABGR8888, 0);
@@ -179,7 +222,7 @@ bool gl_LTexture_load_texture_from_file(gl_LTexture* texture, const char* path)
     return false;
   }
 
-  SDL_Log("format: %s", SDL_GetPixelFormatName(converted_surface->format->format));
+  KRR_LOGD("format: %s", SDL_GetPixelFormatName(converted_surface->format->format));
 
   // free surface
   SDL_FreeSurface(loaded_surface);
@@ -187,6 +230,9 @@ bool gl_LTexture_load_texture_from_file(gl_LTexture* texture, const char* path)
   loaded_surface = NULL;
   converted_surface = NULL;
 
+  // it can be reloaded from file if evicted
+  gl_ltexture_manager_set_source(texture, GL_LTEXTURE_MANAGER_SOURCE_FILE, path, 0);
+
   return true;
 }
 
@@ -223,6 +269,9 @@ bool gl_LTexture_load_texture_from_file_ex(gl_LTexture* texture, const char* pat
     return false;
   }
 
+  // it can be reloaded from file if evicted
+  gl_ltexture_manager_set_source(texture, GL_LTEXTURE_MANAGER_SOURCE_FILE_COLOR_KEY, path, color_key);
+
   return true;
 }
 
@@ -279,13 +328,13 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
     return false;
   }
 
-  SDL_Log("current file offset is at %ld", ftell(fp));
+  KRR_LOGD("current file offset is at %ld", ftell(fp));
 
   // header section
   struct DDS_Header header;
   memset(&header, 0, sizeof(header));
 
-  SDL_Log("size of header section for dds file format: %lu", sizeof(header));
+  KRR_LOGD("size of header section for dds file format: %lu", sizeof(header));
 
   // read header section
   f_nobj_read = fread(&header, sizeof(header), 1, fp);
@@ -296,7 +345,7 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
     return false;
   }
 
-  SDL_Log("---");
+  KRR_LOGD("---");
 
   // print struct info
   _print_dds_header_struct(&header);
@@ -320,7 +369,7 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
 
   // read base image's pixel data
   // 0x31545844 represents "DXT1" in hexadecimal, we could convert fourcc to char* then compare to string literal as well
-  SDL_Log("header.dds_pixel_format.fourcc: 0x%X", header.dds_pixel_format.fourcc);
+  KRR_LOGD("header.dds_pixel_format.fourcc: 0x%X", header.dds_pixel_format.fourcc);
   int blocksize = header.dds_pixel_format.fourcc == 0x31545844 ? 8 : 16;
   
   // set opengl format
@@ -330,12 +379,12 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
     if ((header.dds_pixel_format.flags & 0x1) == 0)
     {
       gl_format = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
-      SDL_Log("RGB DXT1");
+      KRR_LOGD("RGB DXT1");
     }
     else
     {
       gl_format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
-      SDL_Log("RGBA DXT1");
+      KRR_LOGD("RGBA DXT1");
     }
   }
   // if blocksize is 16, then it has alpha channel thus we properly set opengl format
@@ -347,21 +396,21 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
       // DXT3
       case 0x33545844:
         gl_format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
-        SDL_Log("RGBA DXT3");
+        KRR_LOGD("RGBA DXT3");
         break;
       // DXT5
       case 0x35545844:
         gl_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-        SDL_Log("RGBA DXT5");
+        KRR_LOGD("RGBA DXT5");
         break;
     }
   }
 
-  SDL_Log("blocksize: %d", blocksize);
+  KRR_LOGD("blocksize: %d", blocksize);
 
   // get total size of base image + mipmaps (if any)
   int images_size = ceil(header.width / 4.0) * ceil(header.height / 4.0) * blocksize;
-  SDL_Log("level 0 width: %d, height: %d, size: %d", header.width, header.height, images_size);
+  KRR_LOGD("level 0 width: %d, height: %d, size: %d", header.width, header.height, images_size);
   {
     int width = krr_math_max(1, header.width);
     int height = krr_math_max(1, header.height);
@@ -386,11 +435,11 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
       }
 
       int level_size = ceil(width / 4.0) * ceil(height / 4.0) * blocksize;
-      SDL_Log("level %d width: %d, height: %d, size: %d", level, width, height, level_size);
+      KRR_LOGD("level %d width: %d, height: %d, size: %d", level, width, height, level_size);
 
       images_size += level_size;
     }
-    SDL_Log("images_size: %d", images_size);
+    KRR_LOGD("images_size: %d", images_size);
   }
 
   // define images buffer space
@@ -408,7 +457,7 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
   fclose(fp);
   fp = NULL;
 
-  SDL_Log("---");
+  KRR_LOGD("---");
 
   // texture id
   GLuint texture_id;
@@ -418,13 +467,11 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
   glBindTexture(GL_TEXTURE_2D, texture_id);
 
   // set texture paremters
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  // filtering, and wrapping are in sampler
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header.mipmap_count == 0 ? 0 : header.mipmap_count - 1);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, DEFAULT_TEXTURE_WRAP);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, DEFAULT_TEXTURE_WRAP);
+  use_sampler_(texture, header.mipmap_count > 1 ? GL_NEAREST_MIPMAP_LINEAR : GL_LINEAR);
 
-  SDL_Log("Format: 0x%X", gl_format);
+  KRR_LOGD("Format: 0x%X", gl_format);
 
   int offset = 0;
   int width = header.width;
@@ -437,7 +484,7 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
     // create compressed texture
     glCompressedTexImage2D(GL_TEXTURE_2D, level, gl_format, width, height, 0, size, images_buffer + offset);
 
-    SDL_Log("level %d, width: %d, height: %d, size: %d", level, width, height, size);
+    KRR_LOGD("level %d, width: %d, height: %d, size: %d", level, width, height, size);
 
     // proceed next
     offset += size;
@@ -455,7 +502,7 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
   texture->physical_height_ = header.height;
 
   // check for errors
-  GLenum error = glGetError();
+  GLenum error = GL_LDEBUG_GET_ERROR();
   if (error != GL_NO_ERROR)
   {
     krr_util_print_callstack();
@@ -463,12 +510,13 @@ bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const char* pa
     return false;
   }
 
-  // init VBO and IBO
-  init_VBO_IBO(texture);
-
   // set pixel format
   texture->pixel_format = gl_format;
 
+  // register with texture manager, images_size covers all mipmap levels
+  gl_ltexture_manager_on_upload(texture, images_size);
+  gl_ltexture_manager_set_source(texture, GL_LTEXTURE_MANAGER_SOURCE_DDS, path, 0);
+
   return true;
 }
 
@@ -485,7 +533,7 @@ bool gl_LTexture_load_texture_from_pixels32(gl_LTexture* texture, GLuint* pixels
   {
     // find next POT for width
     texture->physical_width_ = find_next_pot(width);
-    SDL_Log("physical_width: %u", texture->physical_width_);
+    KRR_LOGD("physical_width: %u", texture->physical_width_);
     is_need_to_resize = true;
   }
   // otherwise width is the same as original input texture
@@ -499,7 +547,7 @@ bool gl_LTexture_load_texture_from_pixels32(gl_LTexture* texture, GLuint* pixels
   {
     // find next POT for height
     texture->physical_height_ = find_next_pot(height);
-    SDL_Log("physical_height: %u", texture->physical_height_);
+    KRR_LOGD("physical_height: %u", texture->physical_height_);
     is_need_to_resize = true;
   }
   // otherwise height is the same as original input texture
@@ -513,8 +561,8 @@ bool gl_LTexture_load_texture_from_pixels32(gl_LTexture* texture, GLuint* pixels
   texture->width = width;
   texture->height = height;
 
-  SDL_Log("original width: %d", width);
-  SDL_Log("original height: %d", height);
+  KRR_LOGD("original width: %d", width);
+  KRR_LOGD("original height: %d", height);
 
   // if need to resize, then put original pixels data at the top left
   // and pad the less with fully transparent white color
@@ -560,14 +608,10 @@ bool gl_LTexture_load_texture_from_pixels32(gl_LTexture* texture, GLuint* pixels
   // bind texture id
   glBindTexture(GL_TEXTURE_2D, texture->texture_id);
 
-  // set texture parameters
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, DEFAULT_TEXTURE_WRAP);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, DEFAULT_TEXTURE_WRAP);
-  
   // there's no mipmap for this single texture
+  // filtering, and wrapping are in sampler
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+  use_sampler_(texture, GL_LINEAR);
 
   // generate texture
   if (is_need_to_resize)
@@ -590,7 +634,7 @@ bool gl_LTexture_load_texture_from_pixels32(gl_LTexture* texture, GLuint* pixels
   }
 
   // check for errors
-  GLenum error = glGetError();
+  GLenum error = GL_LDEBUG_GET_ERROR();
   if (error != GL_NO_ERROR)
   {
     krr_util_print_callstack();
@@ -598,12 +642,12 @@ bool gl_LTexture_load_texture_from_pixels32(gl_LTexture* texture, GLuint* pixels
     return false;
   }
 
-  // init VBO and IBO
-  init_VBO_IBO(texture);
-
   // set pixel format
   texture->pixel_format = GL_RGBA;
 
+  // register with texture manager
+  gl_ltexture_manager_on_upload(texture, texture->physical_width_ * texture->physical_height_ * sizeof(GLuint));
+
   return true;
 }
 
@@ -639,45 +683,36 @@ void gl_LTexture_render(gl_LTexture* texture, GLfloat x, GLfloat y, const LRect*
   // we will work on top of shader's modelview matrix
   glm_mat4_copy(shared_textured_shaderprogram->modelview_matrix, original_modelview_matrix);
 
-  // move to rendering position
+  // move to rendering position, then scale shared unit quad to quad size
   glm_translate(shared_textured_shaderprogram->modelview_matrix, (vec3){x, y, 0.f});
+  glm_scale(shared_textured_shaderprogram->modelview_matrix, (vec3){quad_width, quad_height, 1.f});
   // issue update to gpu
   gl_ltextured_polygon_program2d_update_modelview_matrix(shared_textured_shaderprogram);
 
-  // set vertex data
-  LVertexData2D vertex_data[4];
+  // map unit quad's texture coordinates onto region to render
+  gl_ltextured_polygon_program2d_set_texcoord_clip(shared_textured_shaderprogram, tex_left, tex_top, tex_right - tex_left, tex_bottom - tex_top);
 
-  // texture coordinates
-  vertex_data[0].texcoord.s = tex_left;     vertex_data[0].texcoord.t = tex_top;
-  vertex_data[1].texcoord.s = tex_right;    vertex_data[1].texcoord.t = tex_top;
-  vertex_data[2].texcoord.s = tex_right;    vertex_data[2].texcoord.t = tex_bottom;
-  vertex_data[3].texcoord.s = tex_left;     vertex_data[3].texcoord.t = tex_bottom;
-
-  // vertex position
-  vertex_data[0].position.x = 0.f;          vertex_data[0].position.y = 0.f;
-  vertex_data[1].position.x = quad_width;   vertex_data[1].position.y = 0.f;
-  vertex_data[2].position.x = quad_width;   vertex_data[2].position.y = quad_height;
-  vertex_data[3].position.x = 0.f;          vertex_data[3].position.y = quad_height;
-
-  // set texture id
+  // mark as used, reload if it was evicted
+  gl_ltexture_manager_touch(texture);
+
+  // set texture id, and its sampler
   glBindTexture(GL_TEXTURE_2D, texture->texture_id);
+  gl_lsampler_cache_bind(0, texture->sampler);
+
+  // make sure shared quad is ready
+  init_shared_quad_();
   
   // enable vertex and texture coordinate vertex attribute arrays
   gl_ltextured_polygon_program2d_enable_attrib_pointers(shared_textured_shaderprogram);
   
-    // bind vertex buffer
-    glBindBuffer(GL_ARRAY_BUFFER, texture->VBO_id);
-    // update vertex buffer data to GPU
-    glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * sizeof(LVertexData2D), vertex_data);
+    // bind shared vertex buffer
+    glBindBuffer(GL_ARRAY_BUFFER, shared_quad_VBO_id_);
 
-    // set texture coordinate data
-    gl_ltextured_polygon_program2d_set_texcoord_pointer(shared_textured_shaderprogram, sizeof(LVertexData2D), (const GLvoid*)offsetof(LVertexData2D, texcoord));
-    // set vertex data
-    gl_ltextured_polygon_program2d_set_vertex_pointer(shared_textured_shaderprogram, sizeof(LVertexData2D), (const GLvoid*)offsetof(LVertexData2D, position));
+    // set vertex, and texture coordinate data
+    gl_ltextured_polygon_program2d_set_attrib_pointers(shared_textured_shaderprogram, SHARED_QUAD_FORMAT, NULL);
 
-    // draw quad using vertex and index data
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, texture->IBO_id);
-    glDrawElements(GL_TRIANGLE_FAN, 4, GL_UNSIGNED_INT, NULL);
+    // draw quad using vertex and shared index data
+    gl_lvertex_format_draw_quads(0, 1);
 
   // unbind
   glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -685,6 +720,9 @@ void gl_LTexture_render(gl_LTexture* texture, GLfloat x, GLfloat y, const LRect*
 
   // disable vertex and texture coord attribute pointer
   gl_ltextured_polygon_program2d_disable_attrib_pointers(shared_textured_shaderprogram);
+
+  // set modelview matrix back to original one
+  glm_mat4_copy(original_modelview_matrix, shared_textured_shaderprogram->modelview_matrix);
 }
 
 bool gl_LTexture_lock(gl_LTexture* texture)
@@ -692,6 +730,9 @@ bool gl_LTexture_lock(gl_LTexture* texture)
   // if texture is not locked yet, and it exists
   if (texture->pixels == NULL && texture->pixels8 == NULL && texture->texture_id != 0)
   {
+    // modified pixels cannot be reloaded from source, pin it
+    gl_ltexture_manager_set_source(texture, GL_LTEXTURE_MANAGER_SOURCE_NONE, NULL, 0);
+
     // check whether which pixel format to work with
     GLuint size = 0;
     if (texture->pixel_format == GL_RED)
@@ -791,7 +832,7 @@ bool gl_LTexture_load_pixels_from_file(gl_LTexture* texture, const char* path)
     return false;
   }
   
-  SDL_Log("format loaded surface: %s", SDL_GetPixelFormatName(loaded_surface->format->format));
+  KRR_LOGD("format loaded surface: %s", SDL_GetPixelFormatName(loaded_surface->format->format));
 
   // convert pixel format
   SDL_Surface* converted_surface = SDL_ConvertSurfaceFormat(loaded_surface, SDL_PIXELFORMAT_ABGR8888, 0);
@@ -806,7 +847,7 @@ bool gl_LTexture_load_pixels_from_file(gl_LTexture* texture, const char* path)
   SDL_FreeSurface(loaded_surface);
   loaded_surface = NULL;
 
-  SDL_Log("format: %s", SDL_GetPixelFormatName(converted_surface->format->format));
+  KRR_LOGD("format: %s", SDL_GetPixelFormatName(converted_surface->format->format));
 
   // check whether we need to resize to POT texture
   bool is_need_to_resize = false;
@@ -819,7 +860,7 @@ bool gl_LTexture_load_pixels_from_file(gl_LTexture* texture, const char* path)
   {
     // find next POT for width
     texture->physical_width_ = find_next_pot(width);
-    SDL_Log("physical_width: %u", texture->physical_width_);
+    KRR_LOGD("physical_width: %u", texture->physical_width_);
     is_need_to_resize = true;
   }
   // otherwise width is the same as original input texture
@@ -833,7 +874,7 @@ bool gl_LTexture_load_pixels_from_file(gl_LTexture* texture, const char* path)
   {
     // find next POT for height
     texture->physical_height_ = find_next_pot(height);
-    SDL_Log("physical_height: %u", texture->physical_height_);
+    KRR_LOGD("physical_height: %u", texture->physical_height_);
     is_need_to_resize = true;
   }
   // otherwise height is the same as original input texture
@@ -847,8 +888,8 @@ bool gl_LTexture_load_pixels_from_file(gl_LTexture* texture, const char* path)
   texture->width = width;
   texture->height = height;
 
-  SDL_Log("original width: %d", width);
-  SDL_Log("original height: %d", height);
+  KRR_LOGD("original width: %d", width);
+  KRR_LOGD("original height: %d", height);
 
   // if need to resize, then put original pixels data at the top left
   // and pad the less with fully transparent white color
@@ -929,13 +970,13 @@ bool gl_LTexture_load_pixels_from_file8(gl_LTexture* texture, const char* path)
     return false;
   }
   
-  SDL_Log("format loaded surface: %s", SDL_GetPixelFormatName(loaded_surface->format->format));
+  KRR_LOGD("format loaded surface: %s", SDL_GetPixelFormatName(loaded_surface->format->format));
 
   // check if the pixel format is not already in our interested format of BGR888
   Uint32 image_pixel_format = loaded_surface->format->format;
   if (image_pixel_format != SDL_PIXELFORMAT_BGR888)
   {
-    SDL_Log("Need to convert to proper pixel format");
+    KRR_LOGD("Need to convert to proper pixel format");
 
     // convert to more convenient format to work with
     SDL_Surface* converted_surface = SDL_ConvertSurfaceFormat(loaded_surface, SDL_PIXELFORMAT_BGR888, 0);
@@ -945,7 +986,7 @@ bool gl_LTexture_load_pixels_from_file8(gl_LTexture* texture, const char* path)
       return false;
     }
 
-    SDL_Log("converted format surface: %s", SDL_GetPixelFormatName(converted_surface->format->format));
+    KRR_LOGD("converted format surface: %s", SDL_GetPixelFormatName(converted_surface->format->format));
 
     // free firstly loaded surface
     SDL_FreeSurface(loaded_surface);
@@ -964,7 +1005,7 @@ bool gl_LTexture_load_pixels_from_file8(gl_LTexture* texture, const char* path)
   {
     // find next POT for width
     texture->physical_width_ = find_next_pot(width);
-    SDL_Log("physical_width: %u", texture->physical_width_);
+    KRR_LOGD("physical_width: %u", texture->physical_width_);
     is_need_to_resize = true;
   }
   // otherwise width is the same as original input texture
@@ -978,7 +1019,7 @@ bool gl_LTexture_load_pixels_from_file8(gl_LTexture* texture, const char* path)
   {
     // find next POT for height
     texture->physical_height_ = find_next_pot(height);
-    SDL_Log("physical_height: %u", texture->physical_height_);
+    KRR_LOGD("physical_height: %u", texture->physical_height_);
     is_need_to_resize = true;
   }
   // otherwise height is the same as original input texture
@@ -992,8 +1033,8 @@ bool gl_LTexture_load_pixels_from_file8(gl_LTexture* texture, const char* path)
   texture->width = width;
   texture->height = height;
 
-  SDL_Log("original width: %d", width);
-  SDL_Log("original height: %d", height);
+  KRR_LOGD("original width: %d", width);
+  KRR_LOGD("original height: %d", height);
 
   // if need to resize, then put original pixels data at the top left
   // and pad the less with fully transparent white color
@@ -1087,14 +1128,10 @@ bool gl_LTexture_load_texture_from_precreated_pixels32(gl_LTexture* texture)
     // bind texture id
     glBindTexture(GL_TEXTURE_2D, texture->texture_id);
 
-    // set texture parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, DEFAULT_TEXTURE_WRAP);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, DEFAULT_TEXTURE_WRAP);
-
     // there's no mipmap for this single texture
+    // filtering, and wrapping are in sampler
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    use_sampler_(texture, GL_LINEAR);
     
     // generate texture
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, texture->physical_width_, texture->physical_height_, 0, GL_RGBA, GL_UNSIGNED_BYTE, texture->pixels);
@@ -1103,7 +1140,7 @@ bool gl_LTexture_load_texture_from_precreated_pixels32(gl_LTexture* texture)
     glBindTexture(GL_TEXTURE_2D, 0);
 
     // check for errors
-    GLenum error = glGetError();
+    GLenum error = GL_LDEBUG_GET_ERROR();
     if (error != GL_NO_ERROR)
     {
       krr_util_print_callstack();
@@ -1116,12 +1153,12 @@ bool gl_LTexture_load_texture_from_precreated_pixels32(gl_LTexture* texture)
       free(texture->pixels);
       texture->pixels = NULL;
 
-      // init VBO and IBO
-      init_VBO_IBO(texture);
-
       // set pixel format
       texture->pixel_format = GL_RGBA;
 
+      // register with texture manager
+      gl_ltexture_manager_on_upload(texture, texture->physical_width_ * texture->physical_height_ * sizeof(GLuint));
+
       return true;
     }
   }
@@ -1153,14 +1190,10 @@ bool gl_LTexture_load_texture_from_precreated_pixels8(gl_LTexture* texture)
     // bind texture id
     glBindTexture(GL_TEXTURE_2D, texture->texture_id);
 
-    // set texture parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, DEFAULT_TEXTURE_WRAP);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, DEFAULT_TEXTURE_WRAP);
-
     // there's no mipmap for this single texture
+    // filtering, and wrapping are in sampler
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    use_sampler_(texture, GL_LINEAR);
     
     // generate texture
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, texture->physical_width_, texture->physical_height_, 0, GL_RED, GL_UNSIGNED_BYTE, texture->pixels8);
@@ -1169,7 +1202,7 @@ bool gl_LTexture_load_texture_from_precreated_pixels8(gl_LTexture* texture)
     glBindTexture(GL_TEXTURE_2D, 0);
 
     // check for errors
-    GLenum error = glGetError();
+    GLenum error = GL_LDEBUG_GET_ERROR();
     if (error != GL_NO_ERROR)
     {
       krr_util_print_callstack();
@@ -1182,12 +1215,12 @@ bool gl_LTexture_load_texture_from_precreated_pixels8(gl_LTexture* texture)
       free(texture->pixels);
       texture->pixels = NULL;
 
-      // init VBO and IBO
-      init_VBO_IBO(texture);
-
       // set pixel format
       texture->pixel_format = GL_RED;
 
+      // register with texture manager
+      gl_ltexture_manager_on_upload(texture, texture->physical_width_ * texture->physical_height_ * sizeof(GLubyte));
+
       return true;
     }
   }
@@ -1207,44 +1240,107 @@ bool gl_LTexture_load_texture_from_precreated_pixels8(gl_LTexture* texture)
   return false;
 }
 
-void init_VBO_IBO(gl_LTexture* texture)
+bool gl_LTexture_load_texture_from_memory(gl_LTexture* texture, const void* pixels, GLenum pixel_format, int width, int height, int physical_width, int physical_height, int mip_count)
 {
-  // if texture is loaded and VBO doesn't already exist
-  if (texture->texture_id != 0 && texture->VBO_id == 0)
-  {
-    // vertex data
-    LVertexData2D vertex_data[4];
-    GLuint index_data[4];
-
-    // set rendering indices
-    index_data[0] = 0;
-    index_data[1] = 1;
-    index_data[2] = 2;
-    index_data[3] = 3;
-
-    // create VBO
-    glGenBuffers(1, &texture->VBO_id);
-    glBindBuffer(GL_ARRAY_BUFFER, texture->VBO_id);
-    glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(LVertexData2D), vertex_data, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    // create IBO
-    glGenBuffers(1, &texture->IBO_id);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, texture->IBO_id);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, 4 * sizeof(GLuint), index_data, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  // free existing texture first if it exists
+  gl_LTexture_free_internal_texture(texture);
+
+  const int bytes_per_pixel = pixel_format == GL_RED ? 1 : 4;
+
+  // generate texture id
+  glGenTextures(1, &texture->texture_id);
+
+  // bind texture id
+  glBindTexture(GL_TEXTURE_2D, texture->texture_id);
+
+  // set texture parameters
+  // filtering, and wrapping are in sampler
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mip_count - 1);
+  use_sampler_(texture, mip_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+  // rows of 8-bit pixels at small mipmap levels are not 4-byte aligned
+  if (bytes_per_pixel == 1)
+  {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  }
+
+  // upload all levels straight from input memory
+  const GLubyte* level_pixels = pixels;
+  int level_width = physical_width;
+  int level_height = physical_height;
+  size_t total_bytes = 0;
+  for (int level=0; level<mip_count; level++)
+  {
+    glTexImage2D(GL_TEXTURE_2D, level, pixel_format == GL_RED ? GL_RED : GL_RGBA8, level_width, level_height, 0, pixel_format, GL_UNSIGNED_BYTE, level_pixels);
+
+    size_t level_bytes = (size_t)level_width * level_height * bytes_per_pixel;
+    level_pixels += level_bytes;
+    total_bytes += level_bytes;
+
+    level_width = krr_math_max(1, level_width / 2);
+    level_height = krr_math_max(1, level_height / 2);
+  }
+
+  if (bytes_per_pixel == 1)
+  {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  }
+
+  // unbind texture
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  // check for errors
+  GLenum error = GL_LDEBUG_GET_ERROR();
+  if (error != GL_NO_ERROR)
+  {
+    krr_util_print_callstack();
+    SDL_Log("Error loading texture from memory [%p]: %s", pixels, gl_util_error_string(error));
+    glDeleteTextures(1, &texture->texture_id);
+    texture->texture_id = 0;
+    return false;
   }
+
+  texture->width = width;
+  texture->height = height;
+  texture->physical_width_ = physical_width;
+  texture->physical_height_ = physical_height;
+  texture->pixel_format = pixel_format;
+
+  // register with texture manager
+  gl_ltexture_manager_on_upload(texture, total_bytes);
+
+  return true;
 }
 
-void free_VBO_IBO(gl_LTexture* texture)
+void init_shared_quad_()
 {
-  if (texture->VBO_id != 0 && texture->IBO_id != 0)
+  if (shared_quad_VBO_id_ != 0)
   {
-    glDeleteBuffers(1, &texture->VBO_id);
-    glDeleteBuffers(1, &texture->IBO_id);
+    return;
+  }
+
+  // unit quad, scaled to texture size by modelview matrix
+  LVertexData2D vertex_data[4] = {
+    { {0.f, 0.f}, {0.f, 0.f} },
+    { {1.f, 0.f}, {1.f, 0.f} },
+    { {1.f, 1.f}, {1.f, 1.f} },
+    { {0.f, 1.f}, {0.f, 1.f} }
+  };
+  gl_lvertex_format_pack(SHARED_QUAD_FORMAT, vertex_data, 4, vertex_data);
 
-    texture->VBO_id = 0;
-    texture->IBO_id = 0;
+  // create VBO
+  glGenBuffers(1, &shared_quad_VBO_id_);
+  glBindBuffer(GL_ARRAY_BUFFER, shared_quad_VBO_id_);
+  glBufferData(GL_ARRAY_BUFFER, 4 * gl_lvertex_format_stride(SHARED_QUAD_FORMAT), vertex_data, GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void gl_LTexture_free_shared_quad()
+{
+  if (shared_quad_VBO_id_ != 0)
+  {
+    glDeleteBuffers(1, &shared_quad_VBO_id_);
+    shared_quad_VBO_id_ = 0;
   }
 }
 
@@ -1317,7 +1413,7 @@ void gl_LTexture_pad_pixels32(gl_LTexture* texture)
     {
       // find next POT for width
       texture->physical_width_ = find_next_pot(width);
-      SDL_Log("physical_width: %u", texture->physical_width_);
+      KRR_LOGD("physical_width: %u", texture->physical_width_);
       is_need_to_resize = true;
     }
 
@@ -1326,7 +1422,7 @@ void gl_LTexture_pad_pixels32(gl_LTexture* texture)
     {
       // find next POT for height
       texture->physical_height_ = find_next_pot(height);
-      SDL_Log("physical_height: %u", texture->physical_height_);
+      KRR_LOGD("physical_height: %u", texture->physical_height_);
       is_need_to_resize = true;
     }
 
@@ -1440,7 +1536,7 @@ void gl_LTexture_pad_pixels8(gl_LTexture* texture)
     {
       // find next POT for width
       texture->physical_width_ = find_next_pot(width);
-      SDL_Log("physical_width: %u", texture->physical_width_);
+      KRR_LOGD("physical_width: %u", texture->physical_width_);
       is_need_to_resize = true;
     }
 
@@ -1449,7 +1545,7 @@ void gl_LTexture_pad_pixels8(gl_LTexture* texture)
     {
       // find next POT for height
       texture->physical_height_ = find_next_pot(height);
-      SDL_Log("physical_height: %u", texture->physical_height_);
+      KRR_LOGD("physical_height: %u", texture->physical_height_);
       is_need_to_resize = true;
     }
 
@@ -30,6 +30,12 @@ typedef struct
   // pixel format
   GLuint pixel_format;
 
+  /// (read-only)
+  /// sampler object to filter, and wrap this texture with, bound along with texture at draw time (see gl_lsampler_cache)
+  /// each load picks default one (linear filtering, repeat wrapping) for what's loaded unless it's set
+  /// via gl_LTexture_set_sampler(). Texture sets no filtering, nor wrapping of its own.
+  GLuint sampler;
+
   /// (read-only)
   /// real physical texture width in memory
   /// note: if texture is not POT then value will be different from 'width' as it will be in POT
@@ -44,11 +50,13 @@ typedef struct
   /// case of NPOT texture
   int physical_height_;
 
-  // VBO
-  GLuint VBO_id;
+  /// (internal use)
+  /// handle of this texture in shared_texture_manager, -1 if not registered
+  int manager_handle_;
 
-  // IBO
-  GLuint IBO_id;
+  /// (internal use)
+  /// whether sampler is set via gl_LTexture_set_sampler(), then loading keeps it
+  bool sampler_overridden_;
 } gl_LTexture;
 
 ///
@@ -109,8 +117,19 @@ extern bool gl_LTexture_load_dds_texture_from_file(gl_LTexture* texture, const c
 ///
 extern bool gl_LTexture_load_texture_from_pixels32(gl_LTexture* texture, GLuint* pixels, GLuint width, GLuint height);
 
+///
+/// Set sampler to filter, and wrap texture with. No GL call is needed.
+/// It's kept across later loads, instead of default one picked by each load.
+///
+/// \param texture gl_LTexture to set sampler to
+/// \param sampler Sampler from gl_lsampler_cache_get(), not 0 as texture has no filtering of its own
+///
+extern void gl_LTexture_set_sampler(gl_LTexture* texture, GLuint sampler);
+
 ///
 /// Render texture.
+/// All textures share a single unit quad, it's transformed via modelview matrix, and
+/// its texture coordinates are mapped via texcoord clip of shared_textured_shaderprogram.
 ///
 /// \param texture gl_LTexture to render
 /// \param x Position x to render
@@ -119,6 +138,12 @@ extern bool gl_LTexture_load_texture_from_pixels32(gl_LTexture* texture, GLuint*
 ///
 extern void gl_LTexture_render(gl_LTexture* texture, GLfloat x, GLfloat y, const LRect* clip);
 
+///
+/// Free shared quad geometry used to render all textures.
+/// It's created on first render. Call this once before destroying OpenGL context.
+///
+extern void gl_LTexture_free_shared_quad();
+
 ///
 /// Lock texture to manipulate pixel data.
 /// Make sure your texture is in RGBA8 format. If it is not, then this will change your
@@ -54,4 +54,20 @@ extern bool gl_LTexture_load_texture_from_precreated_pixels32(gl_LTexture* textu
 ///
 extern bool gl_LTexture_load_texture_from_precreated_pixels8(gl_LTexture* texture);
 
+///
+/// Load texture directly from pixels in memory which are already in upload format i.e. memory-mapped asset pack.
+/// Pixels are not copied, nor padded. All mipmap levels are stored consecutively starting from level 0.
+///
+/// \param texture Pointer to gl_LTexture
+/// \param pixels Pointer to pixels of all mipmap levels
+/// \param pixel_format GL_RGBA for 32-bit RGBA, or GL_RED for 8-bit grayscale
+/// \param width Image width
+/// \param height Image height
+/// \param physical_width Width of pixels at level 0, it should be power-of-two
+/// \param physical_height Height of pixels at level 0, it should be power-of-two
+/// \param mip_count Number of mipmap levels, at least 1
+/// \return True if successfully load, otherwise return false.
+///
+extern bool gl_LTexture_load_texture_from_memory(gl_LTexture* texture, const void* pixels, GLenum pixel_format, int width, int height, int physical_width, int physical_height, int mip_count);
+
 #endif
@@ -1,6 +1,10 @@
 #include "gl_LTexture_spritesheet.h"
 #include "gl_ltextured_polygon_program2d.h"
 #include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "gl/gl_ltexture_manager_internals.h"
+#include "gl/gl_lsampler_cache.h"
+#include "gl/gl_lvertex_format.h"
 #include <stdlib.h>
 #include <stdlib.h>
 #include <stddef.h>
@@ -13,8 +17,8 @@ void init_defaults(gl_LSpritesheet* spritesheet)
 {
   spritesheet->ltexture = NULL;
   spritesheet->clips = NULL;
+  spritesheet->vertex_format = LVERTEX_FORMAT_COMPACT_SHORT;
   spritesheet->vertex_data_buffer = 0;
-  spritesheet->index_buffers = NULL;
 }
 
 void free_internals(gl_LSpritesheet* spritesheet)
@@ -80,15 +84,12 @@ bool gl_LSpritesheet_generate_databuffer(gl_LSpritesheet* spritesheet)
     // allocate vertex buffer data
     const int total_sprites = spritesheet->clips->len;
 
+    // sprites are drawn from shared quad index buffer, so there's no index buffer of its own
     // yep we can use variable length array declaration in C99
     LVertexData2D vertex_data[total_sprites * 4];
-    // allocate buffer for index buffer
-    spritesheet->index_buffers = malloc(total_sprites * 4 * sizeof(GLuint));
 
     // allocate vertex data buffer name
     glGenBuffers(1, &spritesheet->vertex_data_buffer);
-    // allocate index buffer 
-    glGenBuffers(total_sprites, spritesheet->index_buffers);
 
     // go through clips
     GLfloat texture_pwidth = spritesheet->ltexture->physical_width_;
@@ -141,24 +142,15 @@ bool gl_LSpritesheet_generate_databuffer(gl_LSpritesheet* spritesheet)
 
       vertex_data[sprite_indices[3]].texcoord.s = tex_left;
       vertex_data[sprite_indices[3]].texcoord.t = tex_bottom;
-
-      // bind sprite index buffer data
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, spritesheet->index_buffers[i]);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER, 4 * sizeof(GLuint), sprite_indices, GL_STATIC_DRAW);
-
-			GLenum error = glGetError();
-			if (error != GL_NO_ERROR)
-			{
-				SDL_Log("Error opengl: %s", gl_util_error_string(error));
-				return false;
-			}
     }
 
-    // bind vertex data
+    // pack in place into selected layout, then upload
+    gl_lvertex_format_pack(spritesheet->vertex_format, vertex_data, total_sprites * 4, vertex_data);
     glBindBuffer(GL_ARRAY_BUFFER, spritesheet->vertex_data_buffer);
-    glBufferData(GL_ARRAY_BUFFER, total_sprites * 4 * sizeof(LVertexData2D), vertex_data, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, total_sprites * 4 * gl_lvertex_format_stride(spritesheet->vertex_format), vertex_data, GL_STATIC_DRAW);
 
-		GLenum error = glGetError();
+		// errors are sticky, single check covers buffers of all sprites
+		GLenum error = GL_LDEBUG_GET_ERROR();
 		if (error != GL_NO_ERROR)
 		{
 			SDL_Log("Error opengl: %s", gl_util_error_string(error));
@@ -192,15 +184,6 @@ void gl_LSpritesheet_free_sheet(gl_LSpritesheet* spritesheet)
     spritesheet->vertex_data_buffer = 0;
   }
 
-  // clear index buffer
-  if (spritesheet->index_buffers != NULL)
-  {
-    glDeleteBuffers(spritesheet->clips->len, spritesheet->index_buffers);
-    // since we dynamically allocate for index buffers, we free them here
-    free(spritesheet->index_buffers);
-    spritesheet->index_buffers = NULL;
-  }
-
   // clear clips
   vector_clear(spritesheet->clips);
 }
@@ -216,9 +199,15 @@ void gl_LSpritesheet_render_sprite(gl_LSpritesheet* spritesheet, int index, GLfl
   glm_translate(shared_textured_shaderprogram->modelview_matrix, (vec3){x, y, 0.f});
   // issue update to gpu
   gl_ltextured_polygon_program2d_update_modelview_matrix(shared_textured_shaderprogram);
+  // sprite's vertex data has final texture coordinates
+  gl_ltextured_polygon_program2d_reset_texcoord_clip(shared_textured_shaderprogram);
+
+  // mark as used, reload if it was evicted
+  gl_ltexture_manager_touch(spritesheet->ltexture);
 
   // set texture
   glBindTexture(GL_TEXTURE_2D, spritesheet->ltexture->texture_id);
+  gl_lsampler_cache_bind(0, spritesheet->ltexture->sampler);
 
   // enable all attribute pointers
   // use shared global variable of shader for gl_LTexture here
@@ -227,15 +216,11 @@ void gl_LSpritesheet_render_sprite(gl_LSpritesheet* spritesheet, int index, GLfl
   // bind vertex data
   glBindBuffer(GL_ARRAY_BUFFER, spritesheet->vertex_data_buffer);
 
-  // set texture coordinate attrib pointer
-  gl_ltextured_polygon_program2d_set_vertex_pointer(shared_textured_shaderprogram, sizeof(LVertexData2D), (GLvoid*)offsetof(LVertexData2D, texcoord));
-  // set vertex data attrib pointer
-  gl_ltextured_polygon_program2d_set_texcoord_pointer(shared_textured_shaderprogram, sizeof(LVertexData2D), (GLvoid*)offsetof(LVertexData2D, position));
+  // set vertex, and texture coordinate attrib pointer for sheet's layout
+  gl_ltextured_polygon_program2d_set_attrib_pointers(shared_textured_shaderprogram, spritesheet->vertex_format, NULL);
 
-  // bind index buffer
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, spritesheet->index_buffers[index]);
-  // draw using data from vertex and index buffer
-  glDrawElements(GL_TRIANGLE_FAN, 4, GL_UNSIGNED_INT, NULL);
+  // draw sprite's quad using shared index buffer
+  gl_lvertex_format_draw_quads(index, 1);
 
   // disable all attribute pointers
   gl_ltextured_polygon_program2d_disable_attrib_pointers(shared_textured_shaderprogram);
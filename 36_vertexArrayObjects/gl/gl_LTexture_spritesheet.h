@@ -10,11 +10,13 @@ typedef struct
 {
   gl_LTexture* ltexture;
   vector* clips;
+
+  /// vertex layout of generated data buffer, set before gl_LSpritesheet_generate_databuffer().
+  /// LVERTEX_FORMAT_COMPACT_SHORT by default which rounds clip sizes to whole pixels.
+  LVertexFormat2D vertex_format;
   
   /// (internal use)
   GLuint vertex_data_buffer;
-  /// (internal use)
-  GLuint* index_buffers;
 } gl_LSpritesheet;
 
 ///
@@ -61,7 +63,7 @@ extern LRect gl_LSpritesheet_get_clip(gl_LSpritesheet* spritesheet, int index);
 extern bool gl_LSpritesheet_generate_databuffer(gl_LSpritesheet* spritesheet);
 
 ///
-/// Free VBO, IBO and all clipping array that used in rendering by the sheet.
+/// Free VBO and all clipping array that used in rendering by the sheet.
 ///
 /// \param spriteshet Pointer to gl_LSpritesheet
 ///
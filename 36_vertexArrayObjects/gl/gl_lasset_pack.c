@@ -0,0 +1,200 @@
+#include "gl_lasset_pack.h"
+#include "gl/gl_LTexture_internals.h"
+#include "gl/gl_LShaderProgram.h"
+#include "foundation/krr_hash.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void init_defaults_(gl_lasset_pack* pack);
+static const krr_assetpack_entry* find_typed_(gl_lasset_pack* pack, const char* name, uint32_t type);
+
+void init_defaults_(gl_lasset_pack* pack)
+{
+  pack->map_.data = NULL;
+  pack->map_.size = 0;
+  pack->map_.mapped_ = false;
+  pack->entries_ = NULL;
+  pack->entry_count_ = 0;
+}
+
+gl_lasset_pack* gl_lasset_pack_new()
+{
+  gl_lasset_pack* out = malloc(sizeof(gl_lasset_pack));
+  init_defaults_(out);
+  return out;
+}
+
+void gl_lasset_pack_free(gl_lasset_pack* pack)
+{
+  if (pack != NULL)
+  {
+    krr_filemap_close(&pack->map_);
+    pack->entries_ = NULL;
+    pack->entry_count_ = 0;
+
+    free(pack);
+    pack = NULL;
+  }
+}
+
+bool gl_lasset_pack_open(gl_lasset_pack* pack, const char* path)
+{
+  krr_filemap_close(&pack->map_);
+  pack->entries_ = NULL;
+  pack->entry_count_ = 0;
+
+  if (!krr_filemap_open(&pack->map_, path))
+  {
+    return false;
+  }
+
+  // validate header
+  const krr_assetpack_header* header = pack->map_.data;
+  if (pack->map_.size < sizeof(krr_assetpack_header) ||
+      strncmp(header->magic, KRR_ASSETPACK_MAGIC, sizeof(header->magic)) != 0)
+  {
+    SDL_Log("%s is not an asset pack", path);
+    krr_filemap_close(&pack->map_);
+    return false;
+  }
+  if (header->version != KRR_ASSETPACK_VERSION)
+  {
+    SDL_Log("Asset pack %s has version %u, expected %u", path, header->version, KRR_ASSETPACK_VERSION);
+    krr_filemap_close(&pack->map_);
+    return false;
+  }
+  if (pack->map_.size < sizeof(krr_assetpack_header) + header->entry_count * sizeof(krr_assetpack_entry))
+  {
+    SDL_Log("Asset pack %s is truncated", path);
+    krr_filemap_close(&pack->map_);
+    return false;
+  }
+
+  // entries immediately follow header, no parsing needed
+  pack->entries_ = (const krr_assetpack_entry*)(header + 1);
+  pack->entry_count_ = header->entry_count;
+
+  return true;
+}
+
+const krr_assetpack_entry* gl_lasset_pack_find(gl_lasset_pack* pack, const char* name)
+{
+  uint64_t hash = krr_hash_string(name);
+
+  // entries are sorted by name hash, find the first one with such hash
+  int low = 0;
+  int high = pack->entry_count_;
+  while (low < high)
+  {
+    int mid = low + (high - low) / 2;
+    if (pack->entries_[mid].name_hash < hash)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  // confirm with name as hash might collide
+  for (int i=low; i<pack->entry_count_ && pack->entries_[i].name_hash == hash; i++)
+  {
+    if (strncmp(pack->entries_[i].name, name, KRR_ASSETPACK_MAX_NAME) == 0)
+    {
+      return &pack->entries_[i];
+    }
+  }
+
+  return NULL;
+}
+
+const void* gl_lasset_pack_data(gl_lasset_pack* pack, const krr_assetpack_entry* entry)
+{
+  return (const unsigned char*)pack->map_.data + entry->offset;
+}
+
+const krr_assetpack_entry* find_typed_(gl_lasset_pack* pack, const char* name, uint32_t type)
+{
+  const krr_assetpack_entry* entry = gl_lasset_pack_find(pack, name);
+  if (entry == NULL)
+  {
+    SDL_Log("Asset %s not found in pack", name);
+    return NULL;
+  }
+  if (entry->type != type)
+  {
+    SDL_Log("Asset %s has type %u, expected %u", name, entry->type, type);
+    return NULL;
+  }
+  // written not to overflow with bogus offset, or size
+  if (entry->offset > pack->map_.size || entry->size > pack->map_.size - entry->offset)
+  {
+    SDL_Log("Asset %s lies outside of pack", name);
+    return NULL;
+  }
+  return entry;
+}
+
+bool gl_lasset_pack_load_texture(gl_lasset_pack* pack, const char* name, gl_LTexture* texture)
+{
+  const krr_assetpack_entry* entry = find_typed_(pack, name, KRR_ASSETPACK_TYPE_TEXTURE);
+  if (entry == NULL)
+  {
+    return false;
+  }
+
+  if (entry->mip_count < 1 || entry->mip_count > 32 || entry->width == 0 || entry->height == 0 ||
+      entry->physical_width < entry->width || entry->physical_height < entry->height)
+  {
+    SDL_Log("Texture %s has invalid dimensions, or mipmap count", name);
+    return false;
+  }
+
+  // payload must hold all mipmap levels to be uploaded straight from it
+  const int bytes_per_pixel = entry->pixel_format == KRR_ASSETPACK_PIXEL_R8 ? 1 : 4;
+  uint64_t expected_size = 0;
+  uint64_t level_width = entry->physical_width;
+  uint64_t level_height = entry->physical_height;
+  for (uint32_t level=0; level<entry->mip_count; level++)
+  {
+    expected_size += level_width * level_height * bytes_per_pixel;
+    level_width = level_width > 1 ? level_width / 2 : 1;
+    level_height = level_height > 1 ? level_height / 2 : 1;
+  }
+  if (entry->size < expected_size)
+  {
+    SDL_Log("Texture %s has %llu bytes, less than %llu bytes of its levels", name, (unsigned long long)entry->size, (unsigned long long)expected_size);
+    return false;
+  }
+
+  GLenum pixel_format = entry->pixel_format == KRR_ASSETPACK_PIXEL_R8 ? GL_RED : GL_RGBA;
+  return gl_LTexture_load_texture_from_memory(texture, gl_lasset_pack_data(pack, entry), pixel_format, entry->width, entry->height, entry->physical_width, entry->physical_height, entry->mip_count);
+}
+
+GLuint gl_lasset_pack_load_shader(gl_lasset_pack* pack, const char* name, GLenum shader_type)
+{
+  const krr_assetpack_entry* entry = find_typed_(pack, name, KRR_ASSETPACK_TYPE_SHADER);
+  if (entry == NULL)
+  {
+    return 0;
+  }
+
+  // source is stored null-terminated, don't trust it blindly
+  const char* source = gl_lasset_pack_data(pack, entry);
+  if (entry->size == 0 || source[entry->size - 1] != '\0')
+  {
+    SDL_Log("Shader %s is not null-terminated", name);
+    return 0;
+  }
+
+  return gl_LShaderProgram_load_shader_from_source(source, shader_type);
+}
+
+bool gl_lasset_pack_load_font(gl_lasset_pack* pack, const char* name, gl_LFont* font, GLuint pixel_size)
+{
+  const krr_assetpack_entry* entry = find_typed_(pack, name, KRR_ASSETPACK_TYPE_FONT);
+  if (entry == NULL)
+  {
+    return false;
+  }
+
+  return gl_LFont_load_freetype_from_memory(font, gl_lasset_pack_data(pack, entry), entry->size, pixel_size);
+}
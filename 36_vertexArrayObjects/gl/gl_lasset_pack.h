@@ -0,0 +1,100 @@
+#ifndef gl_lasset_pack_h_
+#define gl_lasset_pack_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LTexture.h"
+#include "gl/gl_LFont.h"
+#include "foundation/krr_filemap.h"
+#include "foundation/krr_assetpack_format.h"
+#include <stddef.h>
+#include <stdbool.h>
+
+/// Asset pack loader.
+/// Pack file (built by tools/assetpack) is memory-mapped once. Assets are uploaded, or compiled directly
+/// from mapped memory without any intermediate copy, decoding, nor conversion.
+
+typedef struct
+{
+  /// (internal use) mapped pack file
+  krr_filemap map_;
+  /// (internal use) pointer to entries inside mapped file
+  const krr_assetpack_entry* entries_;
+  /// (internal use) number of entries
+  int entry_count_;
+} gl_lasset_pack;
+
+///
+/// Create a new asset pack.
+///
+/// \return Newly created gl_lasset_pack on heap.
+///
+extern gl_lasset_pack* gl_lasset_pack_new();
+
+///
+/// Free asset pack.
+/// Data pointers returned from it are no longer valid after this call, but loaded textures, shaders, and fonts are.
+///
+/// \param pack Pointer to gl_lasset_pack
+///
+extern void gl_lasset_pack_free(gl_lasset_pack* pack);
+
+///
+/// Open pack file, and validate its header.
+///
+/// \param pack Pointer to gl_lasset_pack
+/// \param path Path to pack file
+/// \return True if successfully open, otherwise return false.
+///
+extern bool gl_lasset_pack_open(gl_lasset_pack* pack, const char* path);
+
+///
+/// Find entry by name.
+///
+/// \param pack Pointer to gl_lasset_pack
+/// \param name Asset name as packed
+/// \return Pointer to entry, or NULL if not found.
+///
+extern const krr_assetpack_entry* gl_lasset_pack_find(gl_lasset_pack* pack, const char* name);
+
+///
+/// Get pointer to entry's data inside mapped pack.
+///
+/// \param pack Pointer to gl_lasset_pack
+/// \param entry Entry returned from gl_lasset_pack_find()
+/// \return Pointer to read-only data.
+///
+extern const void* gl_lasset_pack_data(gl_lasset_pack* pack, const krr_assetpack_entry* entry);
+
+///
+/// Load texture from pack.
+///
+/// \param pack Pointer to gl_lasset_pack
+/// \param name Asset name
+/// \param texture Pointer to gl_LTexture to load into
+/// \return True if successfully load, otherwise return false.
+///
+extern bool gl_lasset_pack_load_texture(gl_lasset_pack* pack, const char* name, gl_LTexture* texture);
+
+///
+/// Compile shader from pack.
+/// Its source is stored with includes already resolved by the packer.
+///
+/// \param pack Pointer to gl_lasset_pack
+/// \param name Asset name
+/// \param shader_type Type of shader
+/// \return Id of compiled shader, or 0 if failed.
+///
+extern GLuint gl_lasset_pack_load_shader(gl_lasset_pack* pack, const char* name, GLenum shader_type);
+
+///
+/// Load FreeType font from pack.
+///
+/// \param pack Pointer to gl_lasset_pack
+/// \param name Asset name
+/// \param font Pointer to gl_LFont to load into
+/// \param pixel_size Pixel size of font
+/// \return True if successfully load, otherwise return false.
+///
+extern bool gl_lasset_pack_load_font(gl_lasset_pack* pack, const char* name, gl_LFont* font, GLuint pixel_size);
+
+#endif
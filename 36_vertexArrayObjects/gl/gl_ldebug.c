@@ -0,0 +1,97 @@
+#include "gl_ldebug.h"
+
+static unsigned int message_count_ = 0;
+
+#ifndef NDEBUG
+static const char* source_string_(GLenum source);
+static const char* type_string_(GLenum type);
+static const char* severity_string_(GLenum severity);
+static void APIENTRY on_message_(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* user_param);
+
+const char* source_string_(GLenum source)
+{
+  switch (source)
+  {
+    case GL_DEBUG_SOURCE_API: return "api";
+    case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+    case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+    case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+    case GL_DEBUG_SOURCE_APPLICATION: return "application";
+    default: return "other";
+  }
+}
+
+const char* type_string_(GLenum type)
+{
+  switch (type)
+  {
+    case GL_DEBUG_TYPE_ERROR: return "error";
+    case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated";
+    case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+    case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+    case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+    default: return "other";
+  }
+}
+
+const char* severity_string_(GLenum severity)
+{
+  switch (severity)
+  {
+    case GL_DEBUG_SEVERITY_HIGH: return "high";
+    case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+    case GL_DEBUG_SEVERITY_LOW: return "low";
+    default: return "notification";
+  }
+}
+
+void APIENTRY on_message_(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* user_param)
+{
+  message_count_++;
+
+  if (type == GL_DEBUG_TYPE_ERROR || severity == GL_DEBUG_SEVERITY_HIGH)
+  {
+    KRR_LOGE("[GL %s, %s, %s] %u: %s", source_string_(source), type_string_(type), severity_string_(severity), id, message);
+  }
+  else
+  {
+    KRR_LOGW("[GL %s, %s, %s] %u: %s", source_string_(source), type_string_(type), severity_string_(severity), id, message);
+  }
+}
+#endif
+
+bool gl_ldebug_init()
+{
+#ifndef NDEBUG
+  if (!(GLEW_VERSION_4_3 || GLEW_KHR_debug))
+  {
+    KRR_LOGW("GL_KHR_debug is not supported, no debug messages");
+    return false;
+  }
+
+  GLint flags = 0;
+  glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+  if ((flags & GL_CONTEXT_FLAG_DEBUG_BIT) == 0)
+  {
+    KRR_LOGW("Not a debug context, driver might not report debug messages");
+  }
+
+  // report on the call causing it, so callstack points at it
+  glEnable(GL_DEBUG_OUTPUT);
+  glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+  glDebugMessageCallback(on_message_, NULL);
+
+  // notifications i.e. buffer placement are just noise
+  glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
+
+  KRR_LOGI("GL_KHR_debug callback installed");
+  return true;
+#else
+  return false;
+#endif
+}
+
+unsigned int gl_ldebug_message_count()
+{
+  return message_count_;
+}
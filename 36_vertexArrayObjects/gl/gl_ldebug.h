@@ -0,0 +1,46 @@
+#ifndef gl_ldebug_h_
+#define gl_ldebug_h_
+
+#include "gl/glLOpenGL.h"
+#include "foundation/common_debug.h"
+#include <stdbool.h>
+
+/// OpenGL diagnostics for debug builds, compiled out of release builds (-DNDEBUG).
+///
+/// glGetError() may stall the pipeline waiting for driver, so it's only called in debug builds.
+/// Code checks for errors as usual
+///
+///   GLenum error = GL_LDEBUG_GET_ERROR();
+///   if (error != GL_NO_ERROR)
+///   {
+///     ...
+///   }
+///
+/// which in release build is a constant GL_NO_ERROR so the whole check is removed by compiler.
+///
+/// In debug build, driver messages are reported via GL_KHR_debug callback as they happen if
+/// debug context is available, so each error is reported with the driver's own description.
+
+#ifndef NDEBUG
+  #define GL_LDEBUG_GET_ERROR() glGetError()
+#else
+  #define GL_LDEBUG_GET_ERROR() GL_NO_ERROR
+#endif
+
+///
+/// Install GL_KHR_debug message callback.
+/// It has no effect in release build, or if context doesn't support GL_KHR_debug.
+/// Call it once after glew is initialized. Context should be created with SDL_GL_CONTEXT_DEBUG_FLAG.
+///
+/// \return True if callback is installed, otherwise return false.
+///
+extern bool gl_ldebug_init();
+
+///
+/// Get number of messages reported via callback so far.
+///
+/// \return Number of messages
+///
+extern unsigned int gl_ldebug_message_count();
+
+#endif
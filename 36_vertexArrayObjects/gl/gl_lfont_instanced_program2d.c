@@ -0,0 +1,98 @@
+#include "gl_lfont_instanced_program2d.h"
+#include "gl/gl_LShaderProgram.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+
+static void query_locations_(void* user_data);
+static void free_internals_(gl_lfont_instanced_program2d* program);
+static bool load_program_from_files_(gl_lfont_instanced_program2d* program, const char* vertex_shader_path, const char* fragment_shader_path);
+
+void free_internals_(gl_lfont_instanced_program2d* program)
+{
+  // reset all locations
+  program->modelview_matrix_location = -1;
+  program->texture_sampler_location = -1;
+
+  // set matrix to identity
+  glm_mat4_identity(program->modelview_matrix);
+
+  // free underlying shader program
+  gl_LShaderProgram_free(program->program);
+  program->program = NULL;
+}
+
+gl_lfont_instanced_program2d* gl_lfont_instanced_program2d_new()
+{
+  gl_lfont_instanced_program2d* out = malloc(sizeof(gl_lfont_instanced_program2d));
+
+  // init defaults first
+  out->program = NULL;
+  out->modelview_matrix_location = -1;
+  out->texture_sampler_location = -1;
+  glm_mat4_identity(out->modelview_matrix);
+
+  // create underlying shader program
+  // we will take care of this automatically when freeing
+  gl_LShaderProgram* shader_program = gl_LShaderProgram_new();
+  out->program = shader_program;
+
+  return out;
+}
+
+void gl_lfont_instanced_program2d_free(gl_lfont_instanced_program2d* program)
+{
+  // free internals
+  free_internals_(program);
+
+  // free source
+  free(program);
+  program = NULL;
+}
+
+bool gl_lfont_instanced_program2d_load_program(gl_lfont_instanced_program2d* program)
+{
+  return load_program_from_files_(program, "res/shaders/l_font_instanced_program2d.vert", "res/shaders/l_font_instanced_program2d.frag");
+}
+
+bool load_program_from_files_(gl_lfont_instanced_program2d* program, const char* vertex_shader_path, const char* fragment_shader_path)
+{
+  // fix attribute locations so vertex array objects can be set up without program at hand
+  const gl_LShaderProgram_attrib_location attrib_locations[] = {
+    { gl_lfont_instanced_program2d_GLYPH_RECT_LOCATION, "glyph_rect" },
+    { gl_lfont_instanced_program2d_GLYPH_TEXRECT_LOCATION, "glyph_texrect" },
+    { gl_lfont_instanced_program2d_GLYPH_COLOR_LOCATION, "glyph_color" },
+    { gl_lfont_instanced_program2d_GLYPH_TRANSFORM_LOCATION, "glyph_transform" }
+  };
+
+  // build program, restored from binary cache if available
+  // locations are looked up once it's linked
+  return gl_LShaderProgram_build_program(program->program, vertex_shader_path, fragment_shader_path, attrib_locations, sizeof(attrib_locations) / sizeof(attrib_locations[0]), query_locations_, program);
+}
+
+void query_locations_(void* user_data)
+{
+  gl_lfont_instanced_program2d* program = user_data;
+  GLuint program_id = program->program->program_id;
+
+  // get uniform locations
+  program->modelview_matrix_location = glGetUniformLocation(program_id, "modelview_matrix");
+  if (program->modelview_matrix_location == -1)
+  {
+    SDL_Log("Warning: cannot get location of modelview_matrix");
+  }
+  program->texture_sampler_location = glGetUniformLocation(program_id, "texture_sampler");
+  if (program->texture_sampler_location == -1)
+  {
+    SDL_Log("Warning: cannot get location of texture_sampler");
+  }
+}
+
+void gl_lfont_instanced_program2d_update_modelview_matrix(gl_lfont_instanced_program2d* program)
+{
+  glUniformMatrix4fv(program->modelview_matrix_location, 1, GL_FALSE, program->modelview_matrix[0]);
+}
+
+void gl_lfont_instanced_program2d_set_texture_sampler(gl_lfont_instanced_program2d* program, GLuint sampler)
+{
+  glUniform1i(program->texture_sampler_location, sampler);
+}
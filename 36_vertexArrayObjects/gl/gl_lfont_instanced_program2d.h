@@ -0,0 +1,78 @@
+#ifndef gl_lfont_instanced_program2d_h_
+#define gl_lfont_instanced_program2d_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LShaderProgram.h"
+
+/// Font program variant which renders one glyph per instance.
+///
+/// Each instance carries glyph's quad, atlas rect, color, rotation and scale as vertex attributes
+/// advancing once per instance, so a whole run of differently styled glyphs renders in a single
+/// instanced draw call. See gl_lglyph_run.
+///
+/// Attribute locations are fixed before linking, thus vertex array objects set up with them
+/// work with any instance of this program.
+
+/// fixed attribute locations of per-glyph instance data
+enum gl_lfont_instanced_program2d_AttribLocation
+{
+  gl_lfont_instanced_program2d_GLYPH_RECT_LOCATION        = 0,
+  gl_lfont_instanced_program2d_GLYPH_TEXRECT_LOCATION     = 1,
+  gl_lfont_instanced_program2d_GLYPH_COLOR_LOCATION       = 2,
+  gl_lfont_instanced_program2d_GLYPH_TRANSFORM_LOCATION   = 3
+};
+
+typedef struct gl_lfont_instanced_program2d_
+{
+  // underlying shader program
+  gl_LShaderProgram *program;
+
+  /// uniform location
+  /// (internal use)
+  GLint modelview_matrix_location;
+  GLint texture_sampler_location;
+
+  /// matrices
+  /// projection, and view matrix are shared via frame constants, see gl_lframe_constants
+  mat4 modelview_matrix;
+} gl_lfont_instanced_program2d;
+
+///
+/// create a new instanced font shader program on heap.
+/// it will also create underlying gl_LShaderProgram and manage it automatically for its memory deallocation.
+///
+/// \return Newly created gl_lfont_instanced_program2d
+///
+extern gl_lfont_instanced_program2d* gl_lfont_instanced_program2d_new();
+
+///
+/// free instanced font shader program
+///
+/// \param program pointer to gl_lfont_instanced_program2d
+///
+extern void gl_lfont_instanced_program2d_free(gl_lfont_instanced_program2d* program);
+
+///
+/// load program
+///
+/// \param program pointer to program
+/// \return true if load successfully, otherwise false
+///
+extern bool gl_lfont_instanced_program2d_load_program(gl_lfont_instanced_program2d* program);
+
+///
+/// update modelview matrix then to update to gpu.
+///
+/// \param program pointer to program
+///
+extern void gl_lfont_instanced_program2d_update_modelview_matrix(gl_lfont_instanced_program2d* program);
+
+///
+/// set texture sampler name then to update to gpu
+///
+/// \param program pointer to program
+/// \param sampler sampler name to bind texture
+///
+extern void gl_lfont_instanced_program2d_set_texture_sampler(gl_lfont_instanced_program2d* program, GLuint sampler);
+
+#endif
@@ -1,22 +1,23 @@
 #include "gl_lfont_polygon_program2d.h"
 #include "gl/gl_LShaderProgram.h"
+#include "gl/gl_lvertex_format.h"
 #include "SDL_log.h"
 #include <stdlib.h>
 
+static void query_locations_(void* user_data);
 static void free_internals_(gl_lfont_polygon_program2d* program);
+static bool load_program_variant_(gl_lfont_polygon_program2d* program, const char* const* defines, int define_count);
 
 void free_internals_(gl_lfont_polygon_program2d* program)
 {
   // reset all locations
   program->vertex_pos2d_location = -1;
   program->texture_coord_location = -1;
-  program->projection_matrix_location = -1;
   program->modelview_matrix_location = -1;
   program->texture_sampler_location = -1;
   program->text_color_location = -1;
 
   // set matrix to identity
-  glm_mat4_identity(program->projection_matrix);
   glm_mat4_identity(program->modelview_matrix);
   
   // free underlying shader program
@@ -32,11 +33,9 @@ gl_lfont_polygon_program2d* gl_lfont_polygon_program2d_new()
   out->program = NULL;
   out->vertex_pos2d_location = -1;
   out->texture_coord_location = -1;
-  out->projection_matrix_location = -1;
   out->modelview_matrix_location = -1;
   out->texture_sampler_location = -1;
   out->text_color_location = -1;
-  glm_mat4_identity(out->projection_matrix);
   glm_mat4_identity(out->modelview_matrix);
 
   // create underlying shader program
@@ -59,104 +58,27 @@ void gl_lfont_polygon_program2d_free(gl_lfont_polygon_program2d* program)
 
 bool gl_lfont_polygon_program2d_load_program(gl_lfont_polygon_program2d* program)
 {
-  // create a new program
-  GLuint program_id = glCreateProgram();
-
-  // load vertex shader
-  GLuint vertex_shader_id = gl_LShaderProgram_load_shader_from_file("res/shaders/l_font_program2d.vert", GL_VERTEX_SHADER);
-  if (vertex_shader_id == 0)
-  {
-    SDL_Log("Unable to load vertex shader from file");
-
-    // delete program
-    glDeleteProgram(program_id);
-    program_id = 0;
-
-    return false;
-  }
-
-  // attach vertex shader to shader program
-  glAttachShader(program_id, vertex_shader_id);
-  // check for errors
-  GLenum error = glGetError();
-  if (error != GL_NO_ERROR)
-  {
-    SDL_Log("Error attaching vertex shader");
-    gl_LShaderProgram_print_shader_log(vertex_shader_id);
-
-    // delete program
-    glDeleteProgram(program_id);
-    program_id = 0;
-
-    return false;
-  }
-
-  // load fragment shader
-  GLuint fragment_shader_id = gl_LShaderProgram_load_shader_from_file("res/shaders/l_font_program2d.frag", GL_FRAGMENT_SHADER);
-  if (fragment_shader_id == 0)
-  {
-    SDL_Log("Unable to load fragment shader from file");
-
-    // delete vertex shader
-    glDeleteShader(vertex_shader_id);
-    vertex_shader_id = 0;
-
-    // delete program
-    glDeleteProgram(program_id);
-    program_id = 0;
-
-    return false;
-  }
-
-  // attach fragment shader to program
-  glAttachShader(program_id, fragment_shader_id);
-  // check for errors
-  error = glGetError();
-  if (error != GL_NO_ERROR)
-  {
-    SDL_Log("Error attaching fragment shader");
-    gl_LShaderProgram_print_shader_log(fragment_shader_id);
-
-    // delete vertex shader
-    glDeleteShader(vertex_shader_id);
-    vertex_shader_id = 0;
-
-    // delete program
-    glDeleteProgram(program_id);
-    program_id = 0;
-
-    return false;
-  }
-
-  // link program
-  glLinkProgram(program_id);
-  error = glGetError();
-  if (error != GL_NO_ERROR)
-  {
-    SDL_Log("Error linking program");
-    gl_LShaderProgram_print_program_log(program_id);
-
-    // delete vertex shader
-    glDeleteShader(vertex_shader_id);
-    vertex_shader_id = 0;
-
-    // delete fragment shader
-    glDeleteShader(fragment_shader_id);
-    fragment_shader_id = 0;
-
-    // delete program
-    glDeleteProgram(program_id);
-    program_id = 0;
+  return load_program_variant_(program, NULL, 0);
+}
 
-    return false;
-  }
+bool gl_lfont_polygon_program2d_load_sdf_program(gl_lfont_polygon_program2d* program)
+{
+  // same shaders specialized to sample distance field
+  const char* defines[] = { "SDF" };
+  return load_program_variant_(program, defines, 1);
+}
 
-  // set result program id to underlying program
-  program->program->program_id = program_id;
+bool load_program_variant_(gl_lfont_polygon_program2d* program, const char* const* defines, int define_count)
+{
+  // build program, restored from binary cache if available
+  // locations are looked up once it's linked
+  return gl_LShaderProgram_build_program_with_defines(program->program, "res/shaders/l_font_program2d.vert", "res/shaders/l_font_program2d.frag", defines, define_count, NULL, 0, query_locations_, program);
+}
 
-  // mark shader for delete
-  glDeleteShader(vertex_shader_id);
-  glDeleteShader(fragment_shader_id);
+void query_locations_(void* user_data)
+{
+  gl_lfont_polygon_program2d* program = user_data;
+  GLuint program_id = program->program->program_id;
 
   // get attribute locations
   program->vertex_pos2d_location = glGetAttribLocation(program_id, "vertex_pos2d");
@@ -171,11 +93,6 @@ bool gl_lfont_polygon_program2d_load_program(gl_lfont_polygon_program2d* program
   }
 
   // get uniform locations
-  program->projection_matrix_location = glGetUniformLocation(program_id, "projection_matrix");
-  if (program->projection_matrix_location == -1)
-  {
-    SDL_Log("Warning: cannot get location of projection_matrix");
-  }
   program->modelview_matrix_location = glGetUniformLocation(program_id, "modelview_matrix");
   if (program->modelview_matrix_location == -1)
   {
@@ -191,13 +108,6 @@ bool gl_lfont_polygon_program2d_load_program(gl_lfont_polygon_program2d* program
   {
     SDL_Log("Warning: cannot get location of text_color");
   }
-
-  return true;
-}
-
-void gl_lfont_polygon_program2d_update_projection_matrix(gl_lfont_polygon_program2d* program)
-{
-  glUniformMatrix4fv(program->projection_matrix_location, 1, GL_FALSE, program->projection_matrix[0]);
 }
 
 void gl_lfont_polygon_program2d_update_modelview_matrix(gl_lfont_polygon_program2d* program)
@@ -215,6 +125,16 @@ void gl_lfont_polygon_program2d_set_texcoord_pointer(gl_lfont_polygon_program2d*
   glVertexAttribPointer(program->texture_coord_location, 2, GL_FLOAT, GL_FALSE, stride, data);
 }
 
+void gl_lfont_polygon_program2d_set_attrib_pointers(gl_lfont_polygon_program2d* program, LVertexFormat2D format, const GLvoid* data)
+{
+  gl_lvertex_format_attrib position, texcoord;
+  gl_lvertex_format_textured_attribs(format, &position, &texcoord);
+
+  const GLsizei stride = gl_lvertex_format_stride(format);
+  glVertexAttribPointer(program->vertex_pos2d_location, position.size, position.type, position.normalized, stride, (const GLubyte*)data + position.offset);
+  glVertexAttribPointer(program->texture_coord_location, texcoord.size, texcoord.type, texcoord.normalized, stride, (const GLubyte*)data + texcoord.offset);
+}
+
 void gl_lfont_polygon_program2d_set_texture_sampler(gl_lfont_polygon_program2d* program, GLuint sampler)
 {
   glUniform1i(program->texture_sampler_location, sampler);
@@ -3,6 +3,7 @@
 
 #include "gl/glLOpenGL.h"
 #include "gl/gl_LShaderProgram.h"
+#include "gl/gl_types.h"
 
 typedef struct gl_lfont_polygon_program2d_
 {
@@ -15,13 +16,12 @@ typedef struct gl_lfont_polygon_program2d_
 
   /// uniform location
   /// (internal use)
-  GLint projection_matrix_location;
   GLint modelview_matrix_location;
   GLint texture_sampler_location;
   GLint text_color_location;
 
   /// matrices
-  mat4 projection_matrix;
+  /// projection, and view matrix are shared via frame constants, see gl_lframe_constants
   mat4 modelview_matrix;
 
 } gl_lfont_polygon_program2d;
@@ -50,11 +50,14 @@ extern void gl_lfont_polygon_program2d_free(gl_lfont_polygon_program2d* program)
 extern bool gl_lfont_polygon_program2d_load_program(gl_lfont_polygon_program2d* program);
 
 ///
-/// update projection matrix then to update to gpu.
+/// load program for rendering signed distance field font (see gl_LFont_load_freetype_sdf())
+/// it's built from the same shader files as normal font program specialized with SDF define,
+/// thus it has the same attributes and uniforms.
 ///
 /// \param program pointer to program
+/// \return true if load successfully, otherwise false
 ///
-extern void gl_lfont_polygon_program2d_update_projection_matrix(gl_lfont_polygon_program2d* program);
+extern bool gl_lfont_polygon_program2d_load_sdf_program(gl_lfont_polygon_program2d* program);
 
 ///
 /// update modelview matrix then to update to gpu.
@@ -81,6 +84,16 @@ extern void gl_lfont_polygon_program2d_set_vertex_pointer(gl_lfont_polygon_progr
 ///
 extern void gl_lfont_polygon_program2d_set_texcoord_pointer(gl_lfont_polygon_program2d* program, GLsizei stride, const GLvoid* data);
 
+///
+/// set both vertex, and texture coordinate pointer for vertices in specified layout
+/// (LVertexData2D, or LCompactVertexData2D, see gl/gl_lvertex_format.h)
+///
+/// \param program pointer to program
+/// \param format vertex format of bound vertex buffer
+/// \param data pointer to data buffer offset of first vertex
+///
+extern void gl_lfont_polygon_program2d_set_attrib_pointers(gl_lfont_polygon_program2d* program, LVertexFormat2D format, const GLvoid* data);
+
 ///
 /// set texture sampler name then to update to gpu
 ///
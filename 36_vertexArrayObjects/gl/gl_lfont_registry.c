@@ -0,0 +1,502 @@
+#include "gl_lfont_registry.h"
+#include "gl/gl_LFont_internals.h"
+#include "gl/gl_LTexture_internals.h"
+#include "gl/gl_lsampler_cache.h"
+#include "foundation/krr_filemap.h"
+#include "foundation/krr_hash.h"
+#include "foundation/krr_math.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+// empty rows between atlases in a shared page, so linear filtering doesn't bleed into neighbor
+#define PAGE_GAP 2
+
+struct file_entry_
+{
+  uint64_t path_hash;
+  // NULL if entry is free for reuse
+  char* path;
+  // font file's content, FreeType reads it straight from here
+  krr_filemap map;
+  // number of alive fonts from this file
+  int refcount;
+};
+
+struct font_entry_
+{
+  // NULL if entry is free for reuse
+  gl_LFont* font;
+  int file_index;
+  GLuint pixel_size;
+  // number of references handed out
+  int refcount;
+  // index into pages, -1 if font has its own atlas
+  int page_index;
+  // byte cost of font's own atlas on GPU, 0 if it's in a shared page
+  size_t bytes;
+};
+
+struct page_entry_
+{
+  // shared atlas, NULL if entry is free for reuse
+  gl_LTexture* texture;
+  // number of alive fonts in this page
+  int refcount;
+  // byte cost on GPU
+  size_t bytes;
+};
+
+static void init_defaults_(gl_lfont_registry* registry);
+static int next_pot_(int value);
+static int find_file_(gl_lfont_registry* registry, uint64_t path_hash, const char* path);
+static int open_file_(gl_lfont_registry* registry, const char* path);
+static void unref_file_(gl_lfont_registry* registry, int file_index, int count);
+static int find_font_(gl_lfont_registry* registry, int file_index, GLuint pixel_size);
+static int add_font_(gl_lfont_registry* registry, gl_LFont* font, int file_index, GLuint pixel_size, int page_index);
+static int add_page_(gl_lfont_registry* registry, gl_LTexture* texture, int refcount);
+static void free_font_(gl_lfont_registry* registry, struct font_entry_* entry);
+static bool build_page_(gl_lfont_registry* registry, gl_LFont** fonts, int count, int* out_page_index);
+
+void init_defaults_(gl_lfont_registry* registry)
+{
+  memset(&registry->stats, 0, sizeof(registry->stats));
+  registry->files_ = NULL;
+  registry->fonts_ = NULL;
+  registry->pages_ = NULL;
+}
+
+int next_pot_(int value)
+{
+  int pot = 1;
+  while (pot < value)
+  {
+    pot <<= 1;
+  }
+  return pot;
+}
+
+gl_lfont_registry* gl_lfont_registry_new()
+{
+  gl_lfont_registry* out = malloc(sizeof(gl_lfont_registry));
+  init_defaults_(out);
+
+  out->files_ = vector_new(4, sizeof(struct file_entry_));
+  out->fonts_ = vector_new(8, sizeof(struct font_entry_));
+  out->pages_ = vector_new(4, sizeof(struct page_entry_));
+
+  return out;
+}
+
+void gl_lfont_registry_free(gl_lfont_registry* registry)
+{
+  if (registry != NULL)
+  {
+    for (int i=0; i<registry->fonts_->len; i++)
+    {
+      struct font_entry_* entry = vector_get(registry->fonts_, i);
+      if (entry->font != NULL)
+      {
+        entry->refcount = 0;
+        free_font_(registry, entry);
+      }
+    }
+    vector_free(registry->fonts_);
+    registry->fonts_ = NULL;
+
+    // every page, and file is freed along with its last font
+    vector_free(registry->pages_);
+    registry->pages_ = NULL;
+    vector_free(registry->files_);
+    registry->files_ = NULL;
+
+    free(registry);
+    registry = NULL;
+  }
+}
+
+int find_file_(gl_lfont_registry* registry, uint64_t path_hash, const char* path)
+{
+  for (int i=0; i<registry->files_->len; i++)
+  {
+    struct file_entry_* fe = vector_get(registry->files_, i);
+    // compare hash first, string only to confirm
+    if (fe->path != NULL && fe->path_hash == path_hash && strcmp(fe->path, path) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int open_file_(gl_lfont_registry* registry, const char* path)
+{
+  uint64_t path_hash = krr_hash_string(path);
+  int file_index = find_file_(registry, path_hash, path);
+  if (file_index != -1)
+  {
+    return file_index;
+  }
+
+  struct file_entry_ new_entry;
+  if (!krr_filemap_open(&new_entry.map, path))
+  {
+    SDL_Log("Unable to open font file %s", path);
+    return -1;
+  }
+  registry->stats.file_opens++;
+
+  new_entry.path_hash = path_hash;
+  new_entry.path = malloc(strlen(path) + 1);
+  strcpy(new_entry.path, path);
+  new_entry.refcount = 0;
+
+  // reuse free entry first, indices of others must stay stable
+  for (int i=0; i<registry->files_->len; i++)
+  {
+    struct file_entry_* fe = vector_get(registry->files_, i);
+    if (fe->path == NULL)
+    {
+      *fe = new_entry;
+      return i;
+    }
+  }
+
+  vector_add(registry->files_, &new_entry);
+  return registry->files_->len - 1;
+}
+
+void unref_file_(gl_lfont_registry* registry, int file_index, int count)
+{
+  struct file_entry_* fe = vector_get(registry->files_, file_index);
+  fe->refcount -= count;
+
+  // no more font from this file, close it
+  if (fe->refcount <= 0)
+  {
+    krr_filemap_close(&fe->map);
+    free(fe->path);
+    fe->path = NULL;
+    fe->refcount = 0;
+  }
+}
+
+int find_font_(gl_lfont_registry* registry, int file_index, GLuint pixel_size)
+{
+  for (int i=0; i<registry->fonts_->len; i++)
+  {
+    struct font_entry_* entry = vector_get(registry->fonts_, i);
+    if (entry->font != NULL && entry->file_index == file_index && entry->pixel_size == pixel_size)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int add_font_(gl_lfont_registry* registry, gl_LFont* font, int file_index, GLuint pixel_size, int page_index)
+{
+  const gl_LTexture* texture = font->spritesheet->ltexture;
+
+  struct font_entry_ new_entry;
+  new_entry.font = font;
+  new_entry.file_index = file_index;
+  new_entry.pixel_size = pixel_size;
+  new_entry.refcount = 1;
+  new_entry.page_index = page_index;
+  new_entry.bytes = page_index == -1 ? (size_t)texture->physical_width_ * texture->physical_height_ : 0;
+
+  registry->stats.atlas_bytes += new_entry.bytes;
+  ((struct file_entry_*)vector_get(registry->files_, file_index))->refcount++;
+
+  for (int i=0; i<registry->fonts_->len; i++)
+  {
+    struct font_entry_* entry = vector_get(registry->fonts_, i);
+    if (entry->font == NULL)
+    {
+      *entry = new_entry;
+      return i;
+    }
+  }
+
+  vector_add(registry->fonts_, &new_entry);
+  return registry->fonts_->len - 1;
+}
+
+int add_page_(gl_lfont_registry* registry, gl_LTexture* texture, int refcount)
+{
+  struct page_entry_ new_entry;
+  new_entry.texture = texture;
+  new_entry.refcount = refcount;
+  new_entry.bytes = (size_t)texture->physical_width_ * texture->physical_height_;
+
+  registry->stats.pages++;
+  registry->stats.atlas_bytes += new_entry.bytes;
+
+  for (int i=0; i<registry->pages_->len; i++)
+  {
+    struct page_entry_* entry = vector_get(registry->pages_, i);
+    if (entry->texture == NULL)
+    {
+      *entry = new_entry;
+      return i;
+    }
+  }
+
+  vector_add(registry->pages_, &new_entry);
+  return registry->pages_->len - 1;
+}
+
+void free_font_(gl_lfont_registry* registry, struct font_entry_* entry)
+{
+  if (entry->page_index != -1)
+  {
+    // page is not font's to free
+    entry->font->spritesheet->ltexture = NULL;
+
+    struct page_entry_* page = vector_get(registry->pages_, entry->page_index);
+    page->refcount--;
+    if (page->refcount <= 0)
+    {
+      gl_LTexture_free(page->texture);
+      page->texture = NULL;
+      registry->stats.pages--;
+      registry->stats.atlas_bytes -= page->bytes;
+    }
+  }
+  else
+  {
+    registry->stats.atlas_bytes -= entry->bytes;
+  }
+
+  gl_LFont_free(entry->font);
+  entry->font = NULL;
+
+  unref_file_(registry, entry->file_index, 1);
+}
+
+gl_LFont* gl_lfont_registry_acquire(gl_lfont_registry* registry, const char* path, GLuint pixel_size)
+{
+  gl_LFont* font = NULL;
+  if (gl_lfont_registry_acquire_sizes(registry, path, &pixel_size, 1, &font))
+  {
+    return font;
+  }
+  return NULL;
+}
+
+bool build_page_(gl_lfont_registry* registry, gl_LFont** fonts, int count, int* out_page_index)
+{
+  // stack atlases vertically
+  int page_width = 0;
+  int page_height = 0;
+  for (int i=0; i<count; i++)
+  {
+    const gl_LTexture* atlas = fonts[i]->spritesheet->ltexture;
+    page_width = krr_math_max(page_width, atlas->width);
+    page_height += atlas->height + (i > 0 ? PAGE_GAP : 0);
+  }
+
+  GLint max_texture_size = 0;
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+  if (next_pot_(page_width) > max_texture_size || next_pot_(page_height) > max_texture_size)
+  {
+    return false;
+  }
+
+  gl_LTexture* page = gl_LTexture_new();
+  gl_LTexture_create_pixels8(page, page_width, page_height);
+
+  int y = 0;
+  for (int i=0; i<count; i++)
+  {
+    gl_LSpritesheet* ss = fonts[i]->spritesheet;
+    gl_LTexture_blit_pixels8(ss->ltexture, 0, y, page);
+
+    // move clips along with pixels
+    for (int c=0; c<ss->clips->len; c++)
+    {
+      ((LRect*)vector_get(ss->clips, c))->y += y;
+    }
+    y += ss->ltexture->height + PAGE_GAP;
+  }
+
+  // make texture power of two then upload
+  gl_LTexture_pad_pixels8(page);
+  if (!gl_LTexture_load_texture_from_precreated_pixels8(page))
+  {
+    SDL_Log("Unable to create shared font atlas page");
+    gl_LTexture_free(page);
+
+    // put clips back for fonts to be uploaded on their own
+    y = 0;
+    for (int i=0; i<count; i++)
+    {
+      gl_LSpritesheet* ss = fonts[i]->spritesheet;
+      for (int c=0; c<ss->clips->len; c++)
+      {
+        ((LRect*)vector_get(ss->clips, c))->y -= y;
+      }
+      y += ss->ltexture->height + PAGE_GAP;
+    }
+    return false;
+  }
+
+  gl_LTexture_set_sampler(page, gl_lsampler_cache_get(&gl_lsampler_desc_clamp_to_border));
+
+  // fonts now refer to page instead of their own atlas
+  for (int i=0; i<count; i++)
+  {
+    gl_LSpritesheet* ss = fonts[i]->spritesheet;
+    gl_LTexture_free(ss->ltexture);
+    ss->ltexture = page;
+    gl_LSpritesheet_generate_databuffer(ss);
+  }
+
+  *out_page_index = add_page_(registry, page, count);
+  return true;
+}
+
+bool gl_lfont_registry_acquire_sizes(gl_lfont_registry* registry, const char* path, const GLuint* pixel_sizes, int count, gl_LFont** out_fonts)
+{
+  int file_index = open_file_(registry, path);
+  if (file_index == -1)
+  {
+    return false;
+  }
+  const krr_filemap* map = &((struct file_entry_*)vector_get(registry->files_, file_index))->map;
+
+  // bake sizes that are not loaded yet
+  gl_LFont** baked = malloc(count * sizeof(gl_LFont*));
+  GLuint* baked_sizes = malloc(count * sizeof(GLuint));
+  int baked_count = 0;
+  bool result = true;
+  // whether size at the same index is baked by this call
+  bool* is_baked = malloc(count * sizeof(bool));
+  memset(is_baked, 0, count * sizeof(bool));
+
+  for (int i=0; i<count && result; i++)
+  {
+    out_fonts[i] = NULL;
+    if (find_font_(registry, file_index, pixel_sizes[i]) != -1)
+    {
+      continue;
+    }
+
+    // the same size may be asked for more than once
+    bool duplicate = false;
+    for (int j=0; j<baked_count && !duplicate; j++)
+    {
+      duplicate = baked_sizes[j] == pixel_sizes[i];
+    }
+    if (duplicate)
+    {
+      continue;
+    }
+
+    gl_LFont* font = gl_LFont_new(gl_LSpritesheet_new(gl_LTexture_new()));
+    if (!gl_LFont_bake_freetype_from_memory(font, map->data, map->size, pixel_sizes[i]))
+    {
+      SDL_Log("Unable to bake font %s (%upx)", path, pixel_sizes[i]);
+      gl_LFont_free(font);
+      result = false;
+      break;
+    }
+    baked[baked_count] = font;
+    baked_sizes[baked_count] = pixel_sizes[i];
+    baked_count++;
+    is_baked[i] = true;
+  }
+
+  // upload into a shared page, or into each font's own atlas if they don't fit into one
+  int page_index = -1;
+  if (result && baked_count > 1 && !build_page_(registry, baked, baked_count, &page_index))
+  {
+    SDL_Log("Font sizes of %s don't fit into a single atlas page, upload them separately", path);
+  }
+  for (int i=0; i<baked_count && result && page_index == -1; i++)
+  {
+    if (!gl_LFont_upload_baked(baked[i]))
+    {
+      SDL_Log("Unable to upload font %s (%upx)", path, baked_sizes[i]);
+      result = false;
+    }
+  }
+
+  if (!result)
+  {
+    for (int i=0; i<baked_count; i++)
+    {
+      gl_LFont_free(baked[i]);
+    }
+    free(baked);
+    free(baked_sizes);
+    free(is_baked);
+
+    // close file if nothing else uses it
+    unref_file_(registry, file_index, 0);
+    return false;
+  }
+
+  for (int i=0; i<baked_count; i++)
+  {
+    add_font_(registry, baked[i], file_index, baked_sizes[i], page_index);
+  }
+  free(baked);
+  free(baked_sizes);
+
+  // hand out references, newly baked font already holds its first one
+  for (int i=0; i<count; i++)
+  {
+    struct font_entry_* entry = vector_get(registry->fonts_, find_font_(registry, file_index, pixel_sizes[i]));
+    out_fonts[i] = entry->font;
+
+    if (is_baked[i])
+    {
+      registry->stats.font_misses++;
+    }
+    else
+    {
+      entry->refcount++;
+      registry->stats.font_hits++;
+    }
+  }
+  free(is_baked);
+
+  return true;
+}
+
+void gl_lfont_registry_release(gl_lfont_registry* registry, gl_LFont* font)
+{
+  for (int i=0; i<registry->fonts_->len; i++)
+  {
+    struct font_entry_* entry = vector_get(registry->fonts_, i);
+    if (entry->font != font)
+    {
+      continue;
+    }
+
+    entry->refcount--;
+    if (entry->refcount <= 0)
+    {
+      // last reference
+      free_font_(registry, entry);
+    }
+    return;
+  }
+
+  SDL_Log("Font %p is not acquired from this registry", (void*)font);
+}
+
+void gl_lfont_registry_print_stats(gl_lfont_registry* registry)
+{
+  const gl_lfont_registry_stats* stats = &registry->stats;
+  unsigned int total = stats->font_hits + stats->font_misses;
+  SDL_Log("Font registry: file opens %u, font hits %u, misses %u, hit rate %.1f%%, shared pages %u, atlas memory %llu bytes",
+      stats->file_opens,
+      stats->font_hits,
+      stats->font_misses,
+      total > 0 ? 100.0 * stats->font_hits / total : 0.0,
+      stats->pages,
+      stats->atlas_bytes);
+}
@@ -0,0 +1,106 @@
+#ifndef gl_lfont_registry_h_
+#define gl_lfont_registry_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LFont.h"
+#include "foundation/vector.h"
+
+/// Font registry which shares FreeType fonts across repeated loads.
+///
+/// Each font file is opened, and mapped into memory once no matter how many sizes are used from it,
+/// and kept until the last font from it is released.
+/// Fonts are keyed by (path, pixel size), and reference-counted. Acquire the same pair again returns the same font
+/// without baking.
+///
+/// Multiple sizes of the same file can optionally share a single atlas page via gl_lfont_registry_acquire_sizes(),
+/// so text rendered in those sizes binds the same texture, and can be batched together.
+///
+/// Fonts handed out by registry are owned by it. Don't free, nor reload them but release them via
+/// gl_lfont_registry_release().
+
+/// registry statistics
+typedef struct
+{
+  /// number of times font file has been opened
+  unsigned int file_opens;
+  /// acquires satisfied by already loaded font
+  unsigned int font_hits;
+  /// acquires that had to bake font
+  unsigned int font_misses;
+  /// number of shared atlas pages currently alive
+  unsigned int pages;
+  /// GPU bytes of all font atlases currently alive
+  unsigned long long atlas_bytes;
+} gl_lfont_registry_stats;
+
+typedef struct
+{
+  /// (read-only) statistics
+  gl_lfont_registry_stats stats;
+
+  /// (internal use) mapped font files
+  vector* files_;
+  /// (internal use) fonts by (file, size)
+  vector* fonts_;
+  /// (internal use) shared atlas pages
+  vector* pages_;
+} gl_lfont_registry;
+
+///
+/// Create a new font registry.
+///
+/// \return Newly created gl_lfont_registry on heap.
+///
+extern gl_lfont_registry* gl_lfont_registry_new();
+
+///
+/// Free font registry.
+/// All fonts it holds will be freed regardless of their reference count.
+///
+/// \param registry Pointer to gl_lfont_registry
+///
+extern void gl_lfont_registry_free(gl_lfont_registry* registry);
+
+///
+/// Acquire font of TTF file at pixel size.
+/// Returned font is shared, don't free it directly but release it via gl_lfont_registry_release().
+///
+/// \param registry Pointer to gl_lfont_registry
+/// \param path Path to TTF file
+/// \param pixel_size Pixel size of font
+/// \return Shared font, or NULL if loading failed.
+///
+extern gl_LFont* gl_lfont_registry_acquire(gl_lfont_registry* registry, const char* path, GLuint pixel_size);
+
+///
+/// Acquire fonts of TTF file at multiple pixel sizes.
+/// Sizes not loaded yet are baked then placed into a single shared atlas page.
+/// If they don't fit into a single texture, each gets its own atlas instead.
+/// Each returned font has to be released via gl_lfont_registry_release().
+///
+/// \param registry Pointer to gl_lfont_registry
+/// \param path Path to TTF file
+/// \param pixel_sizes Array of pixel sizes
+/// \param count Number of pixel sizes
+/// \param out_fonts Array of at least count fonts to receive shared font of each size
+/// \return True if all fonts are acquired, otherwise return false and no font is acquired.
+///
+extern bool gl_lfont_registry_acquire_sizes(gl_lfont_registry* registry, const char* path, const GLuint* pixel_sizes, int count, gl_LFont** out_fonts);
+
+///
+/// Release font previously acquired.
+/// Font is freed when there's no more reference to it.
+///
+/// \param registry Pointer to gl_lfont_registry
+/// \param font Font returned from gl_lfont_registry_acquire(), or gl_lfont_registry_acquire_sizes()
+///
+extern void gl_lfont_registry_release(gl_lfont_registry* registry, gl_LFont* font);
+
+///
+/// Print file opens, hit rate, and atlas memory.
+///
+/// \param registry Pointer to gl_lfont_registry
+///
+extern void gl_lfont_registry_print_stats(gl_lfont_registry* registry);
+
+#endif
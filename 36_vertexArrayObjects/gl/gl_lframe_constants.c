@@ -0,0 +1,96 @@
+#include "gl_lframe_constants.h"
+#include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "SDL_log.h"
+#include <string.h>
+
+static GLuint ubo_ = 0;
+static gl_lframe_constants constants_;
+static unsigned int upload_count_ = 0;
+
+bool gl_lframe_constants_init()
+{
+  if (ubo_ != 0)
+  {
+    return true;
+  }
+
+  glm_mat4_identity(constants_.projection_matrix);
+  glm_mat4_identity(constants_.view_matrix);
+
+  glGenBuffers(1, &ubo_);
+  glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(gl_lframe_constants), &constants_, GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+  // binding point keeps the buffer no matter which program is bound
+  glBindBufferBase(GL_UNIFORM_BUFFER, GL_LFRAME_CONSTANTS_BINDING, ubo_);
+
+  GLenum error = GL_LDEBUG_GET_ERROR();
+  if (error != GL_NO_ERROR)
+  {
+    SDL_Log("Error creating frame constants buffer: %s", gl_util_error_string(error));
+    glDeleteBuffers(1, &ubo_);
+    ubo_ = 0;
+    return false;
+  }
+
+  upload_count_ = 1;
+  return true;
+}
+
+void gl_lframe_constants_free()
+{
+  if (ubo_ != 0)
+  {
+    glBindBufferBase(GL_UNIFORM_BUFFER, GL_LFRAME_CONSTANTS_BINDING, 0);
+    glDeleteBuffers(1, &ubo_);
+    ubo_ = 0;
+  }
+}
+
+void gl_lframe_constants_update(mat4 projection_matrix, mat4 view_matrix)
+{
+  if (ubo_ == 0)
+  {
+    SDL_Log("Frame constants buffer is not created yet, call gl_lframe_constants_init() first");
+    return;
+  }
+
+  if (memcmp(constants_.projection_matrix, projection_matrix, sizeof(mat4)) == 0 &&
+      memcmp(constants_.view_matrix, view_matrix, sizeof(mat4)) == 0)
+  {
+    return;
+  }
+
+  glm_mat4_copy(projection_matrix, constants_.projection_matrix);
+  glm_mat4_copy(view_matrix, constants_.view_matrix);
+
+  glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(gl_lframe_constants), &constants_);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+  upload_count_++;
+}
+
+const gl_lframe_constants* gl_lframe_constants_get()
+{
+  return &constants_;
+}
+
+bool gl_lframe_constants_bind_program(GLuint program_id)
+{
+  GLuint block_index = glGetUniformBlockIndex(program_id, GL_LFRAME_CONSTANTS_BLOCK_NAME);
+  if (block_index == GL_INVALID_INDEX)
+  {
+    return false;
+  }
+
+  glUniformBlockBinding(program_id, block_index, GL_LFRAME_CONSTANTS_BINDING);
+  return true;
+}
+
+unsigned int gl_lframe_constants_upload_count()
+{
+  return upload_count_;
+}
@@ -0,0 +1,85 @@
+#ifndef gl_lframe_constants_h_
+#define gl_lframe_constants_h_
+
+#include "gl/glLOpenGL.h"
+#include <stdbool.h>
+
+/// Per-frame constants shared by all programs via a single uniform buffer.
+///
+/// Shaders declare the block as
+///
+///   layout(std140) uniform FrameConstants
+///   {
+///     mat4 projection_matrix;
+///     mat4 view_matrix;
+///   };
+///
+/// then compute position as projection_matrix * view_matrix * modelview_matrix * vertex, where
+/// modelview_matrix is program's own uniform for transformation of what's being drawn.
+///
+/// Every program linked through gl_LShaderProgram which declares the block is bound to
+/// GL_LFRAME_CONSTANTS_BINDING automatically, so updating projection, or view matrix on resize is
+/// a single buffer write regardless of how many programs there are, without binding any of them.
+
+/// uniform buffer binding point of FrameConstants block
+#define GL_LFRAME_CONSTANTS_BINDING 0
+
+/// name of uniform block in shader code
+#define GL_LFRAME_CONSTANTS_BLOCK_NAME "FrameConstants"
+
+/// content of FrameConstants block, it matches std140 layout as it only has mat4 members
+typedef struct
+{
+  /// projection matrix
+  mat4 projection_matrix;
+  /// view matrix applied before projection, i.e. scale for resolution independence
+  mat4 view_matrix;
+} gl_lframe_constants;
+
+///
+/// Create uniform buffer, and attach it to GL_LFRAME_CONSTANTS_BINDING.
+/// Both matrices are initially identity.
+/// OpenGL context must be created before calling this function.
+///
+/// \return True if create successfully, otherwise false.
+///
+extern bool gl_lframe_constants_init();
+
+///
+/// Free uniform buffer.
+///
+extern void gl_lframe_constants_free();
+
+///
+/// Update matrices to uniform buffer.
+/// Upload is skipped if both matrices are the same as the last update, so it's cheap to call every frame.
+///
+/// \param projection_matrix Projection matrix
+/// \param view_matrix View matrix
+///
+extern void gl_lframe_constants_update(mat4 projection_matrix, mat4 view_matrix);
+
+///
+/// Get matrices as of the last update.
+///
+/// \return Current frame constants. You should not modify or free it.
+///
+extern const gl_lframe_constants* gl_lframe_constants_get();
+
+///
+/// Bind program's FrameConstants block (if any) to GL_LFRAME_CONSTANTS_BINDING.
+/// gl_LShaderProgram calls this for every program it links, so normally there's no need to call it.
+///
+/// \param program_id Linked program name
+/// \return True if program has the block, otherwise false.
+///
+extern bool gl_lframe_constants_bind_program(GLuint program_id);
+
+///
+/// Get number of actual uploads to uniform buffer so far.
+///
+/// \return Number of uploads
+///
+extern unsigned int gl_lframe_constants_upload_count();
+
+#endif
@@ -0,0 +1,694 @@
+#include "gl_lglyph_cache.h"
+#include "gl/gl_LTexture_internals.h"
+#include "gl/gl_LFont.h"
+#include "gl/gl_lfont_polygon_program2d.h"
+#include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "gl/gl_lsampler_cache.h"
+#include "gl/gl_lvertex_format.h"
+#include "foundation/krr_utf8.h"
+#include "foundation/krr_util.h"
+#include "foundation/krr_math.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+// initial atlas size, it grows when full
+#define INITIAL_ATLAS_SIZE 256
+// empty pixels between glyphs to avoid bleeding with linear filtering
+#define GLYPH_PADDING 1
+// initial capacity of glyph hash table
+#define INITIAL_GLYPH_CAPACITY 256
+// marks empty slot in glyph hash table, larger than any valid code point
+#define EMPTY_CODEPOINT 0xFFFFFFFF
+// glyph quads are placed at whole pixels relative to render position
+#define BATCH_VERTEX_FORMAT LVERTEX_FORMAT_COMPACT_SHORT
+
+// shelf is a horizontal strip of atlas, glyphs are placed from left to right
+// new shelf is opened below the last one when no existing shelf fits
+typedef struct
+{
+  int y;
+  int height;
+  // x position for next glyph
+  int x;
+} glyph_shelf_;
+
+static void init_defaults_(gl_lglyph_cache* cache);
+static void free_font_(gl_lglyph_cache* cache);
+static void report_freetype_error_(FT_Error error);
+// setup metrics, and empty atlas after face is created
+static bool load_face_(gl_lglyph_cache* cache, GLuint pixel_size);
+static gl_lglyph* find_(gl_lglyph_cache* cache, uint32_t codepoint);
+static gl_lglyph* insert_(gl_lglyph_cache* cache, const gl_lglyph* glyph);
+static void rasterize_(gl_lglyph_cache* cache, uint32_t codepoint, gl_lglyph* out);
+static bool alloc_region_(gl_lglyph_cache* cache, int width, int height, int* out_x, int* out_y);
+static bool grow_atlas_(gl_lglyph_cache* cache);
+static bool upload_atlas_(gl_lglyph_cache* cache);
+static void upload_region_(gl_lglyph_cache* cache, int x, int y, int width, int height);
+static void ensure_batch_capacity_(gl_lglyph_cache* cache, int quad_count);
+
+void init_defaults_(gl_lglyph_cache* cache)
+{
+  cache->atlas = NULL;
+  cache->pixel_size = 0;
+  cache->ascender = 0;
+  cache->descender = 0;
+  cache->line_height = 0;
+
+  cache->stats.rasterized_glyphs = 0;
+  cache->stats.atlas_grows = 0;
+  cache->stats.uploaded_bytes = 0;
+
+  cache->library_ = NULL;
+  cache->face_ = NULL;
+
+  cache->pixels_ = NULL;
+  cache->atlas_width_ = 0;
+  cache->atlas_height_ = 0;
+  cache->max_atlas_size_ = 0;
+  cache->shelves_ = NULL;
+  cache->next_shelf_y_ = 0;
+
+  cache->glyphs_ = NULL;
+  cache->glyph_capacity_ = 0;
+  cache->glyph_count_ = 0;
+
+  cache->VBO_id_ = 0;
+  cache->batch_capacity_ = 0;
+}
+
+void report_freetype_error_(FT_Error error)
+{
+  SDL_Log("FreeType error with code: %X", error);
+}
+
+gl_lglyph_cache* gl_lglyph_cache_new()
+{
+  gl_lglyph_cache* out = malloc(sizeof(gl_lglyph_cache));
+  init_defaults_(out);
+
+  out->atlas = gl_LTexture_new();
+  out->shelves_ = vector_new(16, sizeof(glyph_shelf_));
+
+  return out;
+}
+
+void free_font_(gl_lglyph_cache* cache)
+{
+  if (cache->face_ != NULL)
+  {
+    FT_Done_Face(cache->face_);
+    cache->face_ = NULL;
+  }
+  if (cache->library_ != NULL)
+  {
+    FT_Done_FreeType(cache->library_);
+    cache->library_ = NULL;
+  }
+
+  free(cache->pixels_);
+  cache->pixels_ = NULL;
+  cache->atlas_width_ = 0;
+  cache->atlas_height_ = 0;
+  vector_clear(cache->shelves_);
+  cache->next_shelf_y_ = 0;
+
+  free(cache->glyphs_);
+  cache->glyphs_ = NULL;
+  cache->glyph_capacity_ = 0;
+  cache->glyph_count_ = 0;
+
+  gl_LTexture_free_internal_texture(cache->atlas);
+
+  cache->pixel_size = 0;
+  cache->ascender = 0;
+  cache->descender = 0;
+  cache->line_height = 0;
+}
+
+void gl_lglyph_cache_free(gl_lglyph_cache* cache)
+{
+  if (cache != NULL)
+  {
+    free_font_(cache);
+
+    gl_LTexture_free(cache->atlas);
+    cache->atlas = NULL;
+    vector_free(cache->shelves_);
+    cache->shelves_ = NULL;
+
+    if (cache->VBO_id_ != 0)
+    {
+      glDeleteBuffers(1, &cache->VBO_id_);
+      cache->VBO_id_ = 0;
+    }
+
+    free(cache);
+    cache = NULL;
+  }
+}
+
+bool load_face_(gl_lglyph_cache* cache, GLuint pixel_size)
+{
+  FT_Error error = FT_Set_Pixel_Sizes(cache->face_, 0, pixel_size);
+  if (error)
+  {
+    report_freetype_error_(error);
+    return false;
+  }
+
+  // line metrics in 26.6 fixed point
+  cache->pixel_size = pixel_size;
+  cache->ascender = cache->face_->size->metrics.ascender >> 6;
+  cache->descender = cache->face_->size->metrics.descender >> 6;
+  cache->line_height = cache->face_->size->metrics.height >> 6;
+
+  // empty glyph table
+  cache->glyph_capacity_ = INITIAL_GLYPH_CAPACITY;
+  cache->glyph_count_ = 0;
+  cache->glyphs_ = malloc(cache->glyph_capacity_ * sizeof(gl_lglyph));
+  for (int i=0; i<cache->glyph_capacity_; i++)
+  {
+    cache->glyphs_[i].codepoint = EMPTY_CODEPOINT;
+  }
+
+  // empty atlas
+  GLint max_texture_size = 0;
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+  cache->max_atlas_size_ = max_texture_size;
+
+  cache->atlas_width_ = INITIAL_ATLAS_SIZE;
+  cache->atlas_height_ = INITIAL_ATLAS_SIZE;
+  cache->pixels_ = calloc(cache->atlas_width_ * cache->atlas_height_, sizeof(GLubyte));
+  vector_clear(cache->shelves_);
+  cache->next_shelf_y_ = 0;
+
+  return upload_atlas_(cache);
+}
+
+bool gl_lglyph_cache_load(gl_lglyph_cache* cache, const char* path, GLuint pixel_size)
+{
+  free_font_(cache);
+
+  FT_Error error = FT_Init_FreeType(&cache->library_);
+  if (error)
+  {
+    report_freetype_error_(error);
+    cache->library_ = NULL;
+    return false;
+  }
+
+  error = FT_New_Face(cache->library_, path, 0, &cache->face_);
+  if (error)
+  {
+    report_freetype_error_(error);
+    cache->face_ = NULL;
+    free_font_(cache);
+    return false;
+  }
+
+  if (!load_face_(cache, pixel_size))
+  {
+    SDL_Log("Unable to load font %s", path);
+    free_font_(cache);
+    return false;
+  }
+
+  return true;
+}
+
+bool gl_lglyph_cache_load_from_memory(gl_lglyph_cache* cache, const void* data, size_t size, GLuint pixel_size)
+{
+  free_font_(cache);
+
+  FT_Error error = FT_Init_FreeType(&cache->library_);
+  if (error)
+  {
+    report_freetype_error_(error);
+    cache->library_ = NULL;
+    return false;
+  }
+
+  error = FT_New_Memory_Face(cache->library_, (const FT_Byte*)data, size, 0, &cache->face_);
+  if (error)
+  {
+    report_freetype_error_(error);
+    cache->face_ = NULL;
+    free_font_(cache);
+    return false;
+  }
+
+  if (!load_face_(cache, pixel_size))
+  {
+    SDL_Log("Unable to load font from memory [%p]", data);
+    free_font_(cache);
+    return false;
+  }
+
+  return true;
+}
+
+gl_lglyph* find_(gl_lglyph_cache* cache, uint32_t codepoint)
+{
+  const int mask = cache->glyph_capacity_ - 1;
+  int i = (codepoint * 2654435761u) & mask;
+
+  // linear probing until found or hit empty slot
+  while (cache->glyphs_[i].codepoint != EMPTY_CODEPOINT)
+  {
+    if (cache->glyphs_[i].codepoint == codepoint)
+    {
+      return &cache->glyphs_[i];
+    }
+    i = (i + 1) & mask;
+  }
+
+  return NULL;
+}
+
+gl_lglyph* insert_(gl_lglyph_cache* cache, const gl_lglyph* glyph)
+{
+  // keep load factor at most 1/2 to keep probing short
+  if ((cache->glyph_count_ + 1) * 2 > cache->glyph_capacity_)
+  {
+    gl_lglyph* old_glyphs = cache->glyphs_;
+    int old_capacity = cache->glyph_capacity_;
+
+    cache->glyph_capacity_ = old_capacity * 2;
+    cache->glyph_count_ = 0;
+    cache->glyphs_ = malloc(cache->glyph_capacity_ * sizeof(gl_lglyph));
+    for (int i=0; i<cache->glyph_capacity_; i++)
+    {
+      cache->glyphs_[i].codepoint = EMPTY_CODEPOINT;
+    }
+
+    for (int i=0; i<old_capacity; i++)
+    {
+      if (old_glyphs[i].codepoint != EMPTY_CODEPOINT)
+      {
+        insert_(cache, &old_glyphs[i]);
+      }
+    }
+    free(old_glyphs);
+  }
+
+  const int mask = cache->glyph_capacity_ - 1;
+  int i = (glyph->codepoint * 2654435761u) & mask;
+  while (cache->glyphs_[i].codepoint != EMPTY_CODEPOINT)
+  {
+    i = (i + 1) & mask;
+  }
+
+  cache->glyphs_[i] = *glyph;
+  cache->glyph_count_++;
+
+  return &cache->glyphs_[i];
+}
+
+bool upload_atlas_(gl_lglyph_cache* cache)
+{
+  if (!gl_LTexture_load_texture_from_memory(cache->atlas, cache->pixels_, GL_RED, cache->atlas_width_, cache->atlas_height_, cache->atlas_width_, cache->atlas_height_, 1))
+  {
+    SDL_Log("Unable to upload glyph atlas %dx%d", cache->atlas_width_, cache->atlas_height_);
+    return false;
+  }
+
+  cache->stats.uploaded_bytes += cache->atlas_width_ * cache->atlas_height_;
+  return true;
+}
+
+void upload_region_(gl_lglyph_cache* cache, int x, int y, int width, int height)
+{
+  glBindTexture(GL_TEXTURE_2D, cache->atlas->texture_id);
+
+  // upload straight from CPU copy of atlas, rows are atlas wide and not 4-byte aligned
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, cache->atlas_width_);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE, cache->pixels_ + y * cache->atlas_width_ + x);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  GLenum error = GL_LDEBUG_GET_ERROR();
+  if (error != GL_NO_ERROR)
+  {
+    krr_util_print_callstack();
+    SDL_Log("Error uploading glyph region (%d,%d %dx%d): %s", x, y, width, height, gl_util_error_string(error));
+    return;
+  }
+
+  cache->stats.uploaded_bytes += width * height;
+}
+
+bool grow_atlas_(gl_lglyph_cache* cache)
+{
+  int new_width = cache->atlas_width_;
+  int new_height = cache->atlas_height_;
+
+  // alternate growing height, and width to stay close to square
+  if (new_height < new_width && new_height * 2 <= cache->max_atlas_size_)
+  {
+    new_height *= 2;
+  }
+  else if (new_width * 2 <= cache->max_atlas_size_)
+  {
+    new_width *= 2;
+  }
+  else if (new_height * 2 <= cache->max_atlas_size_)
+  {
+    new_height *= 2;
+  }
+  else
+  {
+    SDL_Log("Glyph atlas reached maximum size %dx%d", cache->atlas_width_, cache->atlas_height_);
+    return false;
+  }
+
+  // copy existing glyphs at the same position, so their atlas coordinates remain valid
+  GLubyte* new_pixels = calloc(new_width * new_height, sizeof(GLubyte));
+  for (int row=0; row<cache->atlas_height_; row++)
+  {
+    memcpy(new_pixels + row * new_width, cache->pixels_ + row * cache->atlas_width_, cache->atlas_width_);
+  }
+  free(cache->pixels_);
+  cache->pixels_ = new_pixels;
+  cache->atlas_width_ = new_width;
+  cache->atlas_height_ = new_height;
+
+  cache->stats.atlas_grows++;
+
+  return upload_atlas_(cache);
+}
+
+bool alloc_region_(gl_lglyph_cache* cache, int width, int height, int* out_x, int* out_y)
+{
+  while (true)
+  {
+    // find the shelf that fits with least wasted height
+    glyph_shelf_* best = NULL;
+    for (int i=0; i<cache->shelves_->len; i++)
+    {
+      glyph_shelf_* shelf = vector_get(cache->shelves_, i);
+      if (shelf->height >= height && shelf->x + width <= cache->atlas_width_ &&
+          (best == NULL || shelf->height < best->height))
+      {
+        best = shelf;
+      }
+    }
+
+    // prefer opening a new shelf over wasting too much height of existing one
+    bool can_open_shelf = cache->next_shelf_y_ + height <= cache->atlas_height_ && width <= cache->atlas_width_;
+    if (best != NULL && (best->height * 2 <= height * 3 || !can_open_shelf))
+    {
+      *out_x = best->x;
+      *out_y = best->y;
+      best->x += width;
+      return true;
+    }
+
+    if (can_open_shelf)
+    {
+      glyph_shelf_ shelf = { cache->next_shelf_y_, height, width };
+      vector_add(cache->shelves_, &shelf);
+      cache->next_shelf_y_ += height;
+
+      *out_x = 0;
+      *out_y = shelf.y;
+      return true;
+    }
+
+    // no room left, grow then try again
+    if (!grow_atlas_(cache))
+    {
+      return false;
+    }
+  }
+}
+
+void rasterize_(gl_lglyph_cache* cache, uint32_t codepoint, gl_lglyph* out)
+{
+  // failed glyph is cached as empty glyph, so it won't be retried every frame
+  out->codepoint = codepoint;
+  out->atlas_x = 0;
+  out->atlas_y = 0;
+  out->width = 0;
+  out->height = 0;
+  out->bearing_x = 0;
+  out->bearing_y = 0;
+  out->advance = 0;
+
+  // missing code point gets index 0 which is font's "missing glyph"
+  FT_UInt glyph_index = FT_Get_Char_Index(cache->face_, codepoint);
+  FT_Error error = FT_Load_Glyph(cache->face_, glyph_index, FT_LOAD_RENDER);
+  if (error)
+  {
+    report_freetype_error_(error);
+    return;
+  }
+
+  FT_GlyphSlot slot = cache->face_->glyph;
+  const FT_Bitmap* bitmap = &slot->bitmap;
+
+  out->bearing_x = slot->bitmap_left;
+  out->bearing_y = slot->bitmap_top;
+  out->advance = slot->advance.x >> 6;
+  cache->stats.rasterized_glyphs++;
+
+  // nothing to pack i.e. space
+  if (bitmap->width == 0 || bitmap->rows == 0)
+  {
+    return;
+  }
+
+  int x = 0;
+  int y = 0;
+  if (!alloc_region_(cache, bitmap->width + GLYPH_PADDING, bitmap->rows + GLYPH_PADDING, &x, &y))
+  {
+    SDL_Log("No room in glyph atlas for code point U+%04X", codepoint);
+    return;
+  }
+
+  // copy glyph bitmap into CPU copy of atlas
+  for (unsigned int row=0; row<bitmap->rows; row++)
+  {
+    memcpy(cache->pixels_ + (y + row) * cache->atlas_width_ + x, bitmap->buffer + row * bitmap->pitch, bitmap->width);
+  }
+
+  out->atlas_x = x;
+  out->atlas_y = y;
+  out->width = bitmap->width;
+  out->height = bitmap->rows;
+
+  // upload only this glyph's region
+  upload_region_(cache, x, y, out->width, out->height);
+}
+
+const gl_lglyph* gl_lglyph_cache_get(gl_lglyph_cache* cache, uint32_t codepoint)
+{
+  if (cache->face_ == NULL)
+  {
+    return NULL;
+  }
+
+  gl_lglyph* glyph = find_(cache, codepoint);
+  if (glyph != NULL)
+  {
+    return glyph;
+  }
+
+  gl_lglyph new_glyph;
+  rasterize_(cache, codepoint, &new_glyph);
+  return insert_(cache, &new_glyph);
+}
+
+void gl_lglyph_cache_warm(gl_lglyph_cache* cache, const char* text)
+{
+  uint32_t codepoint = 0;
+  while ((codepoint = krr_utf8_next(&text)) != 0)
+  {
+    if (codepoint != '\n')
+    {
+      gl_lglyph_cache_get(cache, codepoint);
+    }
+  }
+}
+
+void ensure_batch_capacity_(gl_lglyph_cache* cache, int quad_count)
+{
+  if (quad_count <= cache->batch_capacity_)
+  {
+    return;
+  }
+
+  int capacity = krr_math_max(64, cache->batch_capacity_);
+  while (capacity < quad_count)
+  {
+    capacity *= 2;
+  }
+
+  if (cache->VBO_id_ == 0)
+  {
+    glGenBuffers(1, &cache->VBO_id_);
+  }
+
+  // vertex data is filled every render
+  glBindBuffer(GL_ARRAY_BUFFER, cache->VBO_id_);
+  glBufferData(GL_ARRAY_BUFFER, capacity * 4 * gl_lvertex_format_stride(BATCH_VERTEX_FORMAT), NULL, GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  cache->batch_capacity_ = capacity;
+}
+
+void gl_lglyph_cache_render_text(gl_lglyph_cache* cache, const char* text, GLfloat x, GLfloat y)
+{
+  if (cache->face_ == NULL)
+  {
+    return;
+  }
+
+  // rasterize missing glyphs first, atlas might grow in the process
+  // so texture coordinates can only be computed after this
+  int quad_count = 0;
+  const char* p = text;
+  uint32_t codepoint = 0;
+  while ((codepoint = krr_utf8_next(&p)) != 0)
+  {
+    if (codepoint != '\n' && gl_lglyph_cache_get(cache, codepoint)->width > 0)
+    {
+      quad_count++;
+    }
+  }
+  if (quad_count == 0)
+  {
+    return;
+  }
+
+  ensure_batch_capacity_(cache, quad_count);
+
+  // build all quads relative to render position
+  LVertexData2D* vertex_data = malloc(quad_count * 4 * sizeof(LVertexData2D));
+  const GLfloat atlas_width = cache->atlas_width_;
+  const GLfloat atlas_height = cache->atlas_height_;
+  int pen_x = 0;
+  int baseline = cache->ascender;
+  int quad_index = 0;
+
+  p = text;
+  while ((codepoint = krr_utf8_next(&p)) != 0)
+  {
+    if (codepoint == '\n')
+    {
+      pen_x = 0;
+      baseline += cache->line_height;
+      continue;
+    }
+
+    // all glyphs are cached by now
+    const gl_lglyph* glyph = find_(cache, codepoint);
+    if (glyph->width > 0)
+    {
+      GLfloat quad_x = pen_x + glyph->bearing_x;
+      GLfloat quad_y = baseline - glyph->bearing_y;
+      GLfloat quad_w = glyph->width;
+      GLfloat quad_h = glyph->height;
+
+      GLfloat tex_left = glyph->atlas_x / atlas_width;
+      GLfloat tex_right = (glyph->atlas_x + glyph->width) / atlas_width;
+      GLfloat tex_top = glyph->atlas_y / atlas_height;
+      GLfloat tex_bottom = (glyph->atlas_y + glyph->height) / atlas_height;
+
+      LVertexData2D* v = vertex_data + quad_index * 4;
+      v[0].position.x = quad_x;           v[0].position.y = quad_y;
+      v[1].position.x = quad_x + quad_w;  v[1].position.y = quad_y;
+      v[2].position.x = quad_x + quad_w;  v[2].position.y = quad_y + quad_h;
+      v[3].position.x = quad_x;           v[3].position.y = quad_y + quad_h;
+
+      v[0].texcoord.s = tex_left;         v[0].texcoord.t = tex_top;
+      v[1].texcoord.s = tex_right;        v[1].texcoord.t = tex_top;
+      v[2].texcoord.s = tex_right;        v[2].texcoord.t = tex_bottom;
+      v[3].texcoord.s = tex_left;         v[3].texcoord.t = tex_bottom;
+
+      quad_index++;
+    }
+
+    pen_x += glyph->advance;
+  }
+
+  gl_lvertex_format_pack(BATCH_VERTEX_FORMAT, vertex_data, quad_count * 4, vertex_data);
+  glBindBuffer(GL_ARRAY_BUFFER, cache->VBO_id_);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, quad_count * 4 * gl_lvertex_format_stride(BATCH_VERTEX_FORMAT), vertex_data);
+  free(vertex_data);
+
+  // save original modelview matrix
+  mat4 original_modelview_matrix;
+  glm_mat4_copy(shared_font_shaderprogram->modelview_matrix, original_modelview_matrix);
+
+  // move to rendering position
+  glm_translate(shared_font_shaderprogram->modelview_matrix, (vec3){x, y, 0.f});
+  gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
+
+  glBindTexture(GL_TEXTURE_2D, cache->atlas->texture_id);
+  gl_lsampler_cache_bind(0, cache->atlas->sampler);
+
+  gl_lfont_polygon_program2d_enable_attrib_pointers(shared_font_shaderprogram);
+
+    gl_lfont_polygon_program2d_set_attrib_pointers(shared_font_shaderprogram, BATCH_VERTEX_FORMAT, NULL);
+
+    // draw whole text at once
+    gl_lvertex_format_draw_quads(0, quad_count);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  gl_lfont_polygon_program2d_disable_attrib_pointers(shared_font_shaderprogram);
+
+  // set modelview matrix back to original one
+  glm_mat4_copy(original_modelview_matrix, shared_font_shaderprogram->modelview_matrix);
+}
+
+LSize gl_lglyph_cache_get_string_area_size(gl_lglyph_cache* cache, const char* text)
+{
+  LSize area = {0.f, 0.f};
+  if (cache->face_ == NULL)
+  {
+    return area;
+  }
+
+  int line_width = 0;
+  area.h = cache->line_height;
+
+  uint32_t codepoint = 0;
+  while ((codepoint = krr_utf8_next(&text)) != 0)
+  {
+    if (codepoint == '\n')
+    {
+      if (line_width > area.w)
+      {
+        area.w = line_width;
+      }
+      line_width = 0;
+      area.h += cache->line_height;
+    }
+    else
+    {
+      line_width += gl_lglyph_cache_get(cache, codepoint)->advance;
+    }
+  }
+
+  if (line_width > area.w)
+  {
+    area.w = line_width;
+  }
+
+  return area;
+}
+
+void gl_lglyph_cache_print_stats(gl_lglyph_cache* cache)
+{
+  SDL_Log("Glyph cache: %d glyphs, atlas %dx%d (%d rows used), rasterized %u, atlas grows %u, uploaded %llu bytes",
+      cache->glyph_count_, cache->atlas_width_, cache->atlas_height_, cache->next_shelf_y_,
+      cache->stats.rasterized_glyphs, cache->stats.atlas_grows, cache->stats.uploaded_bytes);
+}
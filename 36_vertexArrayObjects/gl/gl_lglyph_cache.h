@@ -0,0 +1,181 @@
+#ifndef gl_lglyph_cache_h_
+#define gl_lglyph_cache_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LTexture.h"
+#include "foundation/vector.h"
+#include "ft2build.h"
+#include FT_FREETYPE_H
+#include <stdint.h>
+#include <stdbool.h>
+
+/// Glyph cache for FreeType font with on-demand rasterization.
+///
+/// Unlike gl_LFont which renders all 256 extended-ASCII glyphs up front into a fixed 16x16 grid,
+/// glyph cache rasterizes a glyph only when it's first used, then packs it tightly into
+/// a single 8-bit atlas page using shelf packing. Only the new glyph's region is uploaded to GPU.
+/// Atlas starts small and grows (up to GL_MAX_TEXTURE_SIZE) when it's full.
+/// Text is UTF-8 thus supports any Unicode code point that font has.
+/// Text is rendered with shared_font_shaderprogram in a single draw call.
+
+/// cached glyph
+typedef struct
+{
+  /// unicode code point
+  uint32_t codepoint;
+
+  /// position of glyph's bitmap in atlas in pixels
+  int atlas_x;
+  int atlas_y;
+  /// size of glyph's bitmap in pixels, zero for glyph without bitmap i.e. space
+  int width;
+  int height;
+
+  /// offset from pen position on baseline to left edge of bitmap
+  int bearing_x;
+  /// offset from baseline up to top edge of bitmap
+  int bearing_y;
+  /// horizontal distance to move pen to the next glyph
+  int advance;
+} gl_lglyph;
+
+/// rasterization and upload statistics
+typedef struct
+{
+  /// number of glyphs rasterized so far
+  unsigned int rasterized_glyphs;
+  /// number of times atlas grew
+  unsigned int atlas_grows;
+  /// total bytes uploaded to GPU including full re-upload when atlas grew
+  unsigned long long uploaded_bytes;
+} gl_lglyph_cache_stats;
+
+typedef struct
+{
+  /// (read-only) atlas texture in 8-bit single channel
+  gl_LTexture* atlas;
+
+  /// (read-only) pixel size font is loaded with
+  GLuint pixel_size;
+  /// (read-only) distance from baseline to top of the highest glyph
+  int ascender;
+  /// (read-only) distance from baseline to bottom of the lowest glyph, negative value
+  int descender;
+  /// (read-only) distance between baselines of consecutive lines
+  int line_height;
+
+  /// (read-only) statistics
+  gl_lglyph_cache_stats stats;
+
+  /// (internal use) freetype library and face kept alive for rasterization
+  FT_Library library_;
+  FT_Face face_;
+
+  /// (internal use) CPU copy of atlas pixels, source of sub-region uploads and re-upload when atlas grew
+  GLubyte* pixels_;
+  /// (internal use) atlas size in pixels
+  int atlas_width_;
+  int atlas_height_;
+  /// (internal use) maximum atlas size allowed by GPU
+  int max_atlas_size_;
+  /// (internal use) shelves of atlas, see gl_lglyph_cache.c
+  vector* shelves_;
+  /// (internal use) y position for next shelf
+  int next_shelf_y_;
+
+  /// (internal use) open-addressing hash table of glyphs keyed by code point
+  gl_lglyph* glyphs_;
+  /// (internal use) capacity of hash table, always power of two
+  int glyph_capacity_;
+  /// (internal use) number of glyphs in hash table
+  int glyph_count_;
+
+  /// (internal use) vertex buffer for batched rendering, drawn from shared quad index buffer
+  GLuint VBO_id_;
+  /// (internal use) number of quads vertex buffer can hold
+  int batch_capacity_;
+} gl_lglyph_cache;
+
+///
+/// Create a new glyph cache.
+///
+/// \return Newly created gl_lglyph_cache on heap.
+///
+extern gl_lglyph_cache* gl_lglyph_cache_new();
+
+///
+/// Free glyph cache.
+///
+/// \param cache Pointer to gl_lglyph_cache
+///
+extern void gl_lglyph_cache_free(gl_lglyph_cache* cache);
+
+///
+/// Load FreeType font.
+/// No glyph is rasterized at this point.
+///
+/// \param cache Pointer to gl_lglyph_cache
+/// \param path Path to TTF file
+/// \param pixel_size Pixel size of font
+/// \return True if successfully load, otherwise return false.
+///
+extern bool gl_lglyph_cache_load(gl_lglyph_cache* cache, const char* path, GLuint pixel_size);
+
+///
+/// Load FreeType font from TTF file's content in memory i.e. memory-mapped asset pack.
+/// Memory must stay valid until cache is freed, or loaded with another font.
+///
+/// \param cache Pointer to gl_lglyph_cache
+/// \param data Pointer to TTF file's content
+/// \param size Size of data in bytes
+/// \param pixel_size Pixel size of font
+/// \return True if successfully load, otherwise return false.
+///
+extern bool gl_lglyph_cache_load_from_memory(gl_lglyph_cache* cache, const void* data, size_t size, GLuint pixel_size);
+
+///
+/// Get glyph of code point, rasterize and upload it to atlas if it's not cached yet.
+/// Returned pointer is valid until the next glyph is rasterized.
+///
+/// \param cache Pointer to gl_lglyph_cache
+/// \param codepoint Unicode code point
+/// \return Pointer to glyph, or NULL if it cannot be rasterized.
+///
+extern const gl_lglyph* gl_lglyph_cache_get(gl_lglyph_cache* cache, uint32_t codepoint);
+
+///
+/// Rasterize all glyphs used by text ahead of time i.e. during loading screen to avoid hitches later.
+///
+/// \param cache Pointer to gl_lglyph_cache
+/// \param text UTF-8 text
+///
+extern void gl_lglyph_cache_warm(gl_lglyph_cache* cache, const char* text);
+
+///
+/// Render text.
+/// Glyphs not yet cached will be rasterized first.
+///
+/// \param cache Pointer to gl_lglyph_cache
+/// \param text UTF-8 text, '\n' starts a new line
+/// \param x Position x to render. Origin is at top-left.
+/// \param y Position y to render. Origin is at top-left.
+///
+extern void gl_lglyph_cache_render_text(gl_lglyph_cache* cache, const char* text, GLfloat x, GLfloat y);
+
+///
+/// Get rendering area size for input text.
+///
+/// \param cache Pointer to gl_lglyph_cache
+/// \param text UTF-8 text
+/// \return Area in LSize covering the rendering size
+///
+extern LSize gl_lglyph_cache_get_string_area_size(gl_lglyph_cache* cache, const char* text);
+
+///
+/// Print statistics via SDL_Log.
+///
+/// \param cache Pointer to gl_lglyph_cache
+///
+extern void gl_lglyph_cache_print_stats(gl_lglyph_cache* cache);
+
+#endif
@@ -0,0 +1,180 @@
+#include "gl_lglyph_run.h"
+#include "gl/gl_lfont_instanced_program2d.h"
+#include "gl/gl_ltext_layout.h"
+#include "gl/gl_ltexture_manager_internals.h"
+#include "gl/gl_lsampler_cache.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+#include <stddef.h>
+
+// initial number of instances to allocate for
+#define INITIAL_CAPACITY 64
+
+static void init_defaults_(gl_lglyph_run* run);
+static void reserve_(gl_lglyph_run* run, int count);
+static void setup_vertex_array_(gl_lglyph_run* run);
+
+void init_defaults_(gl_lglyph_run* run)
+{
+  run->atlas = NULL;
+  run->instances = NULL;
+  run->instance_count = 0;
+  run->capacity_ = 0;
+  run->VAO_id_ = 0;
+  run->VBO_id_ = 0;
+  run->buffer_capacity_ = 0;
+}
+
+void reserve_(gl_lglyph_run* run, int count)
+{
+  if (count <= run->capacity_)
+  {
+    return;
+  }
+
+  int capacity = run->capacity_ > 0 ? run->capacity_ : INITIAL_CAPACITY;
+  while (capacity < count)
+  {
+    capacity *= 2;
+  }
+  run->instances = realloc(run->instances, capacity * sizeof(gl_lglyph_instance));
+  run->capacity_ = capacity;
+}
+
+void setup_vertex_array_(gl_lglyph_run* run)
+{
+  glGenVertexArrays(1, &run->VAO_id_);
+  glGenBuffers(1, &run->VBO_id_);
+
+  // attribute pointers are recorded into vertex array object once
+  // instance buffer keeps its name even when it's reallocated
+  glBindVertexArray(run->VAO_id_);
+  glBindBuffer(GL_ARRAY_BUFFER, run->VBO_id_);
+
+  const GLsizei stride = sizeof(gl_lglyph_instance);
+  glEnableVertexAttribArray(gl_lfont_instanced_program2d_GLYPH_RECT_LOCATION);
+  glVertexAttribPointer(gl_lfont_instanced_program2d_GLYPH_RECT_LOCATION, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(gl_lglyph_instance, x));
+  glVertexAttribDivisor(gl_lfont_instanced_program2d_GLYPH_RECT_LOCATION, 1);
+
+  glEnableVertexAttribArray(gl_lfont_instanced_program2d_GLYPH_TEXRECT_LOCATION);
+  glVertexAttribPointer(gl_lfont_instanced_program2d_GLYPH_TEXRECT_LOCATION, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(gl_lglyph_instance, s));
+  glVertexAttribDivisor(gl_lfont_instanced_program2d_GLYPH_TEXRECT_LOCATION, 1);
+
+  glEnableVertexAttribArray(gl_lfont_instanced_program2d_GLYPH_COLOR_LOCATION);
+  glVertexAttribPointer(gl_lfont_instanced_program2d_GLYPH_COLOR_LOCATION, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(gl_lglyph_instance, color));
+  glVertexAttribDivisor(gl_lfont_instanced_program2d_GLYPH_COLOR_LOCATION, 1);
+
+  glEnableVertexAttribArray(gl_lfont_instanced_program2d_GLYPH_TRANSFORM_LOCATION);
+  glVertexAttribPointer(gl_lfont_instanced_program2d_GLYPH_TRANSFORM_LOCATION, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(gl_lglyph_instance, rotation));
+  glVertexAttribDivisor(gl_lfont_instanced_program2d_GLYPH_TRANSFORM_LOCATION, 1);
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+gl_lglyph_run* gl_lglyph_run_new()
+{
+  gl_lglyph_run* out = malloc(sizeof(gl_lglyph_run));
+  init_defaults_(out);
+  return out;
+}
+
+void gl_lglyph_run_free(gl_lglyph_run* run)
+{
+  if (run->VBO_id_ != 0)
+  {
+    glDeleteBuffers(1, &run->VBO_id_);
+  }
+  if (run->VAO_id_ != 0)
+  {
+    glDeleteVertexArrays(1, &run->VAO_id_);
+  }
+  free(run->instances);
+
+  free(run);
+  run = NULL;
+}
+
+void gl_lglyph_run_clear(gl_lglyph_run* run)
+{
+  run->instance_count = 0;
+  run->atlas = NULL;
+}
+
+int gl_lglyph_run_add_text(gl_lglyph_run* run, gl_LFont* font, const char* text, GLfloat x, GLfloat y, const LSize* area_size, int align, LColorRGBA color)
+{
+  gl_LTexture* atlas = font->spritesheet->ltexture;
+  if (run->atlas != NULL && run->atlas != atlas)
+  {
+    SDL_Log("Font's atlas differs from glyphs already in run");
+    return -1;
+  }
+  run->atlas = atlas;
+
+  const gl_ltext_layout* layout = gl_ltext_layout_get(font, text, area_size, align);
+  const int first = run->instance_count;
+  reserve_(run, first + layout->glyph_count);
+
+  const GLfloat texture_pwidth = atlas->physical_width_;
+  const GLfloat texture_pheight = atlas->physical_height_;
+
+  for (int i=0; i<layout->glyph_count; i++)
+  {
+    const gl_ltext_layout_glyph* glyph = &layout->glyphs[i];
+    const LRect* clip = vector_get(font->spritesheet->clips, glyph->glyph);
+    gl_lglyph_instance* instance = &run->instances[first + i];
+
+    // glyph's padding (if any) lies before its visible content
+    instance->x = x + glyph->x - font->padding;
+    instance->y = y + glyph->y - font->padding;
+    instance->w = clip->w;
+    instance->h = clip->h;
+
+    // half-texel inset the same as spritesheet's vertex data
+    instance->s = clip->x/texture_pwidth + 0.5f/texture_pwidth;
+    instance->t = clip->y/texture_pheight + 0.5f/texture_pheight;
+    instance->tw = (clip->w - 1.f)/texture_pwidth;
+    instance->th = (clip->h - 1.f)/texture_pheight;
+
+    instance->color = color;
+    instance->rotation = 0.f;
+    instance->scale = 1.f;
+  }
+  run->instance_count += layout->glyph_count;
+
+  return first;
+}
+
+void gl_lglyph_run_render(gl_lglyph_run* run)
+{
+  if (run->instance_count == 0 || run->atlas == NULL || run->atlas->texture_id == 0)
+  {
+    return;
+  }
+
+  if (run->VAO_id_ == 0)
+  {
+    setup_vertex_array_(run);
+  }
+
+  // mark as used for texture manager
+  gl_ltexture_manager_touch(run->atlas);
+  glBindTexture(GL_TEXTURE_2D, run->atlas->texture_id);
+  gl_lsampler_cache_bind(0, run->atlas->sampler);
+
+  // upload instance records
+  glBindBuffer(GL_ARRAY_BUFFER, run->VBO_id_);
+  if (run->instance_count > run->buffer_capacity_)
+  {
+    run->buffer_capacity_ = run->capacity_;
+  }
+  // orphan previous storage so driver doesn't wait for the previous draw still reading from it
+  glBufferData(GL_ARRAY_BUFFER, run->buffer_capacity_ * sizeof(gl_lglyph_instance), NULL, GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, run->instance_count * sizeof(gl_lglyph_instance), run->instances);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  // each instance is a quad of triangle strip generated in vertex shader
+  glBindVertexArray(run->VAO_id_);
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, run->instance_count);
+  glBindVertexArray(0);
+}
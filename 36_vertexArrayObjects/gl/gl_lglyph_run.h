@@ -0,0 +1,106 @@
+#ifndef gl_lglyph_run_h_
+#define gl_lglyph_run_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LFont.h"
+
+/// Glyph run for rendering rich text in a single instanced draw call.
+///
+/// Each glyph is an instance record with its own quad, atlas rect, color, rotation and scale.
+/// Add text in spans of different color (and font sizes sharing the same atlas page, see gl_lfont_registry),
+/// then tweak instance records freely per frame i.e. to wobble, or fade individual glyphs.
+/// Whole run renders with gl_lfont_instanced_program2d in one draw call without matrix nor uniform
+/// update per glyph.
+///
+/// All glyphs in a run must come from the same atlas texture.
+
+/// per-glyph instance record as laid out in GPU buffer
+typedef struct
+{
+  /// position of glyph's quad top-left in pixels
+  GLfloat x;
+  GLfloat y;
+  /// size of glyph's quad in pixels
+  GLfloat w;
+  GLfloat h;
+  /// glyph's rect in atlas in texture coordinate
+  GLfloat s;
+  GLfloat t;
+  GLfloat tw;
+  GLfloat th;
+  /// glyph's color
+  LColorRGBA color;
+  /// rotation in radians around glyph's center
+  GLfloat rotation;
+  /// scale around glyph's center
+  GLfloat scale;
+} gl_lglyph_instance;
+
+typedef struct
+{
+  /// (read-only) atlas texture all glyphs are from, NULL if run is empty
+  gl_LTexture* atlas;
+
+  /// instance records of glyphs, they can be modified before rendering
+  gl_lglyph_instance* instances;
+  /// (read-only) number of glyphs in run
+  int instance_count;
+
+  /// (internal use) capacity of instances
+  int capacity_;
+  /// (internal use) vertex array object, and instance buffer
+  GLuint VAO_id_;
+  GLuint VBO_id_;
+  /// (internal use) number of instances instance buffer can hold
+  int buffer_capacity_;
+} gl_lglyph_run;
+
+///
+/// Create a new glyph run.
+///
+/// \return Newly created gl_lglyph_run on heap.
+///
+extern gl_lglyph_run* gl_lglyph_run_new();
+
+///
+/// Free glyph run, and its GPU buffers.
+///
+/// \param run Pointer to gl_lglyph_run
+///
+extern void gl_lglyph_run_free(gl_lglyph_run* run);
+
+///
+/// Remove all glyphs from run.
+/// Memory is kept for reuse.
+///
+/// \param run Pointer to gl_lglyph_run
+///
+extern void gl_lglyph_run_clear(gl_lglyph_run* run);
+
+///
+/// Lay out text then append its glyphs to run.
+/// Glyphs are appended in text's order with rotation of 0, and scale of 1.
+///
+/// \param run Pointer to gl_lglyph_run
+/// \param font Font to lay out text with, its atlas must be the same as of glyphs already in run
+/// \param text Null-terminated UTF-8 text
+/// \param x Position x to render text at
+/// \param y Position y to render text at
+/// \param area_size Area size to wrap, and align text within it. It can be NULL for no wrapping, nor alignment.
+/// \param align Alignment to align text within the given area. See gl_LFont_TextAlignment.
+/// \param color Color of all glyphs of text
+/// \return Index of the first appended instance, or -1 if font's atlas differs from run's.
+///
+extern int gl_lglyph_run_add_text(gl_lglyph_run* run, gl_LFont* font, const char* text, GLfloat x, GLfloat y, const LSize* area_size, int align, LColorRGBA color);
+
+///
+/// Render all glyphs of run in a single instanced draw call.
+/// Instance records are uploaded every call, so changes made to them since the last call take effect.
+/// Program loaded by gl_lfont_instanced_program2d_load_program() should be bound with its matrices,
+/// and texture sampler set. Run binds its own vertex array object, then unbinds it when done.
+///
+/// \param run Pointer to gl_lglyph_run
+///
+extern void gl_lglyph_run_render(gl_lglyph_run* run);
+
+#endif
@@ -0,0 +1,280 @@
+#include "gl_lprogram.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void free_tables_(gl_lprogram* program);
+static char* copy_name_(const GLchar* name, GLsizei length);
+static void reflect_(void* user_data);
+static gl_lprogram_uniform* changed_uniform_(gl_lprogram* program, int index, const void* value, size_t bytes);
+
+void free_tables_(gl_lprogram* program)
+{
+  for (int i=0; i<program->uniform_count; i++)
+  {
+    free(program->uniforms[i].name);
+  }
+  free(program->uniforms);
+  program->uniforms = NULL;
+  program->uniform_count = 0;
+
+  for (int i=0; i<program->attrib_count; i++)
+  {
+    free(program->attribs[i].name);
+  }
+  free(program->attribs);
+  program->attribs = NULL;
+  program->attrib_count = 0;
+}
+
+char* copy_name_(const GLchar* name, GLsizei length)
+{
+  // uniform array is reported as its first element
+  if (length > 3 && strcmp(name + length - 3, "[0]") == 0)
+  {
+    length -= 3;
+  }
+
+  char* out = malloc(length + 1);
+  memcpy(out, name, length);
+  out[length] = '\0';
+  return out;
+}
+
+void reflect_(void* user_data)
+{
+  gl_lprogram* program = user_data;
+  GLuint program_id = program->program->program_id;
+
+  // tables of previous link (if any) are no longer valid
+  free_tables_(program);
+
+  GLint max_length = 0;
+  GLint count = 0;
+  GLsizei length = 0;
+
+  glGetProgramiv(program_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+  glGetProgramiv(program_id, GL_ACTIVE_UNIFORMS, &count);
+  GLchar* name = malloc(max_length + 1);
+
+  program->uniforms = malloc(count * sizeof(gl_lprogram_uniform) + 1);
+  for (GLint i=0; i<count; i++)
+  {
+    GLint size = 0;
+    GLenum type = 0;
+    glGetActiveUniform(program_id, i, max_length + 1, &length, &size, &type, name);
+
+    // members of uniform block have no location
+    GLint location = glGetUniformLocation(program_id, name);
+    if (location == -1)
+    {
+      continue;
+    }
+
+    gl_lprogram_uniform* uniform = &program->uniforms[program->uniform_count++];
+    uniform->name = copy_name_(name, length);
+    uniform->location = location;
+    uniform->type = type;
+    uniform->size = size;
+    uniform->has_value_ = false;
+  }
+  free(name);
+
+  glGetProgramiv(program_id, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_length);
+  glGetProgramiv(program_id, GL_ACTIVE_ATTRIBUTES, &count);
+  name = malloc(max_length + 1);
+
+  program->attribs = malloc(count * sizeof(gl_lprogram_attrib) + 1);
+  for (GLint i=0; i<count; i++)
+  {
+    GLint size = 0;
+    GLenum type = 0;
+    glGetActiveAttrib(program_id, i, max_length + 1, &length, &size, &type, name);
+
+    // built-in i.e. gl_VertexID has no location
+    GLint location = glGetAttribLocation(program_id, name);
+    if (location == -1)
+    {
+      continue;
+    }
+
+    gl_lprogram_attrib* attrib = &program->attribs[program->attrib_count++];
+    attrib->name = copy_name_(name, length);
+    attrib->location = location;
+    attrib->type = type;
+  }
+  free(name);
+}
+
+gl_lprogram_uniform* changed_uniform_(gl_lprogram* program, int index, const void* value, size_t bytes)
+{
+  if (index < 0 || index >= program->uniform_count)
+  {
+    return NULL;
+  }
+
+  gl_lprogram_uniform* uniform = &program->uniforms[index];
+  if (uniform->has_value_ && memcmp(uniform->value_, value, bytes) == 0)
+  {
+    program->uniform_skips++;
+    return NULL;
+  }
+
+  memcpy(uniform->value_, value, bytes);
+  uniform->has_value_ = true;
+  program->uniform_uploads++;
+  return uniform;
+}
+
+gl_lprogram* gl_lprogram_new()
+{
+  gl_lprogram* out = malloc(sizeof(gl_lprogram));
+
+  // init defaults first
+  out->uniforms = NULL;
+  out->uniform_count = 0;
+  out->attribs = NULL;
+  out->attrib_count = 0;
+  out->uniform_uploads = 0;
+  out->uniform_skips = 0;
+
+  // create underlying shader program
+  // we will take care of this automatically when freeing
+  out->program = gl_LShaderProgram_new();
+
+  return out;
+}
+
+void gl_lprogram_free(gl_lprogram* program)
+{
+  free_tables_(program);
+
+  // free underlying shader program
+  gl_LShaderProgram_free(program->program);
+  program->program = NULL;
+
+  free(program);
+  program = NULL;
+}
+
+bool gl_lprogram_load_program(gl_lprogram* program, const char* vertex_shader_path, const char* fragment_shader_path, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count)
+{
+  // build program, restored from binary cache if available
+  // tables are filled once it's linked
+  return gl_LShaderProgram_build_program(program->program, vertex_shader_path, fragment_shader_path, attrib_locations, attrib_location_count, reflect_, program);
+}
+
+bool gl_lprogram_load_program_with_defines(gl_lprogram* program, const char* vertex_shader_path, const char* fragment_shader_path, const char* const* defines, int define_count, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count)
+{
+  return gl_LShaderProgram_build_program_with_defines(program->program, vertex_shader_path, fragment_shader_path, defines, define_count, attrib_locations, attrib_location_count, reflect_, program);
+}
+
+int gl_lprogram_uniform_index(gl_lprogram* program, const char* name)
+{
+  for (int i=0; i<program->uniform_count; i++)
+  {
+    if (strcmp(program->uniforms[i].name, name) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+GLint gl_lprogram_attrib_location(gl_lprogram* program, const char* name)
+{
+  for (int i=0; i<program->attrib_count; i++)
+  {
+    if (strcmp(program->attribs[i].name, name) == 0)
+    {
+      return program->attribs[i].location;
+    }
+  }
+  return -1;
+}
+
+void gl_lprogram_set_int(gl_lprogram* program, int index, GLint value)
+{
+  gl_lprogram_uniform* uniform = changed_uniform_(program, index, &value, sizeof(GLint));
+  if (uniform != NULL)
+  {
+    glUniform1i(uniform->location, value);
+  }
+}
+
+void gl_lprogram_set_float(gl_lprogram* program, int index, GLfloat value)
+{
+  gl_lprogram_uniform* uniform = changed_uniform_(program, index, &value, sizeof(GLfloat));
+  if (uniform != NULL)
+  {
+    glUniform1f(uniform->location, value);
+  }
+}
+
+void gl_lprogram_set_vec2(gl_lprogram* program, int index, vec2 value)
+{
+  gl_lprogram_uniform* uniform = changed_uniform_(program, index, value, sizeof(vec2));
+  if (uniform != NULL)
+  {
+    glUniform2fv(uniform->location, 1, value);
+  }
+}
+
+void gl_lprogram_set_vec4(gl_lprogram* program, int index, vec4 value)
+{
+  gl_lprogram_uniform* uniform = changed_uniform_(program, index, value, sizeof(vec4));
+  if (uniform != NULL)
+  {
+    glUniform4fv(uniform->location, 1, value);
+  }
+}
+
+void gl_lprogram_set_mat4(gl_lprogram* program, int index, mat4 value)
+{
+  gl_lprogram_uniform* uniform = changed_uniform_(program, index, value, sizeof(mat4));
+  if (uniform != NULL)
+  {
+    glUniformMatrix4fv(uniform->location, 1, GL_FALSE, value[0]);
+  }
+}
+
+GLuint gl_lprogram_create_vertex_array(gl_lprogram* program, const gl_lprogram_vertex_attrib* layout, int count, GLuint index_buffer)
+{
+  GLuint vao = 0;
+  glGenVertexArrays(1, &vao);
+  glBindVertexArray(vao);
+
+  for (int i=0; i<count; i++)
+  {
+    const gl_lprogram_vertex_attrib* attrib = &layout[i];
+    GLint location = gl_lprogram_attrib_location(program, attrib->name);
+    if (location == -1)
+    {
+      SDL_Log("Warning: %s is not an active attribute, skipped", attrib->name);
+      continue;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, attrib->buffer);
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(location, attrib->size, attrib->type, attrib->normalized, attrib->stride, (const GLvoid*)attrib->offset);
+    if (attrib->divisor != 0)
+    {
+      glVertexAttribDivisor(location, attrib->divisor);
+    }
+  }
+
+  // element array buffer binding is part of vertex array object's state
+  if (index_buffer != 0)
+  {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+  }
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  if (index_buffer != 0)
+  {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  }
+
+  return vao;
+}
@@ -0,0 +1,178 @@
+#ifndef gl_lprogram_h_
+#define gl_lprogram_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LShaderProgram.h"
+#include <stddef.h>
+
+/// Generic shader program driven by reflection.
+///
+/// Once linked, active uniforms and attributes are reflected into flat tables. Uniform is then
+/// addressed by its index in table, looked up by name once at setup time, and set through typed
+/// setters which keep the last uploaded value, so setting the same value again costs no GL call.
+///
+/// Vertex array object is created from a declared vertex layout whose attributes are resolved
+/// by name, thus new program needs neither its own struct, nor location lookup, nor attribute
+/// pointer code.
+///
+/// Uniforms in uniform blocks (i.e. FrameConstants, see gl_lframe_constants) are not in table.
+
+/// reflected active uniform
+typedef struct
+{
+  /// name as in shader code, "[0]" suffix of array is removed
+  char* name;
+  /// location
+  GLint location;
+  /// type i.e. GL_FLOAT_MAT4
+  GLenum type;
+  /// number of elements, 1 if not an array
+  GLint size;
+
+  /// (internal use) last value uploaded, valid if has_value_ is true
+  GLfloat value_[16];
+  bool has_value_;
+} gl_lprogram_uniform;
+
+/// reflected active attribute
+typedef struct
+{
+  /// name as in shader code
+  char* name;
+  /// location
+  GLint location;
+  /// type i.e. GL_FLOAT_VEC2
+  GLenum type;
+} gl_lprogram_attrib;
+
+/// declaration of a single attribute of vertex layout
+typedef struct
+{
+  /// attribute name in vertex shader
+  const char* name;
+  /// buffer to source attribute from
+  GLuint buffer;
+  /// number of components
+  GLint size;
+  /// component type i.e. GL_FLOAT
+  GLenum type;
+  /// whether integer components are normalized
+  GLboolean normalized;
+  /// byte spaces til next element, 0 for tightly packed
+  GLsizei stride;
+  /// byte offset of first element in buffer
+  size_t offset;
+  /// 0 to advance per vertex, otherwise per this number of instances
+  GLuint divisor;
+} gl_lprogram_vertex_attrib;
+
+typedef struct
+{
+  /// underlying shader program
+  gl_LShaderProgram* program;
+
+  /// (read-only) active uniforms
+  gl_lprogram_uniform* uniforms;
+  int uniform_count;
+
+  /// (read-only) active attributes
+  gl_lprogram_attrib* attribs;
+  int attrib_count;
+
+  /// (read-only) uniform uploads issued, and skipped as value didn't change
+  unsigned int uniform_uploads;
+  unsigned int uniform_skips;
+} gl_lprogram;
+
+///
+/// Create a new generic program.
+/// It will also create underlying gl_LShaderProgram and manage it automatically for its memory deallocation.
+///
+/// \return Newly created gl_lprogram on heap.
+///
+extern gl_lprogram* gl_lprogram_new();
+
+///
+/// Free generic program.
+///
+/// \param program Pointer to gl_lprogram
+///
+extern void gl_lprogram_free(gl_lprogram* program);
+
+///
+/// Build program from vertex, and fragment shader files then reflect its uniforms, and attributes.
+/// See gl_LShaderProgram_build_program() for binary cache, and batching. Tables are empty until
+/// program is linked.
+///
+/// \param program Pointer to gl_lprogram
+/// \param vertex_shader_path Path to vertex shader file
+/// \param fragment_shader_path Path to fragment shader file
+/// \param attrib_locations Attributes to bind to fixed locations before linking. It can be NULL.
+/// \param attrib_location_count Number of attribute locations
+/// \return True if program is built, or submitted successfully, otherwise return false.
+///
+extern bool gl_lprogram_load_program(gl_lprogram* program, const char* vertex_shader_path, const char* fragment_shader_path, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count);
+
+///
+/// Build program the same as gl_lprogram_load_program() but specialized with defines
+/// (see gl_LShaderProgram_build_program_with_defines()).
+///
+/// \param program Pointer to gl_lprogram
+/// \param vertex_shader_path Path to vertex shader file
+/// \param fragment_shader_path Path to fragment shader file
+/// \param defines Defines to inject, each either "NAME", or "NAME=VALUE". It can be NULL.
+/// \param define_count Number of defines
+/// \param attrib_locations Attributes to bind to fixed locations before linking. It can be NULL.
+/// \param attrib_location_count Number of attribute locations
+/// \return True if program is built, or submitted successfully, otherwise return false.
+///
+extern bool gl_lprogram_load_program_with_defines(gl_lprogram* program, const char* vertex_shader_path, const char* fragment_shader_path, const char* const* defines, int define_count, const gl_LShaderProgram_attrib_location* attrib_locations, int attrib_location_count);
+
+///
+/// Find uniform by name.
+/// Look it up once then keep its index.
+///
+/// \param program Pointer to gl_lprogram
+/// \param name Uniform name
+/// \return Index into program's uniforms, or -1 if it's not an active uniform.
+///
+extern int gl_lprogram_uniform_index(gl_lprogram* program, const char* name);
+
+///
+/// Find attribute location by name.
+///
+/// \param program Pointer to gl_lprogram
+/// \param name Attribute name
+/// \return Attribute location, or -1 if it's not an active attribute.
+///
+extern GLint gl_lprogram_attrib_location(gl_lprogram* program, const char* name);
+
+///
+/// Set uniform value.
+/// Program must be bound. Upload is skipped if value is the same as the last one set.
+/// Index of -1 is silently ignored as of uniform location of -1.
+///
+/// \param program Pointer to gl_lprogram
+/// \param index Uniform index as returned from gl_lprogram_uniform_index()
+/// \param value Value to set
+///
+extern void gl_lprogram_set_int(gl_lprogram* program, int index, GLint value);
+extern void gl_lprogram_set_float(gl_lprogram* program, int index, GLfloat value);
+extern void gl_lprogram_set_vec2(gl_lprogram* program, int index, vec2 value);
+extern void gl_lprogram_set_vec4(gl_lprogram* program, int index, vec4 value);
+extern void gl_lprogram_set_mat4(gl_lprogram* program, int index, mat4 value);
+
+///
+/// Create vertex array object from vertex layout.
+/// Attributes are resolved by name against program, those not active in program are skipped with a warning.
+/// Resulting vertex array object works with any program having the same attribute locations.
+///
+/// \param program Pointer to gl_lprogram, it must be linked
+/// \param layout Attributes of vertex layout
+/// \param count Number of attributes
+/// \param index_buffer Element array buffer to record into vertex array object, 0 for none
+/// \return Vertex array object, caller owns it.
+///
+extern GLuint gl_lprogram_create_vertex_array(gl_lprogram* program, const gl_lprogram_vertex_attrib* layout, int count, GLuint index_buffer);
+
+#endif
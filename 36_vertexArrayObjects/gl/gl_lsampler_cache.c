@@ -0,0 +1,137 @@
+#include "gl_lsampler_cache.h"
+#include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "foundation/vector.h"
+#include "SDL_log.h"
+#include <string.h>
+
+// units tracked for redundant bind, binds to units beyond are always issued
+#define MAX_TRACKED_UNITS 16
+
+typedef struct
+{
+  gl_lsampler_desc desc;
+  GLuint sampler;
+} sampler_entry_;
+
+const gl_lsampler_desc gl_lsampler_desc_default = { GL_LINEAR, GL_LINEAR, GL_REPEAT, GL_REPEAT, 1.0f };
+const gl_lsampler_desc gl_lsampler_desc_clamp_to_border = { GL_LINEAR, GL_LINEAR, GL_CLAMP_TO_BORDER, GL_CLAMP_TO_BORDER, 1.0f };
+
+static vector* entries_ = NULL;
+static GLuint bound_[MAX_TRACKED_UNITS];
+static gl_lsampler_cache_stats stats_ = { 0, 0, 0 };
+
+static bool same_desc_(const gl_lsampler_desc* a, const gl_lsampler_desc* b);
+static GLfloat supported_anisotropy_(GLfloat requested);
+
+bool same_desc_(const gl_lsampler_desc* a, const gl_lsampler_desc* b)
+{
+  return a->min_filter == b->min_filter &&
+    a->mag_filter == b->mag_filter &&
+    a->wrap_s == b->wrap_s &&
+    a->wrap_t == b->wrap_t &&
+    a->max_anisotropy == b->max_anisotropy;
+}
+
+GLfloat supported_anisotropy_(GLfloat requested)
+{
+  if (requested <= 1.0f || !(GLEW_EXT_texture_filter_anisotropic || GLEW_ARB_texture_filter_anisotropic))
+  {
+    return 1.0f;
+  }
+
+  GLfloat max_supported = 1.0f;
+  glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &max_supported);
+  return requested < max_supported ? requested : max_supported;
+}
+
+GLuint gl_lsampler_cache_get(const gl_lsampler_desc* desc)
+{
+  if (entries_ == NULL)
+  {
+    entries_ = vector_new(8, sizeof(sampler_entry_));
+  }
+
+  for (int i=0; i<entries_->len; i++)
+  {
+    sampler_entry_* entry = vector_get(entries_, i);
+    if (same_desc_(&entry->desc, desc))
+    {
+      return entry->sampler;
+    }
+  }
+
+  // first request of this combination
+  sampler_entry_ entry;
+  entry.desc = *desc;
+  glGenSamplers(1, &entry.sampler);
+  glSamplerParameteri(entry.sampler, GL_TEXTURE_MIN_FILTER, desc->min_filter);
+  glSamplerParameteri(entry.sampler, GL_TEXTURE_MAG_FILTER, desc->mag_filter);
+  glSamplerParameteri(entry.sampler, GL_TEXTURE_WRAP_S, desc->wrap_s);
+  glSamplerParameteri(entry.sampler, GL_TEXTURE_WRAP_T, desc->wrap_t);
+
+  const GLfloat anisotropy = supported_anisotropy_(desc->max_anisotropy);
+  if (anisotropy > 1.0f)
+  {
+    glSamplerParameterf(entry.sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy);
+  }
+
+  GLenum error = GL_LDEBUG_GET_ERROR();
+  if (error != GL_NO_ERROR)
+  {
+    SDL_Log("Error creating sampler: %s", gl_util_error_string(error));
+    glDeleteSamplers(1, &entry.sampler);
+    return 0;
+  }
+
+  vector_add(entries_, &entry);
+  stats_.samplers++;
+
+  return entry.sampler;
+}
+
+void gl_lsampler_cache_bind(GLuint unit, GLuint sampler)
+{
+  if (unit < MAX_TRACKED_UNITS)
+  {
+    if (bound_[unit] == sampler)
+    {
+      stats_.skipped_binds++;
+      return;
+    }
+    bound_[unit] = sampler;
+  }
+
+  glBindSampler(unit, sampler);
+  stats_.binds++;
+}
+
+gl_lsampler_cache_stats gl_lsampler_cache_get_stats()
+{
+  return stats_;
+}
+
+void gl_lsampler_cache_free()
+{
+  if (entries_ == NULL)
+  {
+    return;
+  }
+
+  for (int i=0; i<MAX_TRACKED_UNITS; i++)
+  {
+    if (bound_[i] != 0)
+    {
+      glBindSampler(i, 0);
+      bound_[i] = 0;
+    }
+  }
+
+  for (int i=0; i<entries_->len; i++)
+  {
+    sampler_entry_* entry = vector_get(entries_, i);
+    glDeleteSamplers(1, &entry->sampler);
+  }
+  vector_free(entries_);
+  entries_ = NULL;
+}
@@ -0,0 +1,84 @@
+#ifndef gl_lsampler_cache_h_
+#define gl_lsampler_cache_h_
+
+#include "gl/glLOpenGL.h"
+#include <stdbool.h>
+
+/// Sampler objects shared across textures.
+///
+/// Filtering, and wrapping are kept in sampler objects rather than set on each texture. Samplers
+/// are created on first request for a combination of parameters, and reused by all textures
+/// requesting the same, so there's only a handful of them.
+///
+/// Texture keeps the sampler to use (see gl_LTexture's sampler), which is bound to texture unit at
+/// draw time along with texture. Binding is skipped if unit already has it, which is the common case
+/// as most textures share the same sampler. Changing filtering of a texture is then just swapping its
+/// sampler, without binding the texture, nor issuing any GL call.
+///
+/// Sampler bound to a unit overrides filtering, and wrapping of whatever texture is bound to it, but
+/// not its mipmap levels (GL_TEXTURE_MAX_LEVEL) which are still texture's own.
+
+/// parameters of sampler, also its key in cache
+typedef struct
+{
+  /// i.e. GL_LINEAR, or GL_LINEAR_MIPMAP_LINEAR
+  GLenum min_filter;
+  /// i.e. GL_LINEAR
+  GLenum mag_filter;
+  /// i.e. GL_REPEAT
+  GLenum wrap_s;
+  GLenum wrap_t;
+  /// 1.0 for no anisotropic filtering. It's clamped to what's supported, and ignored if not supported at all.
+  GLfloat max_anisotropy;
+} gl_lsampler_desc;
+
+/// counters for diagnostics
+typedef struct
+{
+  /// number of sampler objects created
+  unsigned int samplers;
+  /// number of glBindSampler() calls issued
+  unsigned int binds;
+  /// number of binds skipped as unit already had the sampler
+  unsigned int skipped_binds;
+} gl_lsampler_cache_stats;
+
+/// linear filtering, repeat wrapping, no mipmaps
+extern const gl_lsampler_desc gl_lsampler_desc_default;
+
+/// linear filtering, clamp to transparent border, no mipmaps. For glyph atlases.
+extern const gl_lsampler_desc gl_lsampler_desc_clamp_to_border;
+
+///
+/// Get sampler object for parameters, create it on first request.
+/// Returned sampler is owned by cache, don't delete it.
+///
+/// \param desc Sampler parameters
+/// \return Sampler object, or 0 if it cannot be created.
+///
+extern GLuint gl_lsampler_cache_get(const gl_lsampler_desc* desc);
+
+///
+/// Bind sampler to texture unit.
+/// It's skipped if unit already has the sampler bound through this function.
+/// Don't call glBindSampler() directly, or bound state tracked here will be stale.
+///
+/// \param unit Texture unit index, 0 for GL_TEXTURE0
+/// \param sampler Sampler object, 0 to use texture's own parameters
+///
+extern void gl_lsampler_cache_bind(GLuint unit, GLuint sampler);
+
+///
+/// Get counters of sampler creation, and binds.
+///
+/// \return Statistics
+///
+extern gl_lsampler_cache_stats gl_lsampler_cache_get_stats();
+
+///
+/// Delete all sampler objects, and forget bound state.
+/// Samplers previously returned are no longer valid.
+///
+extern void gl_lsampler_cache_free();
+
+#endif
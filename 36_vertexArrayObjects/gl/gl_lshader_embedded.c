@@ -0,0 +1,16 @@
+#include "gl_lshader_embedded.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int compare_path_(const void* key, const void* element);
+
+int compare_path_(const void* key, const void* element)
+{
+  return strcmp((const char*)key, ((const gl_lshader_embedded_file*)element)->path);
+}
+
+const gl_lshader_embedded_file* gl_lshader_embedded_find(const char* path)
+{
+  // table is generated in sorted order
+  return bsearch(path, gl_lshader_embedded_files, gl_lshader_embedded_file_count, sizeof(gl_lshader_embedded_file), compare_path_);
+}
@@ -0,0 +1,35 @@
+#ifndef gl_lshader_embedded_h_
+#define gl_lshader_embedded_h_
+
+#include <stddef.h>
+
+/// Shader sources embedded into executable at build time.
+///
+/// Makefile runs tools/embedshaders over res/shaders/ to generate gl_lshader_embedded_table.c,
+/// so shaders are loaded without any file I/O, and regardless of working directory.
+/// Files are looked up by the same path they're referred to at runtime, i.e. "res/shaders/l_font_program2d.vert".
+
+/// embedded shader file
+typedef struct
+{
+  /// path as given to tools/embedshaders
+  const char* path;
+  /// null-terminated source
+  const char* source;
+  /// length of source not including null terminator
+  size_t size;
+} gl_lshader_embedded_file;
+
+/// generated table of files sorted by path
+extern const gl_lshader_embedded_file gl_lshader_embedded_files[];
+extern const int gl_lshader_embedded_file_count;
+
+///
+/// Find embedded shader file by path.
+///
+/// \param path Path of shader file
+/// \return Embedded file, or NULL if it's not embedded.
+///
+extern const gl_lshader_embedded_file* gl_lshader_embedded_find(const char* path);
+
+#endif
@@ -0,0 +1,255 @@
+#include "gl_lshader_source.h"
+#include "gl/gl_lshader_embedded.h"
+#include "SDL_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// guard against include cycle
+#define MAX_INCLUDE_DEPTH 16
+
+// development override to pick up shader edits without rebuilding
+#ifdef SHADERS_FROM_DISK
+static bool read_from_disk_ = true;
+#else
+static bool read_from_disk_ = false;
+#endif
+static gl_lshader_source_stats stats_ = { 0, 0 };
+
+typedef struct
+{
+  char* data;
+  size_t len;
+  size_t cap;
+} buffer_;
+
+static char* read_file_(const char* path);
+static void append_(buffer_* buf, const char* str, size_t n);
+static void append_line_directive_(buffer_* buf, int line);
+static void append_defines_(buffer_* buf, const char* const* defines, int define_count);
+static const char* skip_spaces_(const char* p, const char* end);
+static bool is_directive_(const char* line, const char* end, const char* directive);
+static bool append_file_(buffer_* buf, const char* path, const char* const* defines, int define_count, int depth);
+
+char* read_file_(const char* path)
+{
+  FILE* file = fopen(path, "rb");
+  if (file == NULL)
+  {
+    SDL_Log("Unable to open file for read %s", path);
+    return NULL;
+  }
+
+  fseek(file, 0, SEEK_END);
+  const long file_size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  if (file_size <= 0)
+  {
+    SDL_Log("Shader file has zero bytes %s", path);
+    fclose(file);
+    return NULL;
+  }
+
+  char* source = malloc(file_size + 1);
+  if (fread(source, file_size, 1, file) != 1)
+  {
+    SDL_Log("Read error %s", path);
+    free(source);
+    fclose(file);
+    return NULL;
+  }
+  source[file_size] = '\0';
+
+  fclose(file);
+  return source;
+}
+
+void append_(buffer_* buf, const char* str, size_t n)
+{
+  if (buf->len + n + 1 > buf->cap)
+  {
+    size_t cap = buf->cap > 0 ? buf->cap : 1024;
+    while (buf->len + n + 1 > cap)
+    {
+      cap *= 2;
+    }
+    buf->data = realloc(buf->data, cap);
+    buf->cap = cap;
+  }
+  memcpy(buf->data + buf->len, str, n);
+  buf->len += n;
+  buf->data[buf->len] = '\0';
+}
+
+void append_line_directive_(buffer_* buf, int line)
+{
+  char directive[32];
+  int n = snprintf(directive, sizeof(directive), "#line %d\n", line);
+  append_(buf, directive, n);
+}
+
+void append_defines_(buffer_* buf, const char* const* defines, int define_count)
+{
+  for (int i=0; i<define_count; i++)
+  {
+    append_(buf, "#define ", 8);
+
+    // NAME=VALUE becomes NAME VALUE
+    const char* equal = strchr(defines[i], '=');
+    if (equal != NULL)
+    {
+      append_(buf, defines[i], equal - defines[i]);
+      append_(buf, " ", 1);
+      append_(buf, equal + 1, strlen(equal + 1));
+    }
+    else
+    {
+      append_(buf, defines[i], strlen(defines[i]));
+    }
+    append_(buf, "\n", 1);
+  }
+}
+
+const char* skip_spaces_(const char* p, const char* end)
+{
+  while (p < end && (*p == ' ' || *p == '\t'))
+  {
+    p++;
+  }
+  return p;
+}
+
+bool is_directive_(const char* line, const char* end, const char* directive)
+{
+  const char* p = skip_spaces_(line, end);
+  if (p == end || *p != '#')
+  {
+    return false;
+  }
+  p = skip_spaces_(p + 1, end);
+
+  const size_t n = strlen(directive);
+  return (size_t)(end - p) >= n && strncmp(p, directive, n) == 0;
+}
+
+bool append_file_(buffer_* buf, const char* path, const char* const* defines, int define_count, int depth)
+{
+  if (depth > MAX_INCLUDE_DEPTH)
+  {
+    SDL_Log("Too deep includes at %s, is there an include cycle?", path);
+    return false;
+  }
+
+  // embedded source is used in place, only file read from disk is owned
+  const char* source = NULL;
+  char* file_source = NULL;
+  const gl_lshader_embedded_file* embedded = read_from_disk_ ? NULL : gl_lshader_embedded_find(path);
+  if (embedded != NULL)
+  {
+    source = embedded->source;
+    stats_.embedded_loads++;
+  }
+  else
+  {
+    file_source = read_file_(path);
+    if (file_source == NULL)
+    {
+      return false;
+    }
+    source = file_source;
+    stats_.file_loads++;
+  }
+
+  // defines go right after #version, or at the very top if there's none
+  bool inject = define_count > 0;
+  if (inject && strstr(source, "#version") == NULL)
+  {
+    append_defines_(buf, defines, define_count);
+    append_line_directive_(buf, 1);
+    inject = false;
+  }
+
+  // includes are relative to directory of this file
+  const char* slash = strrchr(path, '/');
+  const size_t dir_len = slash != NULL ? (size_t)(slash - path) + 1 : 0;
+
+  int line_number = 1;
+  const char* line = source;
+  while (*line != '\0')
+  {
+    const char* eol = strchr(line, '\n');
+    const char* end = eol != NULL ? eol : line + strlen(line);
+    const char* next = eol != NULL ? eol + 1 : end;
+
+    if (inject && is_directive_(line, end, "version"))
+    {
+      append_(buf, line, end - line);
+      append_(buf, "\n", 1);
+      append_defines_(buf, defines, define_count);
+      append_line_directive_(buf, line_number + 1);
+      inject = false;
+    }
+    else if (is_directive_(line, end, "include"))
+    {
+      const char* open_quote = memchr(line, '"', end - line);
+      const char* close_quote = open_quote != NULL ? memchr(open_quote + 1, '"', end - open_quote - 1) : NULL;
+      if (close_quote == NULL)
+      {
+        SDL_Log("Malformed #include at %s:%d", path, line_number);
+        free(file_source);
+        return false;
+      }
+
+      const size_t name_len = close_quote - open_quote - 1;
+      char* include_path = malloc(dir_len + name_len + 1);
+      memcpy(include_path, path, dir_len);
+      memcpy(include_path + dir_len, open_quote + 1, name_len);
+      include_path[dir_len + name_len] = '\0';
+
+      append_line_directive_(buf, 1);
+      bool result = append_file_(buf, include_path, NULL, 0, depth + 1);
+      free(include_path);
+      if (!result)
+      {
+        SDL_Log("Included from %s:%d", path, line_number);
+        free(file_source);
+        return false;
+      }
+      append_line_directive_(buf, line_number + 1);
+    }
+    else
+    {
+      append_(buf, line, end - line);
+      append_(buf, "\n", 1);
+    }
+
+    line = next;
+    line_number++;
+  }
+
+  free(file_source);
+  return true;
+}
+
+char* gl_lshader_source_load(const char* path, const char* const* defines, int define_count)
+{
+  buffer_ buf = { NULL, 0, 0 };
+  if (!append_file_(&buf, path, defines, define_count, 0))
+  {
+    free(buf.data);
+    return NULL;
+  }
+  return buf.data;
+}
+
+void gl_lshader_source_set_read_from_disk(bool enable)
+{
+  read_from_disk_ = enable;
+}
+
+gl_lshader_source_stats gl_lshader_source_get_stats()
+{
+  return stats_;
+}
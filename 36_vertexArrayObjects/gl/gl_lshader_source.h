@@ -0,0 +1,60 @@
+#ifndef gl_lshader_source_h_
+#define gl_lshader_source_h_
+
+#include <stdbool.h>
+
+/// Shader source loader with a minimal preprocessor.
+///
+/// It resolves
+///
+///   #include "path"
+///
+/// lines relative to directory of the file including it (nested up to 16 levels), and injects
+/// a set of defines right after #version line so a single shader file can be specialized
+/// at compile time instead of branching at runtime, i.e.
+///
+///   #ifdef SDF
+///     ...
+///   #endif
+///
+/// #line directives are emitted around injected, and included code so compile errors
+/// still report line numbers of the file they're in.
+///
+/// Files, and their includes are taken from sources embedded at build time (see gl_lshader_embedded)
+/// whenever available, so no file I/O happens. Files not embedded are read from disk.
+
+typedef struct
+{
+  /// number of files taken from embedded sources
+  unsigned int embedded_loads;
+  /// number of files read from disk
+  unsigned int file_loads;
+} gl_lshader_source_stats;
+
+///
+/// Load shader source from file, resolve its includes, and inject defines.
+///
+/// \param path Path to shader file
+/// \param defines Defines to inject, each either "NAME", or "NAME=VALUE". It can be NULL.
+/// \param define_count Number of defines
+/// \return Newly allocated null-terminated source, caller frees it. NULL if file or any of its includes cannot be read.
+///
+extern char* gl_lshader_source_load(const char* path, const char* const* defines, int define_count);
+
+///
+/// Set whether to always read shader files from disk, ignoring embedded sources.
+/// It's meant for development to iterate on shaders without rebuilding.
+/// Default is false, or true if compiled with -DSHADERS_FROM_DISK.
+///
+/// \param enable True to read from disk
+///
+extern void gl_lshader_source_set_read_from_disk(bool enable);
+
+///
+/// Get number of files loaded from embedded sources, and from disk so far.
+///
+/// \return Statistics
+///
+extern gl_lshader_source_stats gl_lshader_source_get_stats();
+
+#endif
@@ -0,0 +1,106 @@
+#include "gl_lshader_variants.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+  // sorted defines joined by newline
+  char* key;
+  gl_lprogram* program;
+} variant_entry_;
+
+static int compare_strings_(const void* a, const void* b);
+static char* make_key_(const char* const* defines, int define_count);
+
+int compare_strings_(const void* a, const void* b)
+{
+  return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+char* make_key_(const char* const* defines, int define_count)
+{
+  // order of defines doesn't make a different permutation
+  const char** sorted = malloc(define_count * sizeof(const char*) + 1);
+  size_t len = 1;
+  for (int i=0; i<define_count; i++)
+  {
+    sorted[i] = defines[i];
+    len += strlen(defines[i]) + 1;
+  }
+  qsort(sorted, define_count, sizeof(const char*), compare_strings_);
+
+  char* key = malloc(len);
+  key[0] = '\0';
+  for (int i=0; i<define_count; i++)
+  {
+    strcat(key, sorted[i]);
+    strcat(key, "\n");
+  }
+
+  free(sorted);
+  return key;
+}
+
+gl_lshader_variants* gl_lshader_variants_new(const char* vertex_shader_path, const char* fragment_shader_path)
+{
+  gl_lshader_variants* out = malloc(sizeof(gl_lshader_variants));
+  out->builds = 0;
+
+  out->vertex_shader_path_ = malloc(strlen(vertex_shader_path) + 1);
+  strcpy(out->vertex_shader_path_, vertex_shader_path);
+  out->fragment_shader_path_ = malloc(strlen(fragment_shader_path) + 1);
+  strcpy(out->fragment_shader_path_, fragment_shader_path);
+
+  out->entries_ = vector_new(4, sizeof(variant_entry_));
+
+  return out;
+}
+
+void gl_lshader_variants_free(gl_lshader_variants* variants)
+{
+  for (int i=0; i<variants->entries_->len; i++)
+  {
+    variant_entry_* entry = vector_get(variants->entries_, i);
+    free(entry->key);
+    gl_lprogram_free(entry->program);
+  }
+  vector_free(variants->entries_);
+  variants->entries_ = NULL;
+
+  free(variants->vertex_shader_path_);
+  free(variants->fragment_shader_path_);
+
+  free(variants);
+  variants = NULL;
+}
+
+gl_lprogram* gl_lshader_variants_get(gl_lshader_variants* variants, const char* const* defines, int define_count)
+{
+  char* key = make_key_(defines, define_count);
+  for (int i=0; i<variants->entries_->len; i++)
+  {
+    variant_entry_* entry = vector_get(variants->entries_, i);
+    if (strcmp(entry->key, key) == 0)
+    {
+      free(key);
+      return entry->program;
+    }
+  }
+
+  // first request of this permutation
+  gl_lprogram* program = gl_lprogram_new();
+  if (!gl_lprogram_load_program_with_defines(program, variants->vertex_shader_path_, variants->fragment_shader_path_, defines, define_count, NULL, 0))
+  {
+    SDL_Log("Unable to build variant of %s + %s", variants->vertex_shader_path_, variants->fragment_shader_path_);
+    gl_lprogram_free(program);
+    free(key);
+    return NULL;
+  }
+  variants->builds++;
+
+  variant_entry_ entry = { key, program };
+  vector_add(variants->entries_, &entry);
+
+  return program;
+}
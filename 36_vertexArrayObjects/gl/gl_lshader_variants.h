@@ -0,0 +1,56 @@
+#ifndef gl_lshader_variants_h_
+#define gl_lshader_variants_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_lprogram.h"
+#include "foundation/vector.h"
+
+/// Compile-time variants of a single pair of shader files.
+///
+/// Each set of defines i.e. { "SDF" }, or { "TINT", "ALPHA_TEXTURE" } selects a permutation which is
+/// built on first request with defines injected into both shaders (see gl_lshader_source), then kept
+/// for later requests. Order of defines doesn't matter.
+///
+/// Programs are built through gl_LShaderProgram so each permutation has its own binary cache entry,
+/// and frame constants binding.
+
+typedef struct
+{
+  /// (read-only) number of permutations built so far
+  unsigned int builds;
+
+  /// (internal use) shader file paths
+  char* vertex_shader_path_;
+  char* fragment_shader_path_;
+  /// (internal use) built permutations
+  vector* entries_;
+} gl_lshader_variants;
+
+///
+/// Create a new variant cache for a pair of shader files.
+///
+/// \param vertex_shader_path Path to vertex shader file, it will be copied.
+/// \param fragment_shader_path Path to fragment shader file, it will be copied.
+/// \return Newly created gl_lshader_variants on heap.
+///
+extern gl_lshader_variants* gl_lshader_variants_new(const char* vertex_shader_path, const char* fragment_shader_path);
+
+///
+/// Free variant cache along with all of its programs.
+///
+/// \param variants Pointer to gl_lshader_variants
+///
+extern void gl_lshader_variants_free(gl_lshader_variants* variants);
+
+///
+/// Get program of the permutation, build it if it's not built yet.
+/// Returned program is owned by variant cache, don't free it.
+///
+/// \param variants Pointer to gl_lshader_variants
+/// \param defines Defines selecting permutation, each either "NAME", or "NAME=VALUE". It can be NULL.
+/// \param define_count Number of defines
+/// \return Program of permutation, or NULL if it failed to build.
+///
+extern gl_lprogram* gl_lshader_variants_get(gl_lshader_variants* variants, const char* const* defines, int define_count);
+
+#endif
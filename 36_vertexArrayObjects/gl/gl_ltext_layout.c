@@ -0,0 +1,429 @@
+#include "gl_ltext_layout.h"
+#include "gl/gl_LFont_internals.h"
+#include "foundation/vector.h"
+#include "foundation/krr_utf8.h"
+#include "foundation/krr_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+// number of layouts kept in cache
+#define CACHE_CAPACITY 256
+// number of hash buckets, power of two
+#define CACHE_BUCKETS 512
+// end of linked list
+#define NIL -1
+
+// glyph used for code point outside of font's glyphs
+#define FALLBACK_GLYPH '?'
+
+// what layout depends on other than text itself
+typedef struct
+{
+  gl_LFont* font;
+  uint64_t text_hash;
+  int has_area;
+  LSize area;
+  int align;
+} layout_key_;
+
+typedef struct
+{
+  // false if entry is free
+  bool used;
+  layout_key_ key;
+  // copy of text to resolve hash collision
+  char* text;
+  gl_ltext_layout layout;
+
+  // (LRU list) previous is more recently used
+  int prev;
+  int next;
+  // next entry in the same bucket
+  int bucket_next;
+} cache_entry_;
+
+// a single line during layout
+typedef struct
+{
+  // first glyph of line
+  int first;
+  GLfloat width;
+} line_;
+
+static cache_entry_ entries_[CACHE_CAPACITY];
+static int buckets_[CACHE_BUCKETS];
+// most, and least recently used entries
+static int lru_head_ = NIL;
+static int lru_tail_ = NIL;
+static bool cache_initialized_ = false;
+static gl_ltext_layout_stats stats_ = {0, 0, 0};
+
+static void init_cache_();
+static uint64_t hash_key_(const layout_key_* key);
+static void lru_unlink_(int index);
+static void lru_push_front_(int index);
+static void remove_entry_(int index);
+static int find_entry_(const layout_key_* key, const char* text, int bucket);
+static GLuint glyph_of_(uint32_t codepoint);
+static GLfloat advance_of_(gl_LFont* font, GLuint glyph);
+static void layout_text_(gl_LFont* font, const char* text, const LSize* area_size, int align, gl_ltext_layout* out);
+
+void init_cache_()
+{
+  for (int i=0; i<CACHE_BUCKETS; i++)
+  {
+    buckets_[i] = NIL;
+  }
+  for (int i=0; i<CACHE_CAPACITY; i++)
+  {
+    memset(&entries_[i], 0, sizeof(cache_entry_));
+    entries_[i].prev = NIL;
+    entries_[i].next = NIL;
+    entries_[i].bucket_next = NIL;
+  }
+  lru_head_ = NIL;
+  lru_tail_ = NIL;
+  cache_initialized_ = true;
+}
+
+uint64_t hash_key_(const layout_key_* key)
+{
+  // hash field by field, struct's padding bytes are undefined
+  uint64_t h = krr_hash_bytes(&key->font, sizeof(key->font), key->text_hash);
+  h = krr_hash_bytes(&key->has_area, sizeof(key->has_area), h);
+  h = krr_hash_bytes(&key->area, sizeof(key->area), h);
+  return krr_hash_bytes(&key->align, sizeof(key->align), h);
+}
+
+void lru_unlink_(int index)
+{
+  cache_entry_* entry = &entries_[index];
+  if (entry->prev != NIL)
+    entries_[entry->prev].next = entry->next;
+  else
+    lru_head_ = entry->next;
+
+  if (entry->next != NIL)
+    entries_[entry->next].prev = entry->prev;
+  else
+    lru_tail_ = entry->prev;
+
+  entry->prev = NIL;
+  entry->next = NIL;
+}
+
+void lru_push_front_(int index)
+{
+  cache_entry_* entry = &entries_[index];
+  entry->prev = NIL;
+  entry->next = lru_head_;
+  if (lru_head_ != NIL)
+    entries_[lru_head_].prev = index;
+  lru_head_ = index;
+  if (lru_tail_ == NIL)
+    lru_tail_ = index;
+}
+
+void remove_entry_(int index)
+{
+  cache_entry_* entry = &entries_[index];
+
+  // unlink from its bucket
+  int* link = &buckets_[hash_key_(&entry->key) & (CACHE_BUCKETS - 1)];
+  while (*link != index)
+  {
+    link = &entries_[*link].bucket_next;
+  }
+  *link = entry->bucket_next;
+  entry->bucket_next = NIL;
+
+  lru_unlink_(index);
+
+  free(entry->text);
+  entry->text = NULL;
+  free(entry->layout.glyphs);
+  memset(&entry->layout, 0, sizeof(entry->layout));
+  entry->used = false;
+}
+
+int find_entry_(const layout_key_* key, const char* text, int bucket)
+{
+  for (int i=buckets_[bucket]; i!=NIL; i=entries_[i].bucket_next)
+  {
+    const layout_key_* k = &entries_[i].key;
+    if (k->font == key->font &&
+        k->text_hash == key->text_hash &&
+        k->has_area == key->has_area &&
+        k->area.w == key->area.w &&
+        k->area.h == key->area.h &&
+        k->align == key->align &&
+        strcmp(entries_[i].text, text) == 0)
+    {
+      return i;
+    }
+  }
+  return NIL;
+}
+
+GLuint glyph_of_(uint32_t codepoint)
+{
+  // font has 256 glyphs, first 256 code points of unicode are latin-1
+  return codepoint < 256 ? codepoint : FALLBACK_GLYPH;
+}
+
+GLfloat advance_of_(gl_LFont* font, GLuint glyph)
+{
+  const LRect* clip = vector_get(font->spritesheet->clips, glyph);
+  return clip->w - 2.f * font->padding + BETWEEN_CHAR_SPACING;
+}
+
+void layout_text_(gl_LFont* font, const char* text, const LSize* area_size, int align, gl_ltext_layout* out)
+{
+  // correct empty alignment
+  if (align == 0)
+  {
+    align = gl_LFont_TEXT_ALIGN_LEFT | gl_LFont_TEXT_ALIGN_TOP;
+  }
+  const bool wrap = area_size != NULL && area_size->w > 0.f;
+
+  // whitespaces don't produce glyph, so number of code points is upper bound
+  out->glyphs = malloc(krr_utf8_length(text) * sizeof(gl_ltext_layout_glyph) + 1);
+  out->glyph_count = 0;
+
+  vector* lines = vector_new(4, sizeof(line_));
+  line_ line = { 0, 0.f };
+
+  // pen position on current line
+  GLfloat pen_x = 0.f;
+  // previous glyph for kerning, -1 at line start
+  int prev_glyph = -1;
+  // last word boundary on current line to wrap at, first glyph after it and line width before it
+  int break_glyph = -1;
+  GLfloat break_width = 0.f;
+
+  const bool has_glyphs = font->spritesheet->clips->len >= 256;
+  const char* p = text;
+  uint32_t codepoint;
+  while (has_glyphs && (codepoint = krr_utf8_next(&p)) != 0)
+  {
+    if (codepoint == '\n')
+    {
+      line.width = pen_x;
+      vector_add(lines, &line);
+
+      line.first = out->glyph_count;
+      pen_x = 0.f;
+      prev_glyph = -1;
+      break_glyph = -1;
+    }
+    else if (codepoint == ' ')
+    {
+      // trailing spaces don't count when line is wrapped here
+      if (break_glyph != out->glyph_count)
+      {
+        break_width = pen_x;
+      }
+      break_glyph = out->glyph_count;
+
+      pen_x += font->space;
+      prev_glyph = ' ';
+    }
+    else
+    {
+      GLuint glyph = glyph_of_(codepoint);
+      GLfloat advance = advance_of_(font, glyph);
+      if (prev_glyph >= 0)
+      {
+        pen_x += gl_LFont_get_kerning(font, prev_glyph, glyph);
+      }
+
+      // wrap when glyph overflows, and line has something on it already
+      if (wrap && pen_x + advance > area_size->w && pen_x > 0.f)
+      {
+        if (break_glyph >= 0 && break_width > 0.f)
+        {
+          // move the current word to the next line
+          GLfloat word_x = break_glyph < out->glyph_count ? out->glyphs[break_glyph].x : pen_x;
+          line.width = break_width;
+          vector_add(lines, &line);
+
+          for (int i=break_glyph; i<out->glyph_count; i++)
+          {
+            out->glyphs[i].x -= word_x;
+          }
+          line.first = break_glyph;
+          pen_x -= word_x;
+        }
+        else
+        {
+          // single word is wider than area, break it right here
+          line.width = pen_x;
+          vector_add(lines, &line);
+
+          line.first = out->glyph_count;
+          pen_x = 0.f;
+        }
+        break_glyph = -1;
+      }
+
+      gl_ltext_layout_glyph* g = &out->glyphs[out->glyph_count++];
+      g->glyph = glyph;
+      g->x = pen_x;
+      g->y = 0.f;
+
+      pen_x += advance;
+      prev_glyph = glyph;
+    }
+  }
+  line.width = pen_x;
+  vector_add(lines, &line);
+
+  out->line_count = lines->len;
+  out->size.w = 0.f;
+  out->size.h = lines->len * font->line_height;
+
+  // vertical alignment applies to all lines
+  GLfloat offset_y = 0.f;
+  if (area_size != NULL)
+  {
+    if (align & gl_LFont_TEXT_ALIGN_CENTERED_V)
+    {
+      offset_y = (area_size->h - out->size.h) / 2.f;
+    }
+    else if (align & gl_LFont_TEXT_ALIGN_BOTTOM)
+    {
+      offset_y = area_size->h - out->size.h;
+    }
+  }
+
+  // position lines
+  for (int l=0; l<lines->len; l++)
+  {
+    const line_* ln = vector_get(lines, l);
+    int last = l + 1 < lines->len ? ((line_*)vector_get(lines, l + 1))->first : out->glyph_count;
+
+    if (ln->width > out->size.w)
+    {
+      out->size.w = ln->width;
+    }
+
+    // horizontal alignment applies line by line
+    GLfloat offset_x = 0.f;
+    if (area_size != NULL)
+    {
+      if (align & gl_LFont_TEXT_ALIGN_CENTERED_H)
+      {
+        offset_x = (area_size->w - ln->width) / 2.f;
+      }
+      else if (align & gl_LFont_TEXT_ALIGN_RIGHT)
+      {
+        offset_x = area_size->w - ln->width;
+      }
+    }
+
+    for (int i=ln->first; i<last; i++)
+    {
+      out->glyphs[i].x += offset_x;
+      out->glyphs[i].y = offset_y + l * font->newline;
+    }
+  }
+
+  vector_free(lines);
+}
+
+const gl_ltext_layout* gl_ltext_layout_get(gl_LFont* font, const char* text, const LSize* area_size, int align)
+{
+  if (!cache_initialized_)
+  {
+    init_cache_();
+  }
+
+  layout_key_ key;
+  memset(&key, 0, sizeof(key));
+  key.font = font;
+  key.text_hash = krr_hash_string(text);
+  key.has_area = area_size != NULL;
+  if (area_size != NULL)
+  {
+    key.area = *area_size;
+  }
+  key.align = align;
+
+  int bucket = hash_key_(&key) & (CACHE_BUCKETS - 1);
+  int index = find_entry_(&key, text, bucket);
+  if (index != NIL)
+  {
+    stats_.hits++;
+    lru_unlink_(index);
+    lru_push_front_(index);
+    return &entries_[index].layout;
+  }
+  stats_.misses++;
+
+  // find free entry, or evict the least recently used one
+  for (int i=0; i<CACHE_CAPACITY && index == NIL; i++)
+  {
+    if (!entries_[i].used)
+    {
+      index = i;
+    }
+  }
+  if (index == NIL)
+  {
+    index = lru_tail_;
+    remove_entry_(index);
+    stats_.evictions++;
+  }
+
+  cache_entry_* entry = &entries_[index];
+  entry->used = true;
+  entry->key = key;
+  entry->text = malloc(strlen(text) + 1);
+  strcpy(entry->text, text);
+  layout_text_(font, text, area_size, align, &entry->layout);
+
+  entry->bucket_next = buckets_[bucket];
+  buckets_[bucket] = index;
+  lru_push_front_(index);
+
+  return &entry->layout;
+}
+
+void gl_ltext_layout_invalidate_font(gl_LFont* font)
+{
+  if (!cache_initialized_)
+  {
+    return;
+  }
+
+  for (int i=0; i<CACHE_CAPACITY; i++)
+  {
+    if (entries_[i].used && entries_[i].key.font == font)
+    {
+      remove_entry_(i);
+    }
+  }
+}
+
+void gl_ltext_layout_free_cache()
+{
+  if (!cache_initialized_)
+  {
+    return;
+  }
+
+  for (int i=0; i<CACHE_CAPACITY; i++)
+  {
+    if (entries_[i].used)
+    {
+      remove_entry_(i);
+    }
+  }
+  cache_initialized_ = false;
+  memset(&stats_, 0, sizeof(stats_));
+}
+
+gl_ltext_layout_stats gl_ltext_layout_get_stats()
+{
+  return stats_;
+}
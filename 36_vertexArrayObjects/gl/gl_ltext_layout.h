@@ -0,0 +1,86 @@
+#ifndef gl_ltext_layout_h_
+#define gl_ltext_layout_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LFont.h"
+
+/// Text layout for gl_LFont.
+///
+/// Layout decodes UTF-8 text, applies font's kerning pairs, wraps words within area, then aligns each line.
+/// Result is a run of positioned glyphs which is shared by measuring, and rendering.
+///
+/// Layouts are memoized in a shared LRU cache keyed by font, text, area, and alignment,
+/// so rendering the same text again doesn't lay it out again.
+
+/// a single positioned glyph
+typedef struct
+{
+  /// glyph index into font's clips
+  GLuint glyph;
+  /// position of glyph's top-left relative to layout's origin, glyph's padding (if any) excluded
+  GLfloat x;
+  GLfloat y;
+} gl_ltext_layout_glyph;
+
+/// laid out text
+typedef struct
+{
+  /// positioned glyphs, whitespaces are not included
+  gl_ltext_layout_glyph* glyphs;
+  /// number of glyphs
+  int glyph_count;
+  /// number of lines after wrapping
+  int line_count;
+  /// area size covering laid out text
+  LSize size;
+} gl_ltext_layout;
+
+/// layout cache statistics
+typedef struct
+{
+  /// layouts served from cache
+  unsigned int hits;
+  /// layouts that had to be laid out
+  unsigned int misses;
+  /// layouts evicted to make room for new ones
+  unsigned int evictions;
+} gl_ltext_layout_stats;
+
+///
+/// Get layout of text.
+/// Returned layout is owned by cache, it's valid until the next call to this function,
+/// or until font is freed, or reloaded.
+///
+/// Code points outside of font's 256 glyphs are rendered as '?'.
+///
+/// \param font Pointer to gl_LFont
+/// \param text Null-terminated UTF-8 text
+/// \param area_size Area size to wrap, and align text within it. It can be NULL for no wrapping, nor alignment.
+/// Zero width disables wrapping.
+/// \param align Alignment to align text within the given area. See gl_LFont_TextAlignment.
+/// \return Layout of text
+///
+extern const gl_ltext_layout* gl_ltext_layout_get(gl_LFont* font, const char* text, const LSize* area_size, int align);
+
+///
+/// Drop all cached layouts of font.
+/// It's called automatically whenever font is freed, or reloaded.
+///
+/// \param font Pointer to gl_LFont
+///
+extern void gl_ltext_layout_invalidate_font(gl_LFont* font);
+
+///
+/// Free all cached layouts.
+/// Call it when application closes.
+///
+extern void gl_ltext_layout_free_cache();
+
+///
+/// Get layout cache statistics.
+///
+/// \return Statistics since start, or since last gl_ltext_layout_free_cache()
+///
+extern gl_ltext_layout_stats gl_ltext_layout_get_stats();
+
+#endif
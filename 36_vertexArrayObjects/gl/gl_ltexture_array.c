@@ -0,0 +1,291 @@
+#include "gl_ltexture_array.h"
+#include "gl/gl_LTexture_internals.h"
+#include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "gl/gl_lsampler_cache.h"
+#include "gl/gl_lvertex_format.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+static void free_storage_(gl_ltexture_array* array);
+
+void free_storage_(gl_ltexture_array* array)
+{
+  if (array->texture_id != 0)
+  {
+    glDeleteTextures(1, &array->texture_id);
+    array->texture_id = 0;
+  }
+  free(array->layer_sizes);
+  array->layer_sizes = NULL;
+
+  array->width = 0;
+  array->height = 0;
+  array->layer_count = 0;
+  array->capacity = 0;
+}
+
+gl_ltexture_array* gl_ltexture_array_new()
+{
+  gl_ltexture_array* out = malloc(sizeof(gl_ltexture_array));
+  out->texture_id = 0;
+  out->width = 0;
+  out->height = 0;
+  out->layer_count = 0;
+  out->capacity = 0;
+  out->sampler = 0;
+  out->layer_sizes = NULL;
+  return out;
+}
+
+void gl_ltexture_array_free(gl_ltexture_array* array)
+{
+  free_storage_(array);
+  free(array);
+  array = NULL;
+}
+
+bool gl_ltexture_array_create(gl_ltexture_array* array, int width, int height, int capacity)
+{
+  free_storage_(array);
+
+  GLint max_layers = 0;
+  glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+  if (capacity <= 0 || capacity > max_layers)
+  {
+    SDL_Log("Texture array capacity %d is out of range, maximum is %d", capacity, max_layers);
+    return false;
+  }
+
+  glGenTextures(1, &array->texture_id);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, array->texture_id);
+  // single level, filtering, and wrapping are in sampler
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, capacity, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+  GLenum error = GL_LDEBUG_GET_ERROR();
+  if (error != GL_NO_ERROR)
+  {
+    SDL_Log("Error creating texture array %dx%d x %d layers: %s", width, height, capacity, gl_util_error_string(error));
+    glDeleteTextures(1, &array->texture_id);
+    array->texture_id = 0;
+    return false;
+  }
+
+  array->width = width;
+  array->height = height;
+  array->capacity = capacity;
+  array->layer_sizes = malloc(capacity * sizeof(LSize));
+
+  // padded layers must not bleed into neighbouring content, nor wrap around
+  if (array->sampler == 0)
+  {
+    gl_lsampler_desc desc = gl_lsampler_desc_default;
+    desc.wrap_s = GL_CLAMP_TO_EDGE;
+    desc.wrap_t = GL_CLAMP_TO_EDGE;
+    array->sampler = gl_lsampler_cache_get(&desc);
+  }
+
+  return true;
+}
+
+int gl_ltexture_array_add_pixels32(gl_ltexture_array* array, const GLuint* pixels, int width, int height, int pitch)
+{
+  if (array->layer_count >= array->capacity)
+  {
+    SDL_Log("Texture array is full, %d layers", array->capacity);
+    return -1;
+  }
+  if (width > array->width || height > array->height)
+  {
+    SDL_Log("Image %dx%d doesn't fit into texture array layer %dx%d", width, height, array->width, array->height);
+    return -1;
+  }
+
+  // place image at top-left, pad the rest by repeating its right, and bottom edge texels
+  // so linear filtering at its edges doesn't blend in whatever padding would be
+  GLuint* layer_pixels = calloc(array->width * array->height, sizeof(GLuint));
+  if (width > 0 && height > 0)
+  {
+    for (int y=0; y<height; y++)
+    {
+      GLuint* row = layer_pixels + y * array->width;
+      memcpy(row, pixels + y * pitch, width * sizeof(GLuint));
+      for (int x=width; x<array->width; x++)
+      {
+        row[x] = row[width - 1];
+      }
+    }
+    const GLuint* last_row = layer_pixels + (height - 1) * array->width;
+    for (int y=height; y<array->height; y++)
+    {
+      memcpy(layer_pixels + y * array->width, last_row, array->width * sizeof(GLuint));
+    }
+  }
+
+  const int layer = array->layer_count;
+  glBindTexture(GL_TEXTURE_2D_ARRAY, array->texture_id);
+  glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, array->width, array->height, 1, GL_RGBA, GL_UNSIGNED_BYTE, layer_pixels);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+  free(layer_pixels);
+
+  GLenum error = GL_LDEBUG_GET_ERROR();
+  if (error != GL_NO_ERROR)
+  {
+    SDL_Log("Error uploading texture array layer %d: %s", layer, gl_util_error_string(error));
+    return -1;
+  }
+
+  array->layer_sizes[layer].w = width;
+  array->layer_sizes[layer].h = height;
+  array->layer_count++;
+  return layer;
+}
+
+int gl_ltexture_array_add_texture_pixels(gl_ltexture_array* array, const gl_LTexture* texture)
+{
+  if (texture->pixels == NULL)
+  {
+    SDL_Log("Texture has no 32-bit pixels to add into texture array");
+    return -1;
+  }
+
+  // pixels are padded to physical width
+  return gl_ltexture_array_add_pixels32(array, texture->pixels, texture->width, texture->height, texture->physical_width_);
+}
+
+int gl_ltexture_array_add_file(gl_ltexture_array* array, const char* path)
+{
+  // decode via gl_LTexture, but only keep its pixels
+  gl_LTexture* texture = gl_LTexture_new();
+  if (!gl_LTexture_load_pixels_from_file(texture, path))
+  {
+    SDL_Log("Unable to load %s into texture array", path);
+    gl_LTexture_free(texture);
+    return -1;
+  }
+
+  int layer = gl_ltexture_array_add_texture_pixels(array, texture);
+  gl_LTexture_free(texture);
+  return layer;
+}
+
+gl_ltexture_array_batch* gl_ltexture_array_batch_new(gl_ltexture_array* array, gl_lprogram* program, int capacity)
+{
+  gl_ltexture_array_batch* out = malloc(sizeof(gl_ltexture_array_batch));
+  out->array = array;
+  out->program = program;
+  out->sprite_count = 0;
+  out->capacity = capacity;
+  out->draw_calls = 0;
+  out->vertices_ = malloc(capacity * 4 * sizeof(LLayerVertexData2D));
+
+  glGenBuffers(1, &out->vbo_);
+  glBindBuffer(GL_ARRAY_BUFFER, out->vbo_);
+  glBufferData(GL_ARRAY_BUFFER, capacity * 4 * sizeof(LLayerVertexData2D), NULL, GL_STREAM_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  const GLsizei stride = sizeof(LLayerVertexData2D);
+  const gl_lprogram_vertex_attrib layout[] = {
+    { "vertex_pos2d", out->vbo_, 2, GL_FLOAT, GL_FALSE, stride, offsetof(LLayerVertexData2D, data.position), 0 },
+    { "texcoord", out->vbo_, 2, GL_FLOAT, GL_FALSE, stride, offsetof(LLayerVertexData2D, data.texcoord), 0 },
+    { "layer", out->vbo_, 1, GL_FLOAT, GL_FALSE, stride, offsetof(LLayerVertexData2D, layer), 0 }
+  };
+  // quads as two triangles from shared quad index buffer
+  out->vao_ = gl_lprogram_create_vertex_array(program, layout, 3, gl_lvertex_format_quad_index_buffer());
+
+  out->modelview_index_ = gl_lprogram_uniform_index(program, "modelview_matrix");
+  out->texture_sampler_index_ = gl_lprogram_uniform_index(program, "texture_sampler");
+
+  return out;
+}
+
+void gl_ltexture_array_batch_free(gl_ltexture_array_batch* batch)
+{
+  glDeleteVertexArrays(1, &batch->vao_);
+  glDeleteBuffers(1, &batch->vbo_);
+  free(batch->vertices_);
+  batch->vertices_ = NULL;
+
+  free(batch);
+  batch = NULL;
+}
+
+void gl_ltexture_array_batch_add(gl_ltexture_array_batch* batch, int layer, GLfloat x, GLfloat y, const LRect* clip)
+{
+  const gl_ltexture_array* array = batch->array;
+  if (layer < 0 || layer >= array->layer_count)
+  {
+    SDL_Log("Texture array layer %d is out of range, %d layers", layer, array->layer_count);
+    return;
+  }
+
+  if (batch->sprite_count >= batch->capacity)
+  {
+    gl_ltexture_array_batch_flush(batch);
+  }
+
+  const LSize* size = &array->layer_sizes[layer];
+  LRect region = { 0.f, 0.f, size->w, size->h };
+  if (clip != NULL)
+  {
+    region = *clip;
+  }
+
+  const GLfloat tex_left = region.x / array->width;
+  const GLfloat tex_right = (region.x + region.w) / array->width;
+  const GLfloat tex_top = region.y / array->height;
+  const GLfloat tex_bottom = (region.y + region.h) / array->height;
+
+  // top left, top right, bottom right, bottom left
+  LLayerVertexData2D* v = &batch->vertices_[batch->sprite_count * 4];
+  v[0].data.position = (LVector2D){ x, y };
+  v[0].data.texcoord = (LTexCoord2D){ tex_left, tex_top };
+  v[1].data.position = (LVector2D){ x + region.w, y };
+  v[1].data.texcoord = (LTexCoord2D){ tex_right, tex_top };
+  v[2].data.position = (LVector2D){ x + region.w, y + region.h };
+  v[2].data.texcoord = (LTexCoord2D){ tex_right, tex_bottom };
+  v[3].data.position = (LVector2D){ x, y + region.h };
+  v[3].data.texcoord = (LTexCoord2D){ tex_left, tex_bottom };
+  v[0].layer = v[1].layer = v[2].layer = v[3].layer = (GLfloat)layer;
+
+  batch->sprite_count++;
+}
+
+void gl_ltexture_array_batch_flush(gl_ltexture_array_batch* batch)
+{
+  if (batch->sprite_count == 0)
+  {
+    return;
+  }
+
+  gl_LShaderProgram_bind(batch->program->program);
+
+  // vertices are in world space
+  mat4 identity;
+  glm_mat4_identity(identity);
+  gl_lprogram_set_mat4(batch->program, batch->modelview_index_, identity);
+  gl_lprogram_set_int(batch->program, batch->texture_sampler_index_, 0);
+
+  // orphan previous content so driver needn't wait for last draw
+  const GLsizeiptr bytes = batch->sprite_count * 4 * sizeof(LLayerVertexData2D);
+  glBindBuffer(GL_ARRAY_BUFFER, batch->vbo_);
+  glBufferData(GL_ARRAY_BUFFER, batch->capacity * 4 * sizeof(LLayerVertexData2D), NULL, GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, batch->vertices_);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, batch->array->texture_id);
+  gl_lsampler_cache_bind(0, batch->array->sampler);
+
+  glBindVertexArray(batch->vao_);
+  gl_lvertex_format_draw_quads(0, batch->sprite_count);
+  glBindVertexArray(0);
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+  batch->draw_calls++;
+  batch->sprite_count = 0;
+}
@@ -0,0 +1,165 @@
+#ifndef gl_ltexture_array_h_
+#define gl_ltexture_array_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LTexture.h"
+#include "gl/gl_lprogram.h"
+#include "gl/gl_types.h"
+#include <stdbool.h>
+
+/// Sprites from many source images drawn in a single draw call.
+///
+/// Images are loaded (via gl_LTexture) into layers of a single GL_TEXTURE_2D_ARRAY of fixed layer size.
+/// Images smaller than layer are placed at top-left, and padded with copies of their right, and bottom edge.
+/// Each vertex (LLayerVertexData2D) carries the layer it samples from, so sprites of different images
+/// don't break a batch as switching between gl_LTexture objects would.
+///
+/// Batch is drawn with textured polygon program specialized with GL_LTEXTURE_ARRAY_DEFINE, i.e.
+///
+///   const char* defines[] = { GL_LTEXTURE_ARRAY_DEFINE };
+///   gl_lprogram_load_program_with_defines(program, "res/shaders/l_textured_polygon_program2d.vert", "res/shaders/l_textured_polygon_program2d.frag", defines, 1, NULL, 0);
+
+/// define to specialize textured polygon program for texture array
+#define GL_LTEXTURE_ARRAY_DEFINE "TEXTURE_ARRAY"
+
+typedef struct
+{
+  /// texture id of GL_TEXTURE_2D_ARRAY, 0 if not created yet
+  GLuint texture_id;
+
+  /// (read-only) layer width in pixels
+  int width;
+  /// (read-only) layer height in pixels
+  int height;
+
+  /// (read-only) number of layers used
+  int layer_count;
+  /// (read-only) number of layers allocated
+  int capacity;
+
+  /// sampler object to draw with (see gl_lsampler_cache), clamp to edge by default
+  GLuint sampler;
+
+  /// (read-only) size of image in each layer, at most layer size
+  LSize* layer_sizes;
+} gl_ltexture_array;
+
+typedef struct
+{
+  /// (read-only) texture array to draw from, not owned
+  gl_ltexture_array* array;
+  /// (read-only) program specialized with GL_LTEXTURE_ARRAY_DEFINE, not owned
+  gl_lprogram* program;
+
+  /// (read-only) number of sprites added since last flush
+  int sprite_count;
+  /// (read-only) maximum number of sprites in a single draw call
+  int capacity;
+
+  /// (read-only) number of draw calls issued so far
+  unsigned int draw_calls;
+
+  /// (internal use) vertex array object, and vertex buffer drawn from shared quad index buffer
+  GLuint vao_;
+  GLuint vbo_;
+  /// (internal use) vertices of sprites added since last flush
+  LLayerVertexData2D* vertices_;
+  /// (internal use) uniform indexes of program
+  int modelview_index_;
+  int texture_sampler_index_;
+} gl_ltexture_array_batch;
+
+///
+/// Create a new texture array.
+///
+/// \return Newly created gl_ltexture_array on heap.
+///
+extern gl_ltexture_array* gl_ltexture_array_new();
+
+///
+/// Free texture array.
+///
+/// \param array Pointer to gl_ltexture_array
+///
+extern void gl_ltexture_array_free(gl_ltexture_array* array);
+
+///
+/// Allocate storage for layers, previous storage is freed if any.
+///
+/// \param array Pointer to gl_ltexture_array
+/// \param width Layer width in pixels
+/// \param height Layer height in pixels
+/// \param capacity Number of layers, at most GL_MAX_ARRAY_TEXTURE_LAYERS
+/// \return True if storage is created, otherwise return false.
+///
+extern bool gl_ltexture_array_create(gl_ltexture_array* array, int width, int height, int capacity);
+
+///
+/// Add 32-bit RGBA pixels as a new layer.
+///
+/// \param array Pointer to gl_ltexture_array
+/// \param pixels Source pixels
+/// \param width Image width, at most layer width
+/// \param height Image height, at most layer height
+/// \param pitch Number of pixels per row of source pixels, at least width
+/// \return Layer index, or -1 if image doesn't fit, or there's no free layer.
+///
+extern int gl_ltexture_array_add_pixels32(gl_ltexture_array* array, const GLuint* pixels, int width, int height, int pitch);
+
+///
+/// Add pixels of texture as a new layer.
+/// Texture must have its pixels i.e. loaded via gl_LTexture_load_pixels_from_file(), or locked.
+///
+/// \param array Pointer to gl_ltexture_array
+/// \param texture Texture to take pixels from
+/// \return Layer index, or -1 if texture has no pixels, it doesn't fit, or there's no free layer.
+///
+extern int gl_ltexture_array_add_texture_pixels(gl_ltexture_array* array, const gl_LTexture* texture);
+
+///
+/// Load image file as a new layer.
+///
+/// \param array Pointer to gl_ltexture_array
+/// \param path Image path to load
+/// \return Layer index, or -1 if it cannot be loaded, it doesn't fit, or there's no free layer.
+///
+extern int gl_ltexture_array_add_file(gl_ltexture_array* array, const char* path);
+
+///
+/// Create a new batch drawing from texture array.
+///
+/// \param array Texture array to draw from, it's not owned
+/// \param program Textured polygon program specialized with GL_LTEXTURE_ARRAY_DEFINE, it must be linked. It's not owned.
+/// \param capacity Maximum number of sprites in a single draw call
+/// \return Newly created gl_ltexture_array_batch on heap.
+///
+extern gl_ltexture_array_batch* gl_ltexture_array_batch_new(gl_ltexture_array* array, gl_lprogram* program, int capacity);
+
+///
+/// Free batch.
+///
+/// \param batch Pointer to gl_ltexture_array_batch
+///
+extern void gl_ltexture_array_batch_free(gl_ltexture_array_batch* batch);
+
+///
+/// Add sprite to batch.
+/// Batch is flushed first if it's full. Sprite of layer not loaded is skipped.
+///
+/// \param batch Pointer to gl_ltexture_array_batch
+/// \param layer Layer of image to draw, in [0, layer_count)
+/// \param x Position x to render
+/// \param y Position y to render
+/// \param clip Clipping rectangle in pixels of image. NULL to render whole image.
+///
+extern void gl_ltexture_array_batch_add(gl_ltexture_array_batch* batch, int layer, GLfloat x, GLfloat y, const LRect* clip);
+
+///
+/// Draw all sprites added since last flush in a single draw call.
+/// Program of batch gets bound.
+///
+/// \param batch Pointer to gl_ltexture_array_batch
+///
+extern void gl_ltexture_array_batch_flush(gl_ltexture_array_batch* batch);
+
+#endif
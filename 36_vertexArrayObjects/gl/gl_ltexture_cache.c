@@ -0,0 +1,271 @@
+#include "gl_ltexture_cache.h"
+#include "gl/gl_ltexture_manager_internals.h"
+#include "foundation/krr_hash.h"
+#include "SDL_image.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct texture_entry_
+{
+  // shared texture, NULL if entry is free for reuse
+  gl_LTexture* texture;
+  // hash of decoded pixels
+  uint64_t content_hash;
+  // number of references handed out
+  int refcount;
+  // byte cost on GPU
+  size_t bytes;
+};
+
+struct path_entry_
+{
+  uint64_t path_hash;
+  char* path;
+  // index into entries
+  int entry_index;
+};
+
+static void init_defaults_(gl_ltexture_cache* cache);
+static int find_path_(gl_ltexture_cache* cache, uint64_t path_hash, const char* path);
+static int find_content_(gl_ltexture_cache* cache, uint64_t content_hash, int width, int height);
+static int add_entry_(gl_ltexture_cache* cache, gl_LTexture* texture, uint64_t content_hash);
+static void add_path_(gl_ltexture_cache* cache, uint64_t path_hash, const char* path, int entry_index);
+
+void init_defaults_(gl_ltexture_cache* cache)
+{
+  memset(&cache->stats, 0, sizeof(cache->stats));
+  cache->entries_ = NULL;
+  cache->paths_ = NULL;
+}
+
+gl_ltexture_cache* gl_ltexture_cache_new()
+{
+  gl_ltexture_cache* out = malloc(sizeof(gl_ltexture_cache));
+  init_defaults_(out);
+
+  out->entries_ = vector_new(16, sizeof(struct texture_entry_));
+  out->paths_ = vector_new(16, sizeof(struct path_entry_));
+
+  return out;
+}
+
+void gl_ltexture_cache_free(gl_ltexture_cache* cache)
+{
+  if (cache != NULL)
+  {
+    for (int i=0; i<cache->entries_->len; i++)
+    {
+      struct texture_entry_* entry = vector_get(cache->entries_, i);
+      if (entry->texture != NULL)
+      {
+        gl_LTexture_free(entry->texture);
+        entry->texture = NULL;
+      }
+    }
+    vector_free(cache->entries_);
+    cache->entries_ = NULL;
+
+    for (int i=0; i<cache->paths_->len; i++)
+    {
+      struct path_entry_* pe = vector_get(cache->paths_, i);
+      free(pe->path);
+    }
+    vector_free(cache->paths_);
+    cache->paths_ = NULL;
+
+    free(cache);
+    cache = NULL;
+  }
+}
+
+int find_path_(gl_ltexture_cache* cache, uint64_t path_hash, const char* path)
+{
+  for (int i=0; i<cache->paths_->len; i++)
+  {
+    struct path_entry_* pe = vector_get(cache->paths_, i);
+    // compare hash first, string only to confirm
+    if (pe->path_hash == path_hash && strcmp(pe->path, path) == 0)
+    {
+      return pe->entry_index;
+    }
+  }
+  return -1;
+}
+
+int find_content_(gl_ltexture_cache* cache, uint64_t content_hash, int width, int height)
+{
+  for (int i=0; i<cache->entries_->len; i++)
+  {
+    struct texture_entry_* entry = vector_get(cache->entries_, i);
+    // 64-bit hash of pixels along with dimensions, collision is not worth keeping pixels around for
+    if (entry->texture != NULL && entry->content_hash == content_hash &&
+        entry->texture->width == width && entry->texture->height == height)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int add_entry_(gl_ltexture_cache* cache, gl_LTexture* texture, uint64_t content_hash)
+{
+  struct texture_entry_ new_entry;
+  new_entry.texture = texture;
+  new_entry.content_hash = content_hash;
+  new_entry.refcount = 1;
+  new_entry.bytes = texture->physical_width_ * texture->physical_height_ * sizeof(GLuint);
+
+  // reuse free entry first, indices of others must stay stable
+  for (int i=0; i<cache->entries_->len; i++)
+  {
+    struct texture_entry_* entry = vector_get(cache->entries_, i);
+    if (entry->texture == NULL)
+    {
+      *entry = new_entry;
+      return i;
+    }
+  }
+
+  vector_add(cache->entries_, &new_entry);
+  return cache->entries_->len - 1;
+}
+
+void add_path_(gl_ltexture_cache* cache, uint64_t path_hash, const char* path, int entry_index)
+{
+  struct path_entry_ pe;
+  pe.path_hash = path_hash;
+  pe.path = malloc(strlen(path) + 1);
+  strcpy(pe.path, path);
+  pe.entry_index = entry_index;
+
+  vector_add(cache->paths_, &pe);
+}
+
+gl_LTexture* gl_ltexture_cache_acquire(gl_ltexture_cache* cache, const char* path)
+{
+  // 1. same path loaded before, no decode, no upload
+  uint64_t path_hash = krr_hash_string(path);
+  int entry_index = find_path_(cache, path_hash, path);
+  if (entry_index != -1)
+  {
+    struct texture_entry_* entry = vector_get(cache->entries_, entry_index);
+    entry->refcount++;
+    cache->stats.path_hits++;
+    cache->stats.bytes_saved += entry->bytes;
+    return entry->texture;
+  }
+
+  // decode image
+  SDL_Surface* loaded_surface = IMG_Load(path);
+  if (loaded_surface == NULL)
+  {
+    SDL_Log("Unable to load image %s! SDL_Image error: %s", path, IMG_GetError());
+    return NULL;
+  }
+
+  SDL_Surface* converted_surface = SDL_ConvertSurfaceFormat(loaded_surface, SDL_PIXELFORMAT_ABGR8888, 0);
+  SDL_FreeSurface(loaded_surface);
+  loaded_surface = NULL;
+
+  if (converted_surface == NULL)
+  {
+    SDL_Log("Cannot convert to ABGR8888 format");
+    return NULL;
+  }
+
+  // 2. identical pixels loaded from another path, no upload
+  // rows are packed tightly first, surface's pitch can have padding of arbitrary content
+  const int width = converted_surface->w;
+  const int height = converted_surface->h;
+  const size_t row_bytes = (size_t)width * sizeof(GLuint);
+  GLuint* pixels = malloc(row_bytes * height);
+  for (int y=0; y<height; y++)
+  {
+    memcpy(pixels + (size_t)y * width, (const GLubyte*)converted_surface->pixels + (size_t)y * converted_surface->pitch, row_bytes);
+  }
+  SDL_FreeSurface(converted_surface);
+  converted_surface = NULL;
+
+  uint64_t content_hash = krr_hash_bytes(pixels, row_bytes * height, 0);
+  entry_index = find_content_(cache, content_hash, width, height);
+  if (entry_index != -1)
+  {
+    free(pixels);
+
+    struct texture_entry_* entry = vector_get(cache->entries_, entry_index);
+    entry->refcount++;
+    add_path_(cache, path_hash, path, entry_index);
+
+    cache->stats.content_hits++;
+    cache->stats.bytes_saved += entry->bytes;
+    return entry->texture;
+  }
+
+  // 3. miss, create a new texture
+  gl_LTexture* texture = gl_LTexture_new();
+  bool result = gl_LTexture_load_texture_from_pixels32(texture, pixels, width, height);
+  free(pixels);
+  pixels = NULL;
+
+  if (!result)
+  {
+    SDL_Log("Failed to create texture for %s", path);
+    gl_LTexture_free(texture);
+    return NULL;
+  }
+
+  // it can be reloaded from file if evicted by texture manager
+  gl_ltexture_manager_set_source(texture, GL_LTEXTURE_MANAGER_SOURCE_FILE, path, 0);
+
+  entry_index = add_entry_(cache, texture, content_hash);
+  add_path_(cache, path_hash, path, entry_index);
+  cache->stats.misses++;
+
+  return texture;
+}
+
+void gl_ltexture_cache_release(gl_ltexture_cache* cache, gl_LTexture* texture)
+{
+  for (int i=0; i<cache->entries_->len; i++)
+  {
+    struct texture_entry_* entry = vector_get(cache->entries_, i);
+    if (entry->texture != texture)
+    {
+      continue;
+    }
+
+    entry->refcount--;
+    if (entry->refcount > 0)
+    {
+      return;
+    }
+
+    // last reference, free texture and all paths mapping to it
+    gl_LTexture_free(entry->texture);
+    entry->texture = NULL;
+
+    for (int j=cache->paths_->len-1; j>=0; j--)
+    {
+      struct path_entry_* pe = vector_get(cache->paths_, j);
+      if (pe->entry_index == i)
+      {
+        free(pe->path);
+        vector_remove(cache->paths_, j);
+      }
+    }
+    return;
+  }
+
+  SDL_Log("Texture %p is not acquired from this cache", (void*)texture);
+}
+
+void gl_ltexture_cache_print_stats(gl_ltexture_cache* cache)
+{
+  const gl_ltexture_cache_stats* s = &cache->stats;
+  unsigned int total = s->path_hits + s->content_hits + s->misses;
+  float hit_rate = total > 0 ? (s->path_hits + s->content_hits) * 100.f / total : 0.f;
+
+  SDL_Log("Texture cache: %u acquires, path hits %u, content hits %u, misses %u, hit rate %.1f%%, bytes saved %llu",
+      total, s->path_hits, s->content_hits, s->misses, hit_rate, s->bytes_saved);
+}
@@ -0,0 +1,84 @@
+#ifndef gl_ltexture_cache_h_
+#define gl_ltexture_cache_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LTexture.h"
+#include "foundation/vector.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/// Texture cache which shares textures across repeated loads.
+///
+/// Textures are keyed by path, and by content hash of decoded pixels.
+/// - Acquire the same path again returns the same texture without decoding, nor uploading.
+/// - Acquire a different path with identical pixels returns the existing texture without uploading.
+///   Match is by 64-bit hash, and dimensions alone, decoded pixels are not kept once uploaded.
+///
+/// Textures are reference-counted, and freed when the last reference is released.
+
+/// hit/miss statistics
+typedef struct
+{
+  /// acquires satisfied by path, decode and upload skipped
+  unsigned int path_hits;
+  /// acquires satisfied by content hash, upload skipped
+  unsigned int content_hits;
+  /// acquires that had to decode and upload
+  unsigned int misses;
+  /// GPU bytes not allocated thanks to sharing
+  unsigned long long bytes_saved;
+} gl_ltexture_cache_stats;
+
+typedef struct
+{
+  /// (read-only) hit/miss statistics
+  gl_ltexture_cache_stats stats;
+
+  /// (internal use) shared textures
+  vector* entries_;
+  /// (internal use) paths mapping to entries
+  vector* paths_;
+} gl_ltexture_cache;
+
+///
+/// Create a new texture cache.
+///
+/// \return Newly created gl_ltexture_cache on heap.
+///
+extern gl_ltexture_cache* gl_ltexture_cache_new();
+
+///
+/// Free texture cache.
+/// All textures it holds will be freed regardless of their reference count.
+///
+/// \param cache Pointer to gl_ltexture_cache
+///
+extern void gl_ltexture_cache_free(gl_ltexture_cache* cache);
+
+///
+/// Acquire texture for image file.
+/// Returned texture is shared, don't free it directly but release it via gl_ltexture_cache_release().
+///
+/// \param cache Pointer to gl_ltexture_cache
+/// \param path Path to image file
+/// \return Shared texture, or NULL if loading failed.
+///
+extern gl_LTexture* gl_ltexture_cache_acquire(gl_ltexture_cache* cache, const char* path);
+
+///
+/// Release texture previously acquired.
+/// Texture is freed when there's no more reference to it.
+///
+/// \param cache Pointer to gl_ltexture_cache
+/// \param texture Texture returned from gl_ltexture_cache_acquire()
+///
+extern void gl_ltexture_cache_release(gl_ltexture_cache* cache, gl_LTexture* texture);
+
+///
+/// Print hit rate and bytes saved.
+///
+/// \param cache Pointer to gl_ltexture_cache
+///
+extern void gl_ltexture_cache_print_stats(gl_ltexture_cache* cache);
+
+#endif
@@ -0,0 +1,338 @@
+#include "gl_ltexture_manager.h"
+#include "gl_ltexture_manager_internals.h"
+#include "SDL_log.h"
+#include "SDL_timer.h"
+#include <stdlib.h>
+#include <string.h>
+
+gl_ltexture_manager* shared_texture_manager = NULL;
+
+struct texture_entry_
+{
+  // registered texture, NULL if this entry is free for reuse
+  gl_LTexture* texture;
+  // byte cost on GPU
+  size_t bytes;
+  // whether its GL texture object exists
+  bool resident;
+
+  // source to reload from, see gl_ltexture_manager_source
+  int source;
+  char* path;
+  GLuint color_key;
+
+  // value of use counter when it was used the last time
+  unsigned long long last_used;
+};
+
+static void init_defaults_(gl_ltexture_manager* manager);
+static struct texture_entry_* get_entry_(gl_LTexture* texture);
+static void evict_to_budget_(gl_ltexture_manager* manager, int exclude_handle);
+static bool reload_(struct texture_entry_* entry);
+
+void init_defaults_(gl_ltexture_manager* manager)
+{
+  manager->budget_bytes = 0;
+  manager->live_bytes = 0;
+  manager->peak_live_bytes = 0;
+  manager->evictions = 0;
+  manager->reload_stalls = 0;
+  manager->reload_stall_ms = 0.0;
+  manager->entries_ = NULL;
+  manager->use_counter_ = 0;
+}
+
+gl_ltexture_manager* gl_ltexture_manager_new(size_t budget_bytes)
+{
+  gl_ltexture_manager* out = malloc(sizeof(gl_ltexture_manager));
+  init_defaults_(out);
+
+  out->budget_bytes = budget_bytes;
+  out->entries_ = vector_new(32, sizeof(struct texture_entry_));
+
+  return out;
+}
+
+void gl_ltexture_manager_free(gl_ltexture_manager* manager)
+{
+  if (manager != NULL)
+  {
+    // detach all textures still registered
+    for (int i=0; i<manager->entries_->len; i++)
+    {
+      struct texture_entry_* entry = vector_get(manager->entries_, i);
+      if (entry->texture != NULL)
+      {
+        entry->texture->manager_handle_ = -1;
+      }
+      if (entry->path != NULL)
+      {
+        free(entry->path);
+      }
+    }
+
+    vector_free(manager->entries_);
+    manager->entries_ = NULL;
+
+    if (shared_texture_manager == manager)
+    {
+      shared_texture_manager = NULL;
+    }
+
+    free(manager);
+    manager = NULL;
+  }
+}
+
+void gl_ltexture_manager_set_budget(gl_ltexture_manager* manager, size_t budget_bytes)
+{
+  manager->budget_bytes = budget_bytes;
+  evict_to_budget_(manager, -1);
+}
+
+int gl_ltexture_manager_texture_count(gl_ltexture_manager* manager)
+{
+  int count = 0;
+  for (int i=0; i<manager->entries_->len; i++)
+  {
+    struct texture_entry_* entry = vector_get(manager->entries_, i);
+    if (entry->texture != NULL)
+    {
+      count++;
+    }
+  }
+  return count;
+}
+
+void gl_ltexture_manager_print_stats(gl_ltexture_manager* manager)
+{
+  int resident = 0;
+  int evicted = 0;
+  for (int i=0; i<manager->entries_->len; i++)
+  {
+    struct texture_entry_* entry = vector_get(manager->entries_, i);
+    if (entry->texture != NULL)
+    {
+      if (entry->resident)
+        resident++;
+      else
+        evicted++;
+    }
+  }
+
+  SDL_Log("Texture manager: live %zu bytes (peak %zu) / budget %zu, textures resident %d evicted %d, evictions %u, reload stalls %u (%.2f ms)",
+      manager->live_bytes, manager->peak_live_bytes, manager->budget_bytes, resident, evicted, manager->evictions, manager->reload_stalls, manager->reload_stall_ms);
+}
+
+struct texture_entry_* get_entry_(gl_LTexture* texture)
+{
+  if (shared_texture_manager == NULL || texture->manager_handle_ < 0)
+  {
+    return NULL;
+  }
+  return vector_get(shared_texture_manager->entries_, texture->manager_handle_);
+}
+
+void evict_to_budget_(gl_ltexture_manager* manager, int exclude_handle)
+{
+  if (manager->budget_bytes == 0)
+  {
+    return;
+  }
+
+  while (manager->live_bytes > manager->budget_bytes)
+  {
+    // find least-recently-used texture which can be reloaded
+    struct texture_entry_* lru = NULL;
+    for (int i=0; i<manager->entries_->len; i++)
+    {
+      struct texture_entry_* entry = vector_get(manager->entries_, i);
+      if (i == exclude_handle || entry->texture == NULL || !entry->resident || entry->source == GL_LTEXTURE_MANAGER_SOURCE_NONE)
+      {
+        continue;
+      }
+
+      if (lru == NULL || entry->last_used < lru->last_used)
+      {
+        lru = entry;
+      }
+    }
+
+    // the rest are pinned, nothing more we can do
+    if (lru == NULL)
+    {
+      break;
+    }
+
+    // delete only GL texture object, keep its dimensions and source
+    glDeleteTextures(1, &lru->texture->texture_id);
+    lru->texture->texture_id = 0;
+    lru->resident = false;
+
+    manager->live_bytes -= lru->bytes;
+    manager->evictions++;
+  }
+}
+
+bool reload_(struct texture_entry_* entry)
+{
+  // loaders reset source, so work on a copy of path
+  size_t path_len = strlen(entry->path);
+  char path[path_len + 1];
+  memcpy(path, entry->path, path_len + 1);
+
+  switch (entry->source)
+  {
+    case GL_LTEXTURE_MANAGER_SOURCE_FILE:
+      return gl_LTexture_load_texture_from_file(entry->texture, path);
+    case GL_LTEXTURE_MANAGER_SOURCE_FILE_COLOR_KEY:
+      return gl_LTexture_load_texture_from_file_ex(entry->texture, path, entry->color_key);
+    case GL_LTEXTURE_MANAGER_SOURCE_DDS:
+      return gl_LTexture_load_dds_texture_from_file(entry->texture, path);
+  }
+
+  return false;
+}
+
+void gl_ltexture_manager_on_upload(gl_LTexture* texture, size_t bytes)
+{
+  gl_ltexture_manager* manager = shared_texture_manager;
+  if (manager == NULL)
+  {
+    return;
+  }
+
+  // register texture if needed
+  if (texture->manager_handle_ < 0)
+  {
+    struct texture_entry_ new_entry;
+    memset(&new_entry, 0, sizeof(new_entry));
+    new_entry.texture = texture;
+
+    // reuse free entry first
+    for (int i=0; i<manager->entries_->len; i++)
+    {
+      struct texture_entry_* entry = vector_get(manager->entries_, i);
+      if (entry->texture == NULL)
+      {
+        *entry = new_entry;
+        texture->manager_handle_ = i;
+        break;
+      }
+    }
+
+    if (texture->manager_handle_ < 0)
+    {
+      vector_add(manager->entries_, &new_entry);
+      texture->manager_handle_ = manager->entries_->len - 1;
+    }
+  }
+
+  struct texture_entry_* entry = get_entry_(texture);
+  if (entry->resident)
+  {
+    manager->live_bytes -= entry->bytes;
+  }
+
+  // newly uploaded content has no source until loader sets it
+  if (entry->path != NULL)
+  {
+    free(entry->path);
+    entry->path = NULL;
+  }
+  entry->source = GL_LTEXTURE_MANAGER_SOURCE_NONE;
+
+  entry->bytes = bytes;
+  entry->resident = true;
+  entry->last_used = ++manager->use_counter_;
+
+  manager->live_bytes += bytes;
+  if (manager->live_bytes > manager->peak_live_bytes)
+  {
+    manager->peak_live_bytes = manager->live_bytes;
+  }
+
+  evict_to_budget_(manager, texture->manager_handle_);
+}
+
+void gl_ltexture_manager_on_release(gl_LTexture* texture)
+{
+  struct texture_entry_* entry = get_entry_(texture);
+  if (entry != NULL && entry->resident)
+  {
+    shared_texture_manager->live_bytes -= entry->bytes;
+    entry->resident = false;
+  }
+}
+
+void gl_ltexture_manager_on_free(gl_LTexture* texture)
+{
+  struct texture_entry_* entry = get_entry_(texture);
+  if (entry != NULL)
+  {
+    if (entry->resident)
+    {
+      shared_texture_manager->live_bytes -= entry->bytes;
+    }
+    if (entry->path != NULL)
+    {
+      free(entry->path);
+    }
+
+    // mark entry as free for reuse
+    memset(entry, 0, sizeof(struct texture_entry_));
+    texture->manager_handle_ = -1;
+  }
+}
+
+void gl_ltexture_manager_set_source(gl_LTexture* texture, enum gl_ltexture_manager_source source, const char* path, GLuint color_key)
+{
+  struct texture_entry_* entry = get_entry_(texture);
+  if (entry == NULL)
+  {
+    return;
+  }
+
+  if (entry->path != NULL)
+  {
+    free(entry->path);
+    entry->path = NULL;
+  }
+
+  entry->source = source;
+  entry->color_key = color_key;
+  if (source != GL_LTEXTURE_MANAGER_SOURCE_NONE && path != NULL)
+  {
+    entry->path = malloc(strlen(path) + 1);
+    strcpy(entry->path, path);
+  }
+  else
+  {
+    entry->source = GL_LTEXTURE_MANAGER_SOURCE_NONE;
+  }
+}
+
+void gl_ltexture_manager_touch(gl_LTexture* texture)
+{
+  struct texture_entry_* entry = get_entry_(texture);
+  if (entry == NULL)
+  {
+    return;
+  }
+
+  gl_ltexture_manager* manager = shared_texture_manager;
+
+  if (!entry->resident && entry->source != GL_LTEXTURE_MANAGER_SOURCE_NONE)
+  {
+    // rendering is blocked until texture is reloaded
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (!reload_(entry))
+    {
+      SDL_Log("Unable to reload evicted texture %s", entry->path != NULL ? entry->path : "");
+    }
+    manager->reload_stall_ms += (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    manager->reload_stalls++;
+  }
+
+  entry->last_used = ++manager->use_counter_;
+}
@@ -0,0 +1,87 @@
+#ifndef gl_ltexture_manager_h_
+#define gl_ltexture_manager_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LTexture.h"
+#include "foundation/vector.h"
+#include <stddef.h>
+#include <stdbool.h>
+
+/// Texture manager tracking GPU memory used by all live gl_LTexture.
+///
+/// Every texture uploaded to GPU while shared_texture_manager is set gets registered with its byte cost
+/// (physical size x bytes per pixel, including mipmaps). If total bytes go over budget, least-recently-rendered
+/// textures are evicted by deleting their GL texture object while keeping their dimensions, and source.
+/// Evicted texture is reloaded from its source when it's rendered again; such reload is counted as a stall.
+///
+/// Only textures loaded from file can be evicted. Textures created from pixels in memory (i.e. font's atlas)
+/// or which have been locked for modification are pinned but still counted.
+
+/// global shared texture manager that all instances of gl_LTexture will register with.
+/// Set to NULL (default) to disable tracking.
+struct gl_ltexture_manager_;
+extern struct gl_ltexture_manager_* shared_texture_manager;
+
+typedef struct gl_ltexture_manager_
+{
+  /// budget in bytes for all resident textures, 0 for unlimited
+  size_t budget_bytes;
+
+  /// (read-only) bytes of all textures currently resident on GPU
+  size_t live_bytes;
+  /// (read-only) highest live bytes seen so far
+  size_t peak_live_bytes;
+
+  /// (read-only) total number of textures evicted
+  unsigned int evictions;
+  /// (read-only) total number of reloads due to rendering evicted texture
+  unsigned int reload_stalls;
+  /// (read-only) total time spent in reloads in milliseconds
+  double reload_stall_ms;
+
+  /// (internal use) registered entries, handle of texture is its index
+  vector* entries_;
+  /// (internal use) counter increased every time a texture is used, for least-recently-used eviction
+  unsigned long long use_counter_;
+} gl_ltexture_manager;
+
+///
+/// Create a new texture manager.
+///
+/// \param budget_bytes Budget in bytes for all resident textures, 0 for unlimited.
+/// \return Newly created gl_ltexture_manager on heap.
+///
+extern gl_ltexture_manager* gl_ltexture_manager_new(size_t budget_bytes);
+
+///
+/// Free texture manager.
+/// Textures registered with it are not freed, they are just no longer tracked.
+///
+/// \param manager Pointer to gl_ltexture_manager
+///
+extern void gl_ltexture_manager_free(gl_ltexture_manager* manager);
+
+///
+/// Set budget then immediately evict textures to fit it.
+///
+/// \param manager Pointer to gl_ltexture_manager
+/// \param budget_bytes Budget in bytes, 0 for unlimited.
+///
+extern void gl_ltexture_manager_set_budget(gl_ltexture_manager* manager, size_t budget_bytes);
+
+///
+/// Get number of textures currently registered.
+///
+/// \param manager Pointer to gl_ltexture_manager
+/// \return Number of registered textures
+///
+extern int gl_ltexture_manager_texture_count(gl_ltexture_manager* manager);
+
+///
+/// Print memory usage and counters.
+///
+/// \param manager Pointer to gl_ltexture_manager
+///
+extern void gl_ltexture_manager_print_stats(gl_ltexture_manager* manager);
+
+#endif
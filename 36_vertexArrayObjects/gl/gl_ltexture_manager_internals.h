@@ -0,0 +1,66 @@
+#ifndef gl_ltexture_manager_internals_h_
+#define gl_ltexture_manager_internals_h_
+
+#include "gl/gl_ltexture_manager.h"
+
+/// These APIs are hooks called by gl_LTexture, and renderers which use it.
+/// All of them do nothing if shared_texture_manager is NULL.
+
+/// kind of source to reload texture from
+enum gl_ltexture_manager_source
+{
+  /// no source, texture cannot be evicted
+  GL_LTEXTURE_MANAGER_SOURCE_NONE = 0,
+  /// loaded via gl_LTexture_load_texture_from_file()
+  GL_LTEXTURE_MANAGER_SOURCE_FILE,
+  /// loaded via gl_LTexture_load_texture_from_file_ex()
+  GL_LTEXTURE_MANAGER_SOURCE_FILE_COLOR_KEY,
+  /// loaded via gl_LTexture_load_dds_texture_from_file()
+  GL_LTEXTURE_MANAGER_SOURCE_DDS
+};
+
+///
+/// Notify that texture has been uploaded to GPU.
+/// It registers texture if it's not registered yet, then evicts other textures if over budget.
+///
+/// \param texture Pointer to gl_LTexture
+/// \param bytes Byte cost on GPU
+///
+extern void gl_ltexture_manager_on_upload(gl_LTexture* texture, size_t bytes);
+
+///
+/// Notify that texture's GL texture object has been deleted.
+/// Texture is still registered.
+///
+/// \param texture Pointer to gl_LTexture
+///
+extern void gl_ltexture_manager_on_release(gl_LTexture* texture);
+
+///
+/// Notify that texture is about to be freed.
+/// It unregisters texture.
+///
+/// \param texture Pointer to gl_LTexture
+///
+extern void gl_ltexture_manager_on_free(gl_LTexture* texture);
+
+///
+/// Set source to reload texture from after eviction.
+/// Set GL_LTEXTURE_MANAGER_SOURCE_NONE to pin texture.
+///
+/// \param texture Pointer to gl_LTexture
+/// \param source Kind of source
+/// \param path Path to source file, it will be copied. NULL if source is GL_LTEXTURE_MANAGER_SOURCE_NONE.
+/// \param color_key Color key used with GL_LTEXTURE_MANAGER_SOURCE_FILE_COLOR_KEY
+///
+extern void gl_ltexture_manager_set_source(gl_LTexture* texture, enum gl_ltexture_manager_source source, const char* path, GLuint color_key);
+
+///
+/// Mark texture as used before rendering.
+/// If texture was evicted, it will be reloaded from its source immediately.
+///
+/// \param texture Pointer to gl_LTexture
+///
+extern void gl_ltexture_manager_touch(gl_LTexture* texture);
+
+#endif
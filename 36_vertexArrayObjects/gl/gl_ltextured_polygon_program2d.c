@@ -1,7 +1,10 @@
 #include "gl_ltextured_polygon_program2d.h"
+#include "gl/gl_lvertex_format.h"
 #include <stdlib.h>
 #include "SDL_log.h"
 
+static void query_locations_(void* user_data);
+
 gl_ltextured_polygon_program2d* gl_ltextured_polygon_program2d_new()
 {
   gl_ltextured_polygon_program2d* out = malloc(sizeof(gl_ltextured_polygon_program2d));
@@ -12,10 +15,10 @@ gl_ltextured_polygon_program2d* gl_ltextured_polygon_program2d_new()
   out->texcoord_location = -1;
   out->texture_color_location = -1;
   out->texture_sampler_location = -1;
-  glm_mat4_identity(out->projection_matrix);
-  out->projection_matrix_location = -1;
   glm_mat4_identity(out->modelview_matrix);
   out->modelview_matrix_location = -1;
+  glm_vec4_copy((vec4){0.f, 0.f, 1.f, 1.f}, out->texcoord_clip);
+  out->texcoord_clip_location = -1;
 
   // create underlying shader program
   out->program = gl_LShaderProgram_new();
@@ -38,74 +41,17 @@ bool gl_ltextured_polygon_program2d_load_program(gl_ltextured_polygon_program2d*
   // get underlying shader program
   gl_LShaderProgram* uprog = program->program;
 
-  // generate program
-  uprog->program_id = glCreateProgram();
-
-  // load vertex shader
-  GLuint vertex_shader = gl_LShaderProgram_load_shader_from_file("res/shaders/l_textured_polygon_program2d.vert", GL_VERTEX_SHADER);
-  // check errors
-  if (vertex_shader == -1)
-  {
-    glDeleteProgram(uprog->program_id);
-    uprog->program_id = 0;
-    return false;
-  }
-
-  // attach vertex shader
-  glAttachShader(uprog->program_id, vertex_shader);
-
-  // create fragment shader
-  GLuint fragment_shader = gl_LShaderProgram_load_shader_from_file("res/shaders/l_textured_polygon_program2d.frag", GL_FRAGMENT_SHADER);
-  // check errors
-  if (fragment_shader == -1)
-  {
-    // delete vertex shader
-    glDeleteShader(vertex_shader);
-    vertex_shader = -1;
-
-    // delete program
-    glDeleteProgram(uprog->program_id);
-    uprog->program_id = 0;
-    return false;
-  }
-
-  // attach fragment shader
-  glAttachShader(uprog->program_id, fragment_shader);
-
-  // link program
-  glLinkProgram(uprog->program_id);
-  // check errors
-  GLint link_status = GL_FALSE;
-  glGetProgramiv(uprog->program_id, GL_LINK_STATUS, &link_status);
-  if (link_status != GL_TRUE)
-  {
-    SDL_Log("Link program error %d", uprog->program_id);
-    gl_LShaderProgram_print_program_log(uprog->program_id);
-
-    // delete shaders
-    glDeleteShader(vertex_shader);
-    vertex_shader = -1;
-    glDeleteShader(fragment_shader);
-    fragment_shader = -1;
-    // delete program
-    glDeleteProgram(uprog->program_id);
-    uprog->program_id = 0;
-
-    return false;
-  }
+  // build program, restored from binary cache if available
+  // locations are looked up once it's linked
+  return gl_LShaderProgram_build_program(uprog, "res/shaders/l_textured_polygon_program2d.vert", "res/shaders/l_textured_polygon_program2d.frag", NULL, 0, query_locations_, program);
+}
 
-  // clean up
-  glDeleteShader(vertex_shader);
-  vertex_shader = -1;
-  glDeleteShader(fragment_shader);
-  fragment_shader = -1;
+void query_locations_(void* user_data)
+{
+  gl_ltextured_polygon_program2d* program = user_data;
+  gl_LShaderProgram* uprog = program->program;
 
   // get variable locations
-  program->projection_matrix_location = glGetUniformLocation(uprog->program_id, "projection_matrix");
-  if (program->projection_matrix_location == -1)
-  {
-    SDL_Log("Warning: projection_matrix is invalid glsl variable name");
-  }
   program->modelview_matrix_location = glGetUniformLocation(uprog->program_id, "modelview_matrix");
   if (program->modelview_matrix_location == -1)
   {
@@ -132,13 +78,14 @@ bool gl_ltextured_polygon_program2d_load_program(gl_ltextured_polygon_program2d*
   {
     SDL_Log("Warning: texture_sampler is invalid glsl variable name");
   }
-
-  return true;
-}
-
-void gl_ltextured_polygon_program2d_update_projection_matrix(gl_ltextured_polygon_program2d* program)
-{
-  glUniformMatrix4fv(program->projection_matrix_location, 1, GL_FALSE, program->projection_matrix[0]);
+  program->texcoord_clip_location = glGetUniformLocation(uprog->program_id, "texcoord_clip");
+  if (program->texcoord_clip_location == -1)
+  {
+    SDL_Log("Warning: texcoord_clip is invalid glsl variable name");
+  }
+  // (re)linked program has uniform at its initializer in shader, cached value must match it
+  // or next set of a stale cached value would be skipped
+  glm_vec4_copy((vec4){0.f, 0.f, 1.f, 1.f}, program->texcoord_clip);
 }
 
 void gl_ltextured_polygon_program2d_update_modelview_matrix(gl_ltextured_polygon_program2d* program)
@@ -156,11 +103,42 @@ void gl_ltextured_polygon_program2d_set_texcoord_pointer(gl_ltextured_polygon_pr
   glVertexAttribPointer(program->texcoord_location, 2, GL_FLOAT, GL_FALSE, stride, data);
 }
 
+void gl_ltextured_polygon_program2d_set_attrib_pointers(gl_ltextured_polygon_program2d* program, LVertexFormat2D format, const GLvoid* data)
+{
+  gl_lvertex_format_attrib position, texcoord;
+  gl_lvertex_format_textured_attribs(format, &position, &texcoord);
+
+  const GLsizei stride = gl_lvertex_format_stride(format);
+  glVertexAttribPointer(program->vertex_pos2d_location, position.size, position.type, position.normalized, stride, (const GLubyte*)data + position.offset);
+  glVertexAttribPointer(program->texcoord_location, texcoord.size, texcoord.type, texcoord.normalized, stride, (const GLubyte*)data + texcoord.offset);
+}
+
 void gl_ltextured_polygon_program2d_set_texture_color(gl_ltextured_polygon_program2d* program, LColorRGBA color)
 {
   glUniform4fv(program->texture_color_location, 1, (const GLfloat*)&color);
 }
 
+void gl_ltextured_polygon_program2d_set_texcoord_clip(gl_ltextured_polygon_program2d* program, GLfloat offset_s, GLfloat offset_t, GLfloat scale_s, GLfloat scale_t)
+{
+  // skip redundant update, it's called for every textured quad
+  if (program->texcoord_clip[0] == offset_s && program->texcoord_clip[1] == offset_t &&
+      program->texcoord_clip[2] == scale_s && program->texcoord_clip[3] == scale_t)
+  {
+    return;
+  }
+
+  program->texcoord_clip[0] = offset_s;
+  program->texcoord_clip[1] = offset_t;
+  program->texcoord_clip[2] = scale_s;
+  program->texcoord_clip[3] = scale_t;
+  glUniform4fv(program->texcoord_clip_location, 1, program->texcoord_clip);
+}
+
+void gl_ltextured_polygon_program2d_reset_texcoord_clip(gl_ltextured_polygon_program2d* program)
+{
+  gl_ltextured_polygon_program2d_set_texcoord_clip(program, 0.f, 0.f, 1.f, 1.f);
+}
+
 void gl_ltextured_polygon_program2d_set_texture_sampler(gl_ltextured_polygon_program2d* program, GLuint sampler)
 {
   glUniform1i(program->texture_sampler_location, sampler);
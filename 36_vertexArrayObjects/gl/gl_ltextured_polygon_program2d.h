@@ -3,6 +3,7 @@
 
 #include "gl/glLOpenGL.h"
 #include "gl/gl_LShaderProgram.h"
+#include "gl/gl_types.h"
 
 typedef struct gl_ltextured_polygon_program2d_
 {
@@ -18,14 +19,16 @@ typedef struct gl_ltextured_polygon_program2d_
   // uniform texture
   GLint texture_sampler_location;
 
-  // projection matrix
-  mat4 projection_matrix;
-  GLint projection_matrix_location;
-
   // modelview matrix
+  // projection, and view matrix are shared via frame constants, see gl_lframe_constants
   mat4 modelview_matrix;
   GLint modelview_matrix_location;
 
+  // texture coordinate clipping (offset s, offset t, scale s, scale t)
+  // (read-only) last value uploaded to gpu, used to skip redundant update
+  vec4 texcoord_clip;
+  GLint texcoord_clip_location;
+
 } gl_ltextured_polygon_program2d;
 
 ///
@@ -53,13 +56,6 @@ extern void gl_ltextured_polygon_program2d_free(gl_ltextured_polygon_program2d*
 ///
 extern bool gl_ltextured_polygon_program2d_load_program(gl_ltextured_polygon_program2d* program);
 
-///
-/// update projection matrix
-///
-/// \param program pointer to gl_ltextured_polygon_program2d
-///
-extern void gl_ltextured_polygon_program2d_update_projection_matrix(gl_ltextured_polygon_program2d* program);
-
 ///
 /// update modelview matrix
 ///
@@ -85,6 +81,16 @@ extern void gl_ltextured_polygon_program2d_set_vertex_pointer(gl_ltextured_polyg
 ///
 extern void gl_ltextured_polygon_program2d_set_texcoord_pointer(gl_ltextured_polygon_program2d* program, GLsizei stride, const GLvoid* data);
 
+///
+/// set both vertex, and texcoordinate pointer for vertices in specified layout
+/// (LVertexData2D, or LCompactVertexData2D, see gl/gl_lvertex_format.h)
+///
+/// \param program pointer to gl_ltextured_polygon_program2d
+/// \param format vertex format of bound vertex buffer
+/// \param data opaque pointer to data buffer offset of first vertex
+///
+extern void gl_ltextured_polygon_program2d_set_attrib_pointers(gl_ltextured_polygon_program2d* program, LVertexFormat2D format, const GLvoid* data);
+
 ///
 /// set texture color.
 /// color will be apply to all of texture's color.
@@ -94,6 +100,28 @@ extern void gl_ltextured_polygon_program2d_set_texcoord_pointer(gl_ltextured_pol
 ///
 extern void gl_ltextured_polygon_program2d_set_texture_color(gl_ltextured_polygon_program2d* program, LColorRGBA color);
 
+///
+/// set texture coordinate clipping.
+/// input texture coordinate in [0,1] will be mapped to [offset, offset+scale].
+/// it only updates to gpu if value is different from previously set value.
+/// gl_LTexture_render() changes it per draw, so other renderers using full texture coordinates
+/// should call gl_ltextured_polygon_program2d_reset_texcoord_clip() first.
+///
+/// \param program pointer to gl_ltextured_polygon_program2d
+/// \param offset_s offset of s coordinate
+/// \param offset_t offset of t coordinate
+/// \param scale_s scale of s coordinate
+/// \param scale_t scale of t coordinate
+///
+extern void gl_ltextured_polygon_program2d_set_texcoord_clip(gl_ltextured_polygon_program2d* program, GLfloat offset_s, GLfloat offset_t, GLfloat scale_s, GLfloat scale_t);
+
+///
+/// reset texture coordinate clipping to identity, texture coordinates are used as they are.
+///
+/// \param program pointer to gl_ltextured_polygon_program2d
+///
+extern void gl_ltextured_polygon_program2d_reset_texcoord_clip(gl_ltextured_polygon_program2d* program);
+
 ///
 /// set texture sampler to shader
 ///
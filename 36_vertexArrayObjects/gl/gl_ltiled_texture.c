@@ -0,0 +1,746 @@
+#include "gl_ltiled_texture.h"
+#include "gl/gl_LTexture_internals.h"
+#include "gl/gl_ltextured_polygon_program2d.h"
+#include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "gl/gl_lsampler_cache.h"
+#include "gl/gl_lvertex_format.h"
+#include "foundation/krr_math.h"
+#include "SDL_image.h"
+#include "SDL_log.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+// border pixels around each tile inside cache texture
+// prevent bleeding of neighbor slots when sampling with linear filtering
+#define TILE_BORDER 1
+
+enum tile_state_
+{
+  TILE_EMPTY = 0,
+  TILE_PENDING,
+  TILE_RESIDENT,
+  // prepared but no slot was free, waits for visible range to change
+  TILE_DROPPED
+};
+
+struct gl_ltiled_texture_tile_
+{
+  // one of tile_state_
+  int state;
+  // slot in cache texture if resident, otherwise -1
+  int slot;
+  // value of update counter when this tile was visible the last time
+  unsigned int last_visible;
+};
+
+struct tile_result_
+{
+  int tile;
+  // tile pixels including its border, ready to upload
+  GLuint* pixels;
+};
+
+struct gl_ltiled_texture_queue_
+{
+  SDL_mutex* mutex;
+  SDL_cond* cond;
+  bool quit;
+
+  // ring buffer of tile indices to prepare
+  int* requests;
+  int request_head;
+  int request_count;
+
+  // ring buffer of prepared tiles
+  struct tile_result_* results;
+  int result_head;
+  int result_count;
+
+  // capacity of both ring buffers; each tile can be in-flight only once
+  int capacity;
+};
+
+static void init_defaults_(gl_ltiled_texture* texture);
+static void free_source_(gl_ltiled_texture* texture);
+static bool setup_source_(gl_ltiled_texture* texture);
+static bool create_cache_(gl_ltiled_texture* texture);
+static void free_cache_(gl_ltiled_texture* texture);
+static int slot_size_(const gl_ltiled_texture* texture);
+static int find_slot_(gl_ltiled_texture* texture);
+static void upload_tile_(gl_ltiled_texture* texture, int tile_index, int slot, const GLuint* pixels);
+static void build_batch_(gl_ltiled_texture* texture, int tx0, int ty0, int tx1, int ty1);
+static GLuint* extract_tile_(const gl_ltiled_texture* texture, int tile_index);
+static int worker_run_(void* data);
+
+void init_defaults_(gl_ltiled_texture* texture)
+{
+  texture->width = 0;
+  texture->height = 0;
+  texture->tile_size = 0;
+  texture->tiles_x = 0;
+  texture->tiles_y = 0;
+  texture->max_uploads_per_update = 4;
+  memset(&texture->stats, 0, sizeof(texture->stats));
+
+  texture->cache_texture_ = NULL;
+  texture->slots_x_ = 0;
+  texture->slots_y_ = 0;
+  texture->slot_tiles_ = NULL;
+
+  texture->tiles_ = NULL;
+  texture->update_counter_ = 0;
+  memset(texture->visible_range_, -1, sizeof(texture->visible_range_));
+  texture->dropped_count_ = 0;
+
+  texture->source_pixels_ = NULL;
+  texture->source_pitch_ = 0;
+  texture->source_surface_ = NULL;
+  texture->source_map_.data = NULL;
+  texture->source_map_.size = 0;
+  texture->source_map_.mapped_ = false;
+
+  texture->worker_ = NULL;
+  texture->queue_ = NULL;
+
+  texture->VBO_id_ = 0;
+  texture->vertex_format_ = LVERTEX_FORMAT_COMPACT_SHORT;
+  texture->quad_count_ = 0;
+}
+
+gl_ltiled_texture* gl_ltiled_texture_new(int tile_size, int cache_slots_x, int cache_slots_y)
+{
+  gl_ltiled_texture* out = malloc(sizeof(gl_ltiled_texture));
+  init_defaults_(out);
+
+  out->tile_size = tile_size;
+  out->slots_x_ = cache_slots_x;
+  out->slots_y_ = cache_slots_y;
+
+  return out;
+}
+
+void gl_ltiled_texture_free(gl_ltiled_texture* texture)
+{
+  if (texture != NULL)
+  {
+    free_source_(texture);
+    free_cache_(texture);
+
+    free(texture);
+    texture = NULL;
+  }
+}
+
+int slot_size_(const gl_ltiled_texture* texture)
+{
+  return texture->tile_size + TILE_BORDER * 2;
+}
+
+void free_source_(gl_ltiled_texture* texture)
+{
+  // stop worker thread first, it reads from source pixels
+  if (texture->worker_ != NULL)
+  {
+    SDL_LockMutex(texture->queue_->mutex);
+    texture->queue_->quit = true;
+    SDL_CondBroadcast(texture->queue_->cond);
+    SDL_UnlockMutex(texture->queue_->mutex);
+
+    SDL_WaitThread(texture->worker_, NULL);
+    texture->worker_ = NULL;
+  }
+
+  if (texture->queue_ != NULL)
+  {
+    struct gl_ltiled_texture_queue_* q = texture->queue_;
+
+    // free prepared tiles which never got uploaded
+    for (int i=0; i<q->result_count; i++)
+    {
+      free(q->results[(q->result_head + i) % q->capacity].pixels);
+    }
+
+    SDL_DestroyCond(q->cond);
+    SDL_DestroyMutex(q->mutex);
+    free(q->requests);
+    free(q->results);
+    free(q);
+    texture->queue_ = NULL;
+  }
+
+  if (texture->source_surface_ != NULL)
+  {
+    SDL_FreeSurface(texture->source_surface_);
+    texture->source_surface_ = NULL;
+  }
+  krr_filemap_close(&texture->source_map_);
+  texture->source_pixels_ = NULL;
+  texture->source_pitch_ = 0;
+
+  if (texture->tiles_ != NULL)
+  {
+    free(texture->tiles_);
+    texture->tiles_ = NULL;
+  }
+
+  // all slots become free
+  if (texture->slot_tiles_ != NULL)
+  {
+    for (int i=0; i<texture->slots_x_ * texture->slots_y_; i++)
+    {
+      texture->slot_tiles_[i] = -1;
+    }
+  }
+
+  texture->width = 0;
+  texture->height = 0;
+  texture->tiles_x = 0;
+  texture->tiles_y = 0;
+  texture->quad_count_ = 0;
+  memset(&texture->stats, 0, sizeof(texture->stats));
+}
+
+void free_cache_(gl_ltiled_texture* texture)
+{
+  if (texture->cache_texture_ != NULL)
+  {
+    gl_LTexture_free(texture->cache_texture_);
+    texture->cache_texture_ = NULL;
+  }
+
+  if (texture->slot_tiles_ != NULL)
+  {
+    free(texture->slot_tiles_);
+    texture->slot_tiles_ = NULL;
+  }
+
+  if (texture->VBO_id_ != 0)
+  {
+    glDeleteBuffers(1, &texture->VBO_id_);
+    texture->VBO_id_ = 0;
+  }
+}
+
+bool create_cache_(gl_ltiled_texture* texture)
+{
+  // cache is created once and reused across loads
+  if (texture->cache_texture_ != NULL)
+  {
+    return true;
+  }
+
+  const int slot_size = slot_size_(texture);
+
+  // make sure cache texture fits within hardware limit
+  GLint max_texture_size = 0;
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+  texture->slots_x_ = krr_math_min(texture->slots_x_, max_texture_size / slot_size);
+  texture->slots_y_ = krr_math_min(texture->slots_y_, max_texture_size / slot_size);
+  if (texture->slots_x_ <= 0 || texture->slots_y_ <= 0)
+  {
+    SDL_Log("Tile size %d is too large for GL_MAX_TEXTURE_SIZE %d", texture->tile_size, max_texture_size);
+    return false;
+  }
+
+  // create blank cache texture, its content will be filled per tile
+  texture->cache_texture_ = gl_LTexture_new();
+  gl_LTexture_create_pixels32(texture->cache_texture_, texture->slots_x_ * slot_size, texture->slots_y_ * slot_size);
+  gl_LTexture_pad_pixels32(texture->cache_texture_);
+  if (!gl_LTexture_load_texture_from_precreated_pixels32(texture->cache_texture_))
+  {
+    SDL_Log("Unable to create cache texture for tiled texture");
+    gl_LTexture_free(texture->cache_texture_);
+    texture->cache_texture_ = NULL;
+    return false;
+  }
+
+  const int slot_count = texture->slots_x_ * texture->slots_y_;
+  texture->slot_tiles_ = malloc(slot_count * sizeof(int));
+  for (int i=0; i<slot_count; i++)
+  {
+    texture->slot_tiles_[i] = -1;
+  }
+
+  // vertex buffer big enough to hold quads for all slots in format picked by setup_source_()
+  glGenBuffers(1, &texture->VBO_id_);
+  glBindBuffer(GL_ARRAY_BUFFER, texture->VBO_id_);
+  glBufferData(GL_ARRAY_BUFFER, slot_count * 4 * gl_lvertex_format_stride(texture->vertex_format_), NULL, GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  GLenum error = GL_LDEBUG_GET_ERROR();
+  if (error != GL_NO_ERROR)
+  {
+    SDL_Log("Error creating tile cache: %s", gl_util_error_string(error));
+    free_cache_(texture);
+    return false;
+  }
+
+  return true;
+}
+
+bool setup_source_(gl_ltiled_texture* texture)
+{
+  // tile positions are whole pixels of source image, they fit 16-bit shorts unless image is huge
+  // picked per load as cache is reused across loads of differently sized images
+  const LVertexFormat2D vertex_format = (texture->width <= 32767 && texture->height <= 32767) ? LVERTEX_FORMAT_COMPACT_SHORT : LVERTEX_FORMAT_FLOAT;
+  if (texture->VBO_id_ != 0 && vertex_format != texture->vertex_format_)
+  {
+    // existing vertex buffer is sized for stride of previous format
+    const int slot_count = texture->slots_x_ * texture->slots_y_;
+    glBindBuffer(GL_ARRAY_BUFFER, texture->VBO_id_);
+    glBufferData(GL_ARRAY_BUFFER, slot_count * 4 * gl_lvertex_format_stride(vertex_format), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    GLenum error = GL_LDEBUG_GET_ERROR();
+    if (error != GL_NO_ERROR)
+    {
+      SDL_Log("Error resizing tile cache vertex buffer: %s", gl_util_error_string(error));
+      return false;
+    }
+  }
+  texture->vertex_format_ = vertex_format;
+
+  if (!create_cache_(texture))
+  {
+    return false;
+  }
+
+  texture->tiles_x = (texture->width + texture->tile_size - 1) / texture->tile_size;
+  texture->tiles_y = (texture->height + texture->tile_size - 1) / texture->tile_size;
+
+  const int tile_count = texture->tiles_x * texture->tiles_y;
+  texture->tiles_ = malloc(tile_count * sizeof(struct gl_ltiled_texture_tile_));
+  for (int i=0; i<tile_count; i++)
+  {
+    texture->tiles_[i].state = TILE_EMPTY;
+    texture->tiles_[i].slot = -1;
+    texture->tiles_[i].last_visible = 0;
+  }
+  texture->update_counter_ = 0;
+  memset(texture->visible_range_, -1, sizeof(texture->visible_range_));
+  texture->dropped_count_ = 0;
+
+  // create queues then start worker thread
+  struct gl_ltiled_texture_queue_* q = malloc(sizeof(struct gl_ltiled_texture_queue_));
+  q->mutex = SDL_CreateMutex();
+  q->cond = SDL_CreateCond();
+  q->quit = false;
+  q->capacity = tile_count;
+  q->requests = malloc(tile_count * sizeof(int));
+  q->request_head = 0;
+  q->request_count = 0;
+  q->results = malloc(tile_count * sizeof(struct tile_result_));
+  q->result_head = 0;
+  q->result_count = 0;
+  texture->queue_ = q;
+
+  texture->worker_ = SDL_CreateThread(worker_run_, "ltiled_texture", texture);
+  if (texture->worker_ == NULL)
+  {
+    SDL_Log("Unable to create worker thread for tiled texture: %s", SDL_GetError());
+    free_source_(texture);
+    return false;
+  }
+
+  SDL_Log("Tiled texture %dx%d split into %dx%d tiles, cache has %dx%d slots", texture->width, texture->height, texture->tiles_x, texture->tiles_y, texture->slots_x_, texture->slots_y_);
+
+  return true;
+}
+
+bool gl_ltiled_texture_load_from_file(gl_ltiled_texture* texture, const char* path)
+{
+  free_source_(texture);
+
+  SDL_Surface* loaded_surface = IMG_Load(path);
+  if (loaded_surface == NULL)
+  {
+    SDL_Log("Unable to load image %s! SDL_Image error: %s", path, IMG_GetError());
+    return false;
+  }
+
+  // convert to RGBA8 byte order as used by gl_LTexture
+  SDL_Surface* converted_surface = SDL_ConvertSurfaceFormat(loaded_surface, SDL_PIXELFORMAT_ABGR8888, 0);
+  SDL_FreeSurface(loaded_surface);
+  loaded_surface = NULL;
+
+  if (converted_surface == NULL)
+  {
+    SDL_Log("Cannot convert to ABGR8888 format");
+    return false;
+  }
+
+  // keep converted surface as the source, no need to copy such large pixel data
+  texture->source_surface_ = converted_surface;
+  texture->source_pixels_ = converted_surface->pixels;
+  texture->source_pitch_ = converted_surface->pitch / sizeof(GLuint);
+  texture->width = converted_surface->w;
+  texture->height = converted_surface->h;
+
+  return setup_source_(texture);
+}
+
+bool gl_ltiled_texture_load_from_raw_file(gl_ltiled_texture* texture, const char* path, int width, int height)
+{
+  free_source_(texture);
+
+  // negative dimensions would wrap around in size check below
+  if (width <= 0 || height <= 0)
+  {
+    SDL_Log("Invalid dimensions %dx%d for raw file %s", width, height, path);
+    return false;
+  }
+
+  if (!krr_filemap_open(&texture->source_map_, path))
+  {
+    return false;
+  }
+
+  if (texture->source_map_.size < (size_t)width * height * sizeof(GLuint))
+  {
+    SDL_Log("Raw file %s has %zu bytes, less than expected for %dx%d RGBA8 image", path, texture->source_map_.size, width, height);
+    krr_filemap_close(&texture->source_map_);
+    return false;
+  }
+
+  texture->source_pixels_ = texture->source_map_.data;
+  texture->source_pitch_ = width;
+  texture->width = width;
+  texture->height = height;
+
+  return setup_source_(texture);
+}
+
+GLuint* extract_tile_(const gl_ltiled_texture* texture, int tile_index)
+{
+  const int slot_size = slot_size_(texture);
+  const int tx = tile_index % texture->tiles_x;
+  const int ty = tile_index / texture->tiles_x;
+
+  // top-left of source region including border
+  const int src_x = tx * texture->tile_size - TILE_BORDER;
+  const int src_y = ty * texture->tile_size - TILE_BORDER;
+
+  GLuint* pixels = malloc(slot_size * slot_size * sizeof(GLuint));
+
+  for (int row=0; row<slot_size; row++)
+  {
+    // clamp to image's edge, thus border and out-of-image part repeat edge pixels
+    int sy = krr_math_min(krr_math_max(src_y + row, 0), texture->height - 1);
+    const GLuint* src_row = texture->source_pixels_ + (size_t)sy * texture->source_pitch_;
+    GLuint* dst_row = pixels + row * slot_size;
+
+    for (int col=0; col<slot_size; col++)
+    {
+      int sx = krr_math_min(krr_math_max(src_x + col, 0), texture->width - 1);
+      dst_row[col] = src_row[sx];
+    }
+  }
+
+  return pixels;
+}
+
+int worker_run_(void* data)
+{
+  gl_ltiled_texture* texture = data;
+  struct gl_ltiled_texture_queue_* q = texture->queue_;
+
+  while (true)
+  {
+    SDL_LockMutex(q->mutex);
+    while (!q->quit && q->request_count == 0)
+    {
+      SDL_CondWait(q->cond, q->mutex);
+    }
+    if (q->quit)
+    {
+      SDL_UnlockMutex(q->mutex);
+      break;
+    }
+
+    int tile_index = q->requests[q->request_head];
+    q->request_head = (q->request_head + 1) % q->capacity;
+    q->request_count--;
+    SDL_UnlockMutex(q->mutex);
+
+    // heavy lifting happens without holding the lock
+    GLuint* pixels = extract_tile_(texture, tile_index);
+
+    SDL_LockMutex(q->mutex);
+    int tail = (q->result_head + q->result_count) % q->capacity;
+    q->results[tail].tile = tile_index;
+    q->results[tail].pixels = pixels;
+    q->result_count++;
+    SDL_UnlockMutex(q->mutex);
+  }
+
+  return 0;
+}
+
+int find_slot_(gl_ltiled_texture* texture)
+{
+  const int slot_count = texture->slots_x_ * texture->slots_y_;
+
+  // prefer free slot
+  int lru_slot = -1;
+  unsigned int lru_last_visible = texture->update_counter_;
+  for (int i=0; i<slot_count; i++)
+  {
+    int tile = texture->slot_tiles_[i];
+    if (tile == -1)
+    {
+      return i;
+    }
+
+    // only tiles not visible in this update can be evicted
+    if (texture->tiles_[tile].last_visible < lru_last_visible)
+    {
+      lru_last_visible = texture->tiles_[tile].last_visible;
+      lru_slot = i;
+    }
+  }
+
+  if (lru_slot != -1)
+  {
+    // evict its tile
+    struct gl_ltiled_texture_tile_* evicted = &texture->tiles_[texture->slot_tiles_[lru_slot]];
+    evicted->state = TILE_EMPTY;
+    evicted->slot = -1;
+    texture->slot_tiles_[lru_slot] = -1;
+    texture->stats.total_evictions++;
+    texture->stats.resident_tiles--;
+  }
+
+  return lru_slot;
+}
+
+void upload_tile_(gl_ltiled_texture* texture, int tile_index, int slot, const GLuint* pixels)
+{
+  const int slot_size = slot_size_(texture);
+  const int slot_x = slot % texture->slots_x_;
+  const int slot_y = slot / texture->slots_x_;
+
+  glBindTexture(GL_TEXTURE_2D, texture->cache_texture_->texture_id);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, slot_x * slot_size, slot_y * slot_size, slot_size, slot_size, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  texture->slot_tiles_[slot] = tile_index;
+  texture->tiles_[tile_index].state = TILE_RESIDENT;
+  texture->tiles_[tile_index].slot = slot;
+
+  texture->stats.resident_tiles++;
+  texture->stats.total_uploads++;
+  texture->stats.total_uploaded_bytes += slot_size * slot_size * sizeof(GLuint);
+  texture->stats.frame_uploads++;
+}
+
+void gl_ltiled_texture_update(gl_ltiled_texture* texture, const LRect* view)
+{
+  if (texture->tiles_ == NULL)
+  {
+    return;
+  }
+
+  struct gl_ltiled_texture_queue_* q = texture->queue_;
+  texture->update_counter_++;
+  texture->stats.frame_uploads = 0;
+
+  // find range of visible tiles
+  const int ts = texture->tile_size;
+  int tx0 = krr_math_max((int)(view->x / ts), 0);
+  int ty0 = krr_math_max((int)(view->y / ts), 0);
+  int tx1 = krr_math_min((int)((view->x + view->w - 1) / ts), texture->tiles_x - 1);
+  int ty1 = krr_math_min((int)((view->y + view->h - 1) / ts), texture->tiles_y - 1);
+
+  // dropped tiles might fit now that different tiles are visible
+  const int range[4] = { tx0, ty0, tx1, ty1 };
+  if (memcmp(range, texture->visible_range_, sizeof(range)) != 0)
+  {
+    memcpy(texture->visible_range_, range, sizeof(range));
+
+    const int tile_count = texture->tiles_x * texture->tiles_y;
+    for (int i=0; i<tile_count && texture->dropped_count_ > 0; i++)
+    {
+      if (texture->tiles_[i].state == TILE_DROPPED)
+      {
+        texture->tiles_[i].state = TILE_EMPTY;
+        texture->dropped_count_--;
+      }
+    }
+  }
+
+  // request missing visible tiles
+  texture->stats.visible_tiles = 0;
+  bool requested = false;
+  SDL_LockMutex(q->mutex);
+  for (int ty=ty0; ty<=ty1; ty++)
+  {
+    for (int tx=tx0; tx<=tx1; tx++)
+    {
+      int tile_index = ty * texture->tiles_x + tx;
+      struct gl_ltiled_texture_tile_* tile = &texture->tiles_[tile_index];
+      tile->last_visible = texture->update_counter_;
+      texture->stats.visible_tiles++;
+
+      if (tile->state == TILE_EMPTY)
+      {
+        int tail = (q->request_head + q->request_count) % q->capacity;
+        q->requests[tail] = tile_index;
+        q->request_count++;
+
+        tile->state = TILE_PENDING;
+        texture->stats.pending_requests++;
+        texture->stats.total_requests++;
+        requested = true;
+      }
+    }
+  }
+  if (requested)
+  {
+    SDL_CondSignal(q->cond);
+  }
+  SDL_UnlockMutex(q->mutex);
+
+  // upload prepared tiles
+  while (texture->stats.frame_uploads < texture->max_uploads_per_update)
+  {
+    SDL_LockMutex(q->mutex);
+    if (q->result_count == 0)
+    {
+      SDL_UnlockMutex(q->mutex);
+      break;
+    }
+    struct tile_result_ result = q->results[q->result_head];
+    q->result_head = (q->result_head + 1) % q->capacity;
+    q->result_count--;
+    SDL_UnlockMutex(q->mutex);
+
+    texture->stats.pending_requests--;
+
+    int slot = find_slot_(texture);
+    if (slot != -1)
+    {
+      upload_tile_(texture, result.tile, slot, result.pixels);
+    }
+    else
+    {
+      // cache is full of visible tiles, drop it; requesting it again would only be dropped again
+      // until visible range changes
+      texture->tiles_[result.tile].state = TILE_DROPPED;
+      texture->dropped_count_++;
+    }
+
+    free(result.pixels);
+  }
+
+  build_batch_(texture, tx0, ty0, tx1, ty1);
+}
+
+void build_batch_(gl_ltiled_texture* texture, int tx0, int ty0, int tx1, int ty1)
+{
+  const int ts = texture->tile_size;
+  const int slot_size = slot_size_(texture);
+  const GLfloat pwidth = texture->cache_texture_->physical_width_;
+  const GLfloat pheight = texture->cache_texture_->physical_height_;
+
+  // at most all slots can be visible
+  const int slot_count = texture->slots_x_ * texture->slots_y_;
+  LVertexData2D* vertex_data = malloc(slot_count * 4 * sizeof(LVertexData2D));
+  int quad_count = 0;
+
+  for (int ty=ty0; ty<=ty1; ty++)
+  {
+    for (int tx=tx0; tx<=tx1; tx++)
+    {
+      struct gl_ltiled_texture_tile_* tile = &texture->tiles_[ty * texture->tiles_x + tx];
+      if (tile->state != TILE_RESIDENT)
+      {
+        continue;
+      }
+
+      // tiles at right, and bottom edge might be partially filled
+      GLfloat quad_x = tx * ts;
+      GLfloat quad_y = ty * ts;
+      GLfloat quad_w = krr_math_min(ts, texture->width - tx * ts);
+      GLfloat quad_h = krr_math_min(ts, texture->height - ty * ts);
+
+      // texture coordinates of tile content inside its slot (skip border)
+      GLfloat slot_px = (tile->slot % texture->slots_x_) * slot_size + TILE_BORDER;
+      GLfloat slot_py = (tile->slot / texture->slots_x_) * slot_size + TILE_BORDER;
+      GLfloat tex_left = slot_px / pwidth;
+      GLfloat tex_right = (slot_px + quad_w) / pwidth;
+      GLfloat tex_top = slot_py / pheight;
+      GLfloat tex_bottom = (slot_py + quad_h) / pheight;
+
+      LVertexData2D* v = vertex_data + quad_count * 4;
+      v[0].position.x = quad_x;           v[0].position.y = quad_y;
+      v[1].position.x = quad_x + quad_w;  v[1].position.y = quad_y;
+      v[2].position.x = quad_x + quad_w;  v[2].position.y = quad_y + quad_h;
+      v[3].position.x = quad_x;           v[3].position.y = quad_y + quad_h;
+
+      v[0].texcoord.s = tex_left;         v[0].texcoord.t = tex_top;
+      v[1].texcoord.s = tex_right;        v[1].texcoord.t = tex_top;
+      v[2].texcoord.s = tex_right;        v[2].texcoord.t = tex_bottom;
+      v[3].texcoord.s = tex_left;         v[3].texcoord.t = tex_bottom;
+
+      quad_count++;
+    }
+  }
+
+  if (quad_count > 0)
+  {
+    gl_lvertex_format_pack(texture->vertex_format_, vertex_data, quad_count * 4, vertex_data);
+    glBindBuffer(GL_ARRAY_BUFFER, texture->VBO_id_);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, quad_count * 4 * gl_lvertex_format_stride(texture->vertex_format_), vertex_data);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+  texture->quad_count_ = quad_count;
+
+  free(vertex_data);
+}
+
+void gl_ltiled_texture_render(gl_ltiled_texture* texture, GLfloat x, GLfloat y)
+{
+  if (texture->quad_count_ == 0)
+  {
+    return;
+  }
+
+  // save original modelview matrix
+  mat4 original_modelview_matrix;
+  glm_mat4_copy(shared_textured_shaderprogram->modelview_matrix, original_modelview_matrix);
+
+  // move to rendering position
+  glm_translate(shared_textured_shaderprogram->modelview_matrix, (vec3){x, y, 0.f});
+  gl_ltextured_polygon_program2d_update_modelview_matrix(shared_textured_shaderprogram);
+  // batch has final texture coordinates
+  gl_ltextured_polygon_program2d_reset_texcoord_clip(shared_textured_shaderprogram);
+
+  glBindTexture(GL_TEXTURE_2D, texture->cache_texture_->texture_id);
+  gl_lsampler_cache_bind(0, texture->cache_texture_->sampler);
+
+  gl_ltextured_polygon_program2d_enable_attrib_pointers(shared_textured_shaderprogram);
+
+    glBindBuffer(GL_ARRAY_BUFFER, texture->VBO_id_);
+    gl_ltextured_polygon_program2d_set_attrib_pointers(shared_textured_shaderprogram, texture->vertex_format_, NULL);
+
+    // draw all visible tiles at once
+    gl_lvertex_format_draw_quads(0, texture->quad_count_);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  gl_ltextured_polygon_program2d_disable_attrib_pointers(shared_textured_shaderprogram);
+
+  // set modelview matrix back to original one
+  glm_mat4_copy(original_modelview_matrix, shared_textured_shaderprogram->modelview_matrix);
+}
+
+void gl_ltiled_texture_print_stats(gl_ltiled_texture* texture)
+{
+  const gl_ltiled_texture_stats* s = &texture->stats;
+  SDL_Log("Tiled texture: visible %d, resident %d/%d, pending %d, requests %u, uploads %u (%llu bytes), evictions %u, uploads this update %d",
+      s->visible_tiles, s->resident_tiles, texture->slots_x_ * texture->slots_y_, s->pending_requests,
+      s->total_requests, s->total_uploads, s->total_uploaded_bytes, s->total_evictions, s->frame_uploads);
+}
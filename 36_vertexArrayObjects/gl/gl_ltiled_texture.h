@@ -0,0 +1,177 @@
+#ifndef gl_ltiled_texture_h_
+#define gl_ltiled_texture_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_LTexture.h"
+#include "gl/gl_types.h"
+#include "foundation/krr_filemap.h"
+#include "SDL.h"
+#include <stdbool.h>
+
+/// Virtual tiled texture for images larger than GL_MAX_TEXTURE_SIZE or too large to keep on GPU.
+///
+/// Source image is split into fixed-size tiles. Only tiles intersecting the current view are kept
+/// resident on GPU inside a single cache texture (built on gl_LTexture) which holds a fixed number of tile slots.
+/// Tile pixels are prepared by a worker thread from source pixels (decoded image, or memory-mapped raw file)
+/// then uploaded by the main thread as it owns OpenGL context.
+/// All visible resident tiles are rendered in a single batched draw call.
+
+/// residency and upload statistics
+typedef struct
+{
+  /// number of tiles currently resident on GPU
+  int resident_tiles;
+  /// number of tile requests waiting for, or being processed by worker thread
+  int pending_requests;
+  /// number of tiles visible in the last update
+  int visible_tiles;
+
+  /// total tile requests sent to worker thread
+  unsigned int total_requests;
+  /// total tile uploads to GPU
+  unsigned int total_uploads;
+  /// total bytes uploaded to GPU
+  unsigned long long total_uploaded_bytes;
+  /// total tiles evicted from GPU to make room for others
+  unsigned int total_evictions;
+
+  /// number of tile uploads in the last update
+  int frame_uploads;
+} gl_ltiled_texture_stats;
+
+/// (internal use) per-tile state
+struct gl_ltiled_texture_tile_;
+/// (internal use) request/result queues shared with worker thread
+struct gl_ltiled_texture_queue_;
+
+typedef struct
+{
+  /// (read-only) source image width in pixels
+  int width;
+  /// (read-only) source image height in pixels
+  int height;
+
+  /// (read-only) tile size in pixels, excluding its border
+  int tile_size;
+  /// (read-only) number of tiles in horizontal direction
+  int tiles_x;
+  /// (read-only) number of tiles in vertical direction
+  int tiles_y;
+
+  /// maximum number of tiles to upload in a single update
+  /// spread upload cost across frames to avoid frame hitches
+  int max_uploads_per_update;
+
+  /// (read-only) residency and upload statistics
+  gl_ltiled_texture_stats stats;
+
+  /// (internal use) cache texture holding resident tiles in slots
+  gl_LTexture* cache_texture_;
+  /// (internal use) number of slots in horizontal direction of cache texture
+  int slots_x_;
+  /// (internal use) number of slots in vertical direction of cache texture
+  int slots_y_;
+  /// (internal use) tile index occupying each slot, -1 for free slot
+  int* slot_tiles_;
+
+  /// (internal use) all tiles
+  struct gl_ltiled_texture_tile_* tiles_;
+  /// (internal use) counter increased every update, used for least-recently-used eviction
+  unsigned int update_counter_;
+  /// (internal use) range of visible tiles in last update as x0, y0, x1, y1
+  int visible_range_[4];
+  /// (internal use) number of tiles dropped as cache was full of visible tiles
+  /// they're not requested again until visible range changes
+  int dropped_count_;
+
+  /// (internal use) source pixels in RGBA8
+  const GLuint* source_pixels_;
+  /// (internal use) source row pitch in pixels
+  int source_pitch_;
+  /// (internal use) surface owning source pixels if loaded from image file
+  SDL_Surface* source_surface_;
+  /// (internal use) file map owning source pixels if loaded from raw file
+  krr_filemap source_map_;
+
+  /// (internal use) worker thread
+  SDL_Thread* worker_;
+  /// (internal use) queues shared with worker thread
+  struct gl_ltiled_texture_queue_* queue_;
+
+  /// (internal use) vertex buffer for batched rendering, drawn from shared quad index buffer
+  GLuint VBO_id_;
+  /// (internal use) vertex layout of batch, compact unless image exceeds range of 16-bit positions
+  LVertexFormat2D vertex_format_;
+  /// (internal use) number of quads to draw for visible resident tiles
+  int quad_count_;
+} gl_ltiled_texture;
+
+///
+/// Create a new tiled texture.
+///
+/// \param tile_size Size of each tile in pixels. It should be power-of-two minus 2 (border) for best memory usage i.e. 254, or 510.
+/// \param cache_slots_x Number of tile slots in horizontal direction of cache texture on GPU
+/// \param cache_slots_y Number of tile slots in vertical direction of cache texture on GPU
+/// \return Newly created gl_ltiled_texture on heap.
+///
+extern gl_ltiled_texture* gl_ltiled_texture_new(int tile_size, int cache_slots_x, int cache_slots_y);
+
+///
+/// Free tiled texture.
+/// It will stop its worker thread, and free all GPU resources.
+///
+/// \param texture Pointer to gl_ltiled_texture
+///
+extern void gl_ltiled_texture_free(gl_ltiled_texture* texture);
+
+///
+/// Load source image from file.
+/// Image is decoded into RGBA8 in memory once, but none of its tile is uploaded until it's visible.
+///
+/// \param texture Pointer to gl_ltiled_texture
+/// \param path Path to image file
+/// \return True if load successfully, otherwise return false.
+///
+extern bool gl_ltiled_texture_load_from_file(gl_ltiled_texture* texture, const char* path);
+
+///
+/// Load source image from raw RGBA8 file (no header, tightly packed rows).
+/// File is memory-mapped so only pages of visible tiles are read from disk.
+///
+/// \param texture Pointer to gl_ltiled_texture
+/// \param path Path to raw file
+/// \param width Image width in pixels
+/// \param height Image height in pixels
+/// \return True if load successfully, otherwise return false.
+///
+extern bool gl_ltiled_texture_load_from_raw_file(gl_ltiled_texture* texture, const char* path, int width, int height);
+
+///
+/// Update residency for the current view.
+/// It requests missing visible tiles from worker thread, then uploads tiles which are ready
+/// (up to max_uploads_per_update), evicting least-recently-visible tiles if cache is full.
+/// Call this once per frame before rendering.
+///
+/// \param texture Pointer to gl_ltiled_texture
+/// \param view Visible region in image's pixel coordinate
+///
+extern void gl_ltiled_texture_update(gl_ltiled_texture* texture, const LRect* view);
+
+///
+/// Render all visible resident tiles in a single draw call.
+/// It uses shared_textured_shaderprogram, thus it needs to be bound before calling this function.
+///
+/// \param texture Pointer to gl_ltiled_texture
+/// \param x Position x to render image's origin
+/// \param y Position y to render image's origin
+///
+extern void gl_ltiled_texture_render(gl_ltiled_texture* texture, GLfloat x, GLfloat y);
+
+///
+/// Print residency and upload statistics.
+///
+/// \param texture Pointer to gl_ltiled_texture
+///
+extern void gl_ltiled_texture_print_stats(gl_ltiled_texture* texture);
+
+#endif
@@ -0,0 +1,241 @@
+#include "gl_lvertex_format.h"
+#include "gl/gl_util.h"
+#include "gl/gl_ldebug.h"
+#include "foundation/krr_math.h"
+#include "SDL_log.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// shared quad index buffer, created on first use
+static GLuint quad_IBO_id_ = 0;
+
+static GLshort pack_position_(LVertexFormat2D format, GLfloat value);
+static GLushort pack_unorm16_(GLfloat value);
+static GLubyte pack_unorm8_(GLfloat value);
+
+GLshort pack_position_(LVertexFormat2D format, GLfloat value)
+{
+  if (format == LVERTEX_FORMAT_COMPACT_HALF)
+  {
+    // keep bits as is, attribute is sourced as GL_HALF_FLOAT
+    GLushort half = gl_lvertex_format_float_to_half(value);
+    GLshort out;
+    memcpy(&out, &half, sizeof(out));
+    return out;
+  }
+
+  long rounded = lroundf(value);
+  if (rounded < -32768)
+    rounded = -32768;
+  else if (rounded > 32767)
+    rounded = 32767;
+  return (GLshort)rounded;
+}
+
+GLushort pack_unorm16_(GLfloat value)
+{
+  if (value <= 0.f)
+    return 0;
+  if (value >= 1.f)
+    return 65535;
+  return (GLushort)(value * 65535.f + 0.5f);
+}
+
+GLubyte pack_unorm8_(GLfloat value)
+{
+  if (value <= 0.f)
+    return 0;
+  if (value >= 1.f)
+    return 255;
+  return (GLubyte)(value * 255.f + 0.5f);
+}
+
+GLsizei gl_lvertex_format_stride(LVertexFormat2D format)
+{
+  return format == LVERTEX_FORMAT_FLOAT ? sizeof(LVertexData2D) : sizeof(LCompactVertexData2D);
+}
+
+GLsizei gl_lvertex_format_multicolor_stride(LVertexFormat2D format)
+{
+  return format == LVERTEX_FORMAT_FLOAT ? sizeof(LMultiColorVertex2D) : sizeof(LCompactMultiColorVertex2D);
+}
+
+void gl_lvertex_format_textured_attribs(LVertexFormat2D format, gl_lvertex_format_attrib* position, gl_lvertex_format_attrib* texcoord)
+{
+  if (format == LVERTEX_FORMAT_FLOAT)
+  {
+    *position = (gl_lvertex_format_attrib){ 2, GL_FLOAT, GL_FALSE, offsetof(LVertexData2D, position) };
+    *texcoord = (gl_lvertex_format_attrib){ 2, GL_FLOAT, GL_FALSE, offsetof(LVertexData2D, texcoord) };
+    return;
+  }
+
+  // shorts are converted to float as is, not normalized
+  GLenum position_type = format == LVERTEX_FORMAT_COMPACT_HALF ? GL_HALF_FLOAT : GL_SHORT;
+  *position = (gl_lvertex_format_attrib){ 2, position_type, GL_FALSE, offsetof(LCompactVertexData2D, x) };
+  *texcoord = (gl_lvertex_format_attrib){ 2, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(LCompactVertexData2D, s) };
+}
+
+void gl_lvertex_format_multicolor_attribs(LVertexFormat2D format, gl_lvertex_format_attrib* position, gl_lvertex_format_attrib* color)
+{
+  if (format == LVERTEX_FORMAT_FLOAT)
+  {
+    *position = (gl_lvertex_format_attrib){ 2, GL_FLOAT, GL_FALSE, offsetof(LMultiColorVertex2D, pos) };
+    *color = (gl_lvertex_format_attrib){ 4, GL_FLOAT, GL_FALSE, offsetof(LMultiColorVertex2D, color) };
+    return;
+  }
+
+  GLenum position_type = format == LVERTEX_FORMAT_COMPACT_HALF ? GL_HALF_FLOAT : GL_SHORT;
+  *position = (gl_lvertex_format_attrib){ 2, position_type, GL_FALSE, offsetof(LCompactMultiColorVertex2D, x) };
+  *color = (gl_lvertex_format_attrib){ 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(LCompactMultiColorVertex2D, color) };
+}
+
+void gl_lvertex_format_pack(LVertexFormat2D format, const LVertexData2D* vertices, int count, void* out)
+{
+  if (format == LVERTEX_FORMAT_FLOAT)
+  {
+    memmove(out, vertices, count * sizeof(LVertexData2D));
+    return;
+  }
+
+  // compact vertex is smaller, so in-place packing never overwrites vertices yet to be read
+  LCompactVertexData2D* dst = out;
+  for (int i=0; i<count; i++)
+  {
+    const LVertexData2D v = vertices[i];
+    dst[i].x = pack_position_(format, v.position.x);
+    dst[i].y = pack_position_(format, v.position.y);
+    dst[i].s = pack_unorm16_(v.texcoord.s);
+    dst[i].t = pack_unorm16_(v.texcoord.t);
+  }
+}
+
+void gl_lvertex_format_pack_multicolor(LVertexFormat2D format, const LMultiColorVertex2D* vertices, int count, void* out)
+{
+  if (format == LVERTEX_FORMAT_FLOAT)
+  {
+    memmove(out, vertices, count * sizeof(LMultiColorVertex2D));
+    return;
+  }
+
+  LCompactMultiColorVertex2D* dst = out;
+  for (int i=0; i<count; i++)
+  {
+    const LMultiColorVertex2D v = vertices[i];
+    dst[i].x = pack_position_(format, v.pos.x);
+    dst[i].y = pack_position_(format, v.pos.y);
+    dst[i].color = gl_lvertex_format_pack_color(v.color);
+  }
+}
+
+LColorRGBA8 gl_lvertex_format_pack_color(LColorRGBA color)
+{
+  return (LColorRGBA8){ pack_unorm8_(color.r), pack_unorm8_(color.g), pack_unorm8_(color.b), pack_unorm8_(color.a) };
+}
+
+GLushort gl_lvertex_format_float_to_half(GLfloat value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+
+  const uint32_t sign = (bits >> 16) & 0x8000;
+  const uint32_t float_exponent = (bits >> 23) & 0xff;
+  uint32_t mantissa = bits & 0x7fffff;
+
+  // infinity, or NaN (keep it NaN)
+  if (float_exponent == 0xff)
+  {
+    return sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0);
+  }
+
+  const int exponent = (int)float_exponent - 127 + 15;
+  // too large, becomes infinity
+  if (exponent >= 31)
+  {
+    return sign | 0x7c00;
+  }
+  // too small even for subnormal
+  if (exponent <= -10)
+  {
+    return sign;
+  }
+  // subnormal, implicit leading bit becomes explicit
+  if (exponent <= 0)
+  {
+    mantissa |= 0x800000;
+    const int shift = 14 - exponent;
+    uint32_t half = mantissa >> shift;
+    if ((mantissa >> (shift - 1)) & 1)
+    {
+      half++;
+    }
+    return sign | half;
+  }
+
+  // carry from rounding into exponent is still correct
+  uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+  if (mantissa & 0x1000)
+  {
+    half++;
+  }
+  return half;
+}
+
+GLuint gl_lvertex_format_quad_index_buffer()
+{
+  if (quad_IBO_id_ != 0)
+  {
+    return quad_IBO_id_;
+  }
+
+  // 2 triangles per quad, same winding as quad's vertex order
+  GLushort* index_data = malloc(GL_LVERTEX_FORMAT_MAX_QUADS * 6 * sizeof(GLushort));
+  for (int i=0; i<GL_LVERTEX_FORMAT_MAX_QUADS; i++)
+  {
+    const GLushort base = i * 4;
+    index_data[i*6 + 0] = base + 0;
+    index_data[i*6 + 1] = base + 1;
+    index_data[i*6 + 2] = base + 2;
+    index_data[i*6 + 3] = base + 2;
+    index_data[i*6 + 4] = base + 3;
+    index_data[i*6 + 5] = base + 0;
+  }
+
+  glGenBuffers(1, &quad_IBO_id_);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad_IBO_id_);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, GL_LVERTEX_FORMAT_MAX_QUADS * 6 * sizeof(GLushort), index_data, GL_STATIC_DRAW);
+  free(index_data);
+
+  GLenum error = GL_LDEBUG_GET_ERROR();
+  if (error != GL_NO_ERROR)
+  {
+    SDL_Log("Error creating shared quad index buffer: %s", gl_util_error_string(error));
+  }
+
+  return quad_IBO_id_;
+}
+
+void gl_lvertex_format_draw_quads(int first_quad, int quad_count)
+{
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl_lvertex_format_quad_index_buffer());
+
+  // indices restart from 0 for each chunk, base vertex selects its quads
+  while (quad_count > 0)
+  {
+    const int count = krr_math_min(quad_count, GL_LVERTEX_FORMAT_MAX_QUADS);
+    glDrawElementsBaseVertex(GL_TRIANGLES, count * 6, GL_UNSIGNED_SHORT, NULL, first_quad * 4);
+
+    first_quad += count;
+    quad_count -= count;
+  }
+}
+
+void gl_lvertex_format_free()
+{
+  if (quad_IBO_id_ != 0)
+  {
+    glDeleteBuffers(1, &quad_IBO_id_);
+    quad_IBO_id_ = 0;
+  }
+}
@@ -0,0 +1,135 @@
+#ifndef gl_lvertex_format_h_
+#define gl_lvertex_format_h_
+
+#include "gl/glLOpenGL.h"
+#include "gl/gl_types.h"
+#include <stddef.h>
+
+/// Vertex layouts of 2d geometry, and shared quad index buffer.
+///
+/// Geometry is built with float vertices (LVertexData2D, LMultiColorVertex2D) then packed into
+/// the selected LVertexFormat2D before upload. Compact formats take 8 bytes per vertex instead of
+/// 16 (textured), or 24 (multicolor):
+///
+///   - positions as 16-bit shorts in whole pixels (rounded), or 16-bit half floats
+///   - texcoords as 16-bit unsigned shorts normalized to [0, 1]
+///   - colors as 8-bit unsigned bytes normalized to [0, 1]
+///
+/// Half floats are exact for whole pixels up to 2048, beyond that they step by 2 pixels or more,
+/// so use LVERTEX_FORMAT_COMPACT_HALF for small quads in local space with fractional sizes, and
+/// LVERTEX_FORMAT_COMPACT_SHORT for anything placed in pixels.
+///
+/// Quads are drawn as indexed triangle lists from a single index buffer of GL_UNSIGNED_SHORT
+/// shared by all geometry, each quad's 4 vertices in order top-left, top-right, bottom-right,
+/// bottom-left. As 16-bit indices address at most 65536 vertices, longer runs are drawn in chunks
+/// offset by base vertex, so vertex buffers needn't be split.
+
+/// maximum number of quads addressed by shared quad index buffer in a single draw call
+#define GL_LVERTEX_FORMAT_MAX_QUADS 16384
+
+/// attribute of vertex layout as to pass to glVertexAttribPointer()
+typedef struct
+{
+  /// number of components
+  GLint size;
+  /// component type i.e. GL_UNSIGNED_SHORT
+  GLenum type;
+  /// whether integer components are normalized
+  GLboolean normalized;
+  /// byte offset within vertex
+  size_t offset;
+} gl_lvertex_format_attrib;
+
+///
+/// Get size of textured vertex in specified format.
+///
+/// \param format Vertex format
+/// \return Size in bytes of a single vertex.
+///
+extern GLsizei gl_lvertex_format_stride(LVertexFormat2D format);
+
+///
+/// Get size of multicolor vertex in specified format.
+///
+/// \param format Vertex format
+/// \return Size in bytes of a single vertex.
+///
+extern GLsizei gl_lvertex_format_multicolor_stride(LVertexFormat2D format);
+
+///
+/// Get position, and texcoord attribute of textured vertex in specified format.
+///
+/// \param format Vertex format
+/// \param position Output position attribute
+/// \param texcoord Output texcoord attribute
+///
+extern void gl_lvertex_format_textured_attribs(LVertexFormat2D format, gl_lvertex_format_attrib* position, gl_lvertex_format_attrib* texcoord);
+
+///
+/// Get position, and color attribute of multicolor vertex in specified format.
+///
+/// \param format Vertex format
+/// \param position Output position attribute
+/// \param color Output color attribute
+///
+extern void gl_lvertex_format_multicolor_attribs(LVertexFormat2D format, gl_lvertex_format_attrib* position, gl_lvertex_format_attrib* color);
+
+///
+/// Pack textured vertices into specified format.
+///
+/// \param format Vertex format
+/// \param vertices Source vertices
+/// \param count Number of vertices
+/// \param out Destination of count * gl_lvertex_format_stride() bytes. It can be the same as vertices.
+///
+extern void gl_lvertex_format_pack(LVertexFormat2D format, const LVertexData2D* vertices, int count, void* out);
+
+///
+/// Pack multicolor vertices into specified format.
+///
+/// \param format Vertex format
+/// \param vertices Source vertices
+/// \param count Number of vertices
+/// \param out Destination of count * gl_lvertex_format_multicolor_stride() bytes. It can be the same as vertices.
+///
+extern void gl_lvertex_format_pack_multicolor(LVertexFormat2D format, const LMultiColorVertex2D* vertices, int count, void* out);
+
+///
+/// Pack color into 8-bit normalized components.
+///
+/// \param color Color to pack, components are clamped to [0, 1]
+/// \return Packed color.
+///
+extern LColorRGBA8 gl_lvertex_format_pack_color(LColorRGBA color);
+
+///
+/// Convert float into bits of 16-bit half float, rounded to nearest.
+///
+/// \param value Value to convert
+/// \return Half float bits.
+///
+extern GLushort gl_lvertex_format_float_to_half(GLfloat value);
+
+///
+/// Get shared quad index buffer, create it if it's not created yet.
+/// It holds GL_LVERTEX_FORMAT_MAX_QUADS quads as triangle list of GL_UNSIGNED_SHORT indices.
+///
+/// \return Index buffer to record into vertex array object, or bind.
+///
+extern GLuint gl_lvertex_format_quad_index_buffer();
+
+///
+/// Draw consecutive quads from vertex buffer set up by attribute pointers, or bound vertex array object.
+/// Shared quad index buffer gets bound to GL_ELEMENT_ARRAY_BUFFER.
+///
+/// \param first_quad Index of first quad in vertex buffer
+/// \param quad_count Number of quads to draw
+///
+extern void gl_lvertex_format_draw_quads(int first_quad, int quad_count);
+
+///
+/// Free shared quad index buffer.
+///
+extern void gl_lvertex_format_free();
+
+#endif
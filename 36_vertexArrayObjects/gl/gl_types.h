@@ -41,6 +41,13 @@ typedef struct
   LTexCoord2D texcoord;
 } LVertexData2D;
 
+typedef struct
+{
+  LVertexData2D data;
+  // layer of texture array to sample from
+  GLfloat layer;
+} LLayerVertexData2D;
+
 typedef struct
 {
   GLfloat r;
@@ -55,4 +62,41 @@ typedef struct
   LColorRGBA color;
 } LMultiColorVertex2D;
 
+// vertex layout of 2d geometry, see gl/gl_lvertex_format.h
+typedef enum
+{
+  // 32-bit float components (LVertexData2D, LMultiColorVertex2D)
+  LVERTEX_FORMAT_FLOAT = 0,
+  // 16-bit short positions in whole pixels, 16-bit normalized texcoords, 8-bit normalized colors
+  LVERTEX_FORMAT_COMPACT_SHORT = 1,
+  // same as LVERTEX_FORMAT_COMPACT_SHORT but 16-bit half-float positions for fractional pixels
+  LVERTEX_FORMAT_COMPACT_HALF = 2
+} LVertexFormat2D;
+
+typedef struct
+{
+  GLubyte r;
+  GLubyte g;
+  GLubyte b;
+  GLubyte a;
+} LColorRGBA8;
+
+typedef struct
+{
+  // short, or half-float bits depending on LVertexFormat2D
+  GLshort x;
+  GLshort y;
+  // normalized to [0, 65535]
+  GLushort s;
+  GLushort t;
+} LCompactVertexData2D;
+
+typedef struct
+{
+  // short, or half-float bits depending on LVertexFormat2D
+  GLshort x;
+  GLshort y;
+  LColorRGBA8 color;
+} LCompactMultiColorVertex2D;
+
 #endif
@@ -1,4 +1,5 @@
 #include "gl_util.h"
+#include "gl/gl_ldebug.h"
 #include <stdio.h>
 #include <stdarg.h>
 #include "SDL_log.h"
@@ -87,7 +88,7 @@ GLuint gl_util_map_color_RGBA_to_ABGR(GLuint color)
 
 GLenum gl_util_anyerror(const char* prefix)
 {
-  GLenum error = glGetError();
+  GLenum error = GL_LDEBUG_GET_ERROR();
   if (error != GL_NO_ERROR)
   {
     if (prefix == NULL)
@@ -48,6 +48,7 @@ extern GLuint gl_util_map_color_RGBA_to_ABGR(GLuint color);
 ///
 /// check and print any error so far for opengl
 /// if opengl has any error, it will print error message on screen then return such error code
+/// it always returns GL_NO_ERROR in release build (see gl_ldebug)
 ///
 /// \param prefix prefix text to print. can be NULL.
 /// \return error if any, or GL_NO_ERROR if no
@@ -0,0 +1,6 @@
+// per-frame constants shared by all programs, see gl_lframe_constants
+layout(std140) uniform FrameConstants
+{
+  mat4 projection_matrix;
+  mat4 view_matrix;
+};
@@ -1,7 +1,8 @@
 #version 150
 
-// transformation matrices
-uniform mat4 projection_matrix;
+#include "frame_constants.glsl"
+
+// transformation of what's being drawn
 uniform mat4 modelview_matrix;
 
 // vertex position attribute
@@ -19,5 +20,5 @@ void main()
   multicolor = multicolor1 * multicolor2;
 
   // process vertex
-  gl_Position = projection_matrix * modelview_matrix * vec4(vertex_pos2d.x, vertex_pos2d.y, 0.0, 1.0);
+  gl_Position = projection_matrix * view_matrix * modelview_matrix * vec4(vertex_pos2d.x, vertex_pos2d.y, 0.0, 1.0);
 }
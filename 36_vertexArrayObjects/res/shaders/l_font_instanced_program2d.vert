@@ -0,0 +1,39 @@
+#version 150
+
+#include "frame_constants.glsl"
+
+// transformation of what's being drawn
+uniform mat4 modelview_matrix;
+
+// per-glyph attributes, advance once per instance
+// glyph's quad position of top-left, and size in pixels (x, y, w, h)
+in vec4 glyph_rect;
+// glyph's rect in atlas in texture coordinate (s, t, w, h)
+in vec4 glyph_texrect;
+// glyph's color
+in vec4 glyph_color;
+// rotation in radians, and scale, both around glyph's center
+in vec2 glyph_transform;
+
+out vec2 outin_texcoord;
+out vec4 outin_color;
+
+void main()
+{
+  // corner of quad from vertex id of triangle strip, (0,0) top-left to (1,1) bottom-right
+  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+
+  // process texcoord, and color
+  outin_texcoord = glyph_texrect.xy + corner * glyph_texrect.zw;
+  outin_color = glyph_color;
+
+  // rotate, and scale corner around glyph's center
+  vec2 half_size = glyph_rect.zw * 0.5;
+  vec2 local = (corner * 2.0 - 1.0) * half_size * glyph_transform.y;
+  float c = cos(glyph_transform.x);
+  float s = sin(glyph_transform.x);
+  vec2 pos = glyph_rect.xy + half_size + vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+
+  // process vertex
+  gl_Position = projection_matrix * view_matrix * modelview_matrix * vec4(pos.x, pos.y, 0.0, 1.0);
+}
@@ -11,9 +11,18 @@ out vec4 final_color;
 
 void main()
 {
+#ifdef SDF
+  // red component holds signed distance to glyph's edge, 0.5 is at the edge and higher is inside
+  float dist = texture(texture_sampler, outin_texcoord).r;
+
+  // antialias over about a pixel on screen regardless of scale or rotation
+  float width = fwidth(dist) * 0.7;
+  float alpha = smoothstep(0.5 - width, 0.5 + width, dist);
+#else
   // get red component from texture (as we treat texture as 8-bit format for alpha)
-  float red = texture(texture_sampler, outin_texcoord).r;
+  float alpha = texture(texture_sampler, outin_texcoord).r;
+#endif
 
   // set alpha fragment
-  final_color = vec4(1.0, 1.0, 1.0, red) * text_color;
+  final_color = vec4(1.0, 1.0, 1.0, alpha) * text_color;
 }
@@ -5,7 +5,12 @@
 uniform vec4 texture_color = vec4(1.0, 1.0, 1.0, 1.0);
 
 // texture unit
+#ifdef TEXTURE_ARRAY
+uniform sampler2DArray texture_sampler;
+flat in float outin_layer;
+#else
 uniform sampler2D texture_sampler;
+#endif
 
 // texture coordinate
 in vec2 outin_texcoord;
@@ -15,5 +20,9 @@ out vec4 final_color;
 
 void main()
 {
+#ifdef TEXTURE_ARRAY
+  final_color = texture(texture_sampler, vec3(outin_texcoord, outin_layer)) * texture_color;
+#else
   final_color = texture(texture_sampler, outin_texcoord) * texture_color;
+#endif
 }
@@ -1,9 +1,15 @@
 #version 150
 
-// transformation matrices
-uniform mat4 projection_matrix;
+#include "frame_constants.glsl"
+
+// transformation of what's being drawn
 uniform mat4 modelview_matrix;
 
+// texture coordinate clipping as (offset s, offset t, scale s, scale t)
+// it maps input texcoord in [0,1] onto sub-region of texture
+// not used with TEXTURE_ARRAY as batched vertices have final texture coordinates
+uniform vec4 texcoord_clip = vec4(0.0, 0.0, 1.0, 1.0);
+
 // vertex position attribute
 in vec2 vertex_pos2d;
 
@@ -11,11 +17,23 @@ in vec2 vertex_pos2d;
 in vec2 texcoord;
 out vec2 outin_texcoord;
 
+#ifdef TEXTURE_ARRAY
+// layer of texture array per vertex, the same across each sprite
+// flat so it's never interpolated into a fractional layer
+in float layer;
+flat out float outin_layer;
+#endif
+
 void main()
 {
   // process texcoord
+#ifdef TEXTURE_ARRAY
   outin_texcoord = texcoord;
+  outin_layer = layer;
+#else
+  outin_texcoord = texcoord_clip.xy + texcoord * texcoord_clip.zw;
+#endif
 
   // process vertex
-  gl_Position = projection_matrix * modelview_matrix * vec4(vertex_pos2d.x, vertex_pos2d.y, 0.0, 1.0);
+  gl_Position = projection_matrix * view_matrix * modelview_matrix * vec4(vertex_pos2d.x, vertex_pos2d.y, 0.0, 1.0);
 }
@@ -0,0 +1,432 @@
+/*
+ * Asset packer tool.
+ *
+ * Pack loose files into a single asset pack (see foundation/krr_assetpack_format.h).
+ * - Images (.png, .jpg, .bmp, .tga) are decoded, converted to RGBA8, padded to power-of-two,
+ *   and optionally get their full mipmap chain generated. Engine uploads them as they are.
+ * - Shaders (.vert, .frag, .glsl) are stored as null-terminated source with their includes resolved
+ *   (see gl/gl_lshader_source.h), so engine compiles them as they are.
+ * - Fonts (.ttf) are stored as they are, FreeType loads them from mapped memory.
+ * - Other files (i.e. .dds) are stored as they are.
+ *
+ * Usage
+ *   assetpack pack <output.pack> [--mips] <file>...
+ *   assetpack bench <input.pack> <file>...
+ *
+ * bench mode compares startup I/O and parse time of loading loose files (as the engine did),
+ * against mapping the pack and touching all of its data.
+ *
+ * Asset name is the path as given in command line.
+ */
+
+#define SDL_MAIN_HANDLED
+#include "SDL.h"
+#include "SDL_image.h"
+#include "foundation/krr_assetpack_format.h"
+#include "foundation/krr_filemap.h"
+#include "foundation/krr_hash.h"
+#include "gl/gl_lshader_source.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+typedef struct
+{
+  krr_assetpack_entry entry;
+  // data to write
+  void* data;
+} pack_item;
+
+static const char* extension_(const char* path);
+static bool is_image_(const char* path);
+static uint32_t type_of_(const char* path);
+static void* read_file_(const char* path, size_t* size, bool null_terminate);
+static int next_pot_(int value);
+static void* build_texture_(const char* path, bool mips, krr_assetpack_entry* entry);
+static int compare_items_(const void* a, const void* b);
+static int pack_(const char* output, int file_count, char** files, bool mips);
+static int bench_(const char* input, int file_count, char** files);
+static double now_ms_();
+
+const char* extension_(const char* path)
+{
+  const char* dot = strrchr(path, '.');
+  return dot != NULL ? dot + 1 : "";
+}
+
+bool is_image_(const char* path)
+{
+  const char* ext = extension_(path);
+  return strcmp(ext, "png") == 0 || strcmp(ext, "jpg") == 0 || strcmp(ext, "bmp") == 0 || strcmp(ext, "tga") == 0;
+}
+
+uint32_t type_of_(const char* path)
+{
+  const char* ext = extension_(path);
+  if (is_image_(path))
+    return KRR_ASSETPACK_TYPE_TEXTURE;
+  else if (strcmp(ext, "vert") == 0 || strcmp(ext, "frag") == 0 || strcmp(ext, "glsl") == 0)
+    return KRR_ASSETPACK_TYPE_SHADER;
+  else if (strcmp(ext, "ttf") == 0)
+    return KRR_ASSETPACK_TYPE_FONT;
+  else
+    return KRR_ASSETPACK_TYPE_RAW;
+}
+
+void* read_file_(const char* path, size_t* size, bool null_terminate)
+{
+  FILE* file = fopen(path, "rb");
+  if (file == NULL)
+  {
+    fprintf(stderr, "Unable to open file for read %s\n", path);
+    return NULL;
+  }
+
+  fseek(file, 0, SEEK_END);
+  long file_size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  char* buffer = malloc(file_size + 1);
+  if (file_size > 0 && fread(buffer, file_size, 1, file) != 1)
+  {
+    fprintf(stderr, "Read error for file %s\n", path);
+    free(buffer);
+    fclose(file);
+    return NULL;
+  }
+  fclose(file);
+
+  buffer[file_size] = '\0';
+  *size = file_size + (null_terminate ? 1 : 0);
+  return buffer;
+}
+
+int next_pot_(int value)
+{
+  int pot = 1;
+  while (pot < value)
+  {
+    pot <<= 1;
+  }
+  return pot;
+}
+
+void* build_texture_(const char* path, bool mips, krr_assetpack_entry* entry)
+{
+  SDL_Surface* loaded_surface = IMG_Load(path);
+  if (loaded_surface == NULL)
+  {
+    fprintf(stderr, "Unable to load image %s: %s\n", path, IMG_GetError());
+    return NULL;
+  }
+
+  // same byte order as gl_LTexture uploads with GL_RGBA
+  SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded_surface, SDL_PIXELFORMAT_ABGR8888, 0);
+  SDL_FreeSurface(loaded_surface);
+  if (surface == NULL)
+  {
+    fprintf(stderr, "Cannot convert %s to ABGR8888 format\n", path);
+    return NULL;
+  }
+
+  const int width = surface->w;
+  const int height = surface->h;
+  const int pwidth = next_pot_(width);
+  const int pheight = next_pot_(height);
+
+  // count levels, and total size
+  int mip_count = 1;
+  size_t total_pixels = (size_t)pwidth * pheight;
+  if (mips)
+  {
+    int w = pwidth;
+    int h = pheight;
+    while (w > 1 || h > 1)
+    {
+      w = w > 1 ? w / 2 : 1;
+      h = h > 1 ? h / 2 : 1;
+      total_pixels += (size_t)w * h;
+      mip_count++;
+    }
+  }
+
+  uint32_t* pixels = calloc(total_pixels, sizeof(uint32_t));
+
+  // level 0, original pixels at top-left, the less is fully transparent
+  for (int y=0; y<height; y++)
+  {
+    memcpy(pixels + (size_t)y * pwidth, (const uint8_t*)surface->pixels + (size_t)y * surface->pitch, width * sizeof(uint32_t));
+  }
+  SDL_FreeSurface(surface);
+
+  // the rest of levels with 2x2 box filter from previous level
+  // only image region is filtered, so padding doesn't fringe its edges at smaller levels,
+  // the rest of each level stays padded with transparent pixels as level 0
+  uint32_t* src = pixels;
+  int sw = pwidth;
+  int sh = pheight;
+  int src_width = width;
+  int src_height = height;
+  for (int level=1; level<mip_count; level++)
+  {
+    int dw = sw > 1 ? sw / 2 : 1;
+    int dh = sh > 1 ? sh / 2 : 1;
+    uint32_t* dst = src + (size_t)sw * sh;
+
+    // image region rounds up to keep its last row, and column
+    int dst_width = (src_width + 1) / 2;
+    int dst_height = (src_height + 1) / 2;
+
+    for (int y=0; y<dst_height; y++)
+    {
+      int y0 = y * 2;
+      int y1 = y0 + 1 < src_height ? y0 + 1 : y0;
+      for (int x=0; x<dst_width; x++)
+      {
+        int x0 = x * 2;
+        int x1 = x0 + 1 < src_width ? x0 + 1 : x0;
+
+        const uint8_t* p00 = (const uint8_t*)&src[y0 * sw + x0];
+        const uint8_t* p01 = (const uint8_t*)&src[y0 * sw + x1];
+        const uint8_t* p10 = (const uint8_t*)&src[y1 * sw + x0];
+        const uint8_t* p11 = (const uint8_t*)&src[y1 * sw + x1];
+
+        uint8_t* d = (uint8_t*)&dst[y * dw + x];
+        for (int c=0; c<4; c++)
+        {
+          d[c] = (p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4;
+        }
+      }
+    }
+
+    src = dst;
+    sw = dw;
+    sh = dh;
+    src_width = dst_width;
+    src_height = dst_height;
+  }
+
+  entry->pixel_format = KRR_ASSETPACK_PIXEL_RGBA8;
+  entry->width = width;
+  entry->height = height;
+  entry->physical_width = pwidth;
+  entry->physical_height = pheight;
+  entry->mip_count = mip_count;
+  entry->size = total_pixels * sizeof(uint32_t);
+
+  return pixels;
+}
+
+int compare_items_(const void* a, const void* b)
+{
+  const pack_item* ia = a;
+  const pack_item* ib = b;
+  if (ia->entry.name_hash < ib->entry.name_hash)
+    return -1;
+  else if (ia->entry.name_hash > ib->entry.name_hash)
+    return 1;
+  return 0;
+}
+
+int pack_(const char* output, int file_count, char** files, bool mips)
+{
+  pack_item* items = calloc(file_count, sizeof(pack_item));
+
+  for (int i=0; i<file_count; i++)
+  {
+    const char* path = files[i];
+    krr_assetpack_entry* entry = &items[i].entry;
+
+    if (strlen(path) >= KRR_ASSETPACK_MAX_NAME)
+    {
+      fprintf(stderr, "Asset name is too long (max %d): %s\n", KRR_ASSETPACK_MAX_NAME - 1, path);
+      return 1;
+    }
+    strcpy(entry->name, path);
+    entry->name_hash = krr_hash_string(path);
+    entry->type = type_of_(path);
+
+    if (entry->type == KRR_ASSETPACK_TYPE_TEXTURE)
+    {
+      items[i].data = build_texture_(path, mips, entry);
+    }
+    else if (entry->type == KRR_ASSETPACK_TYPE_SHADER)
+    {
+      // GL knows nothing about #include, resolve them now
+      char* source = gl_lshader_source_load(path, NULL, 0);
+      if (source != NULL)
+      {
+        entry->size = strlen(source) + 1;
+      }
+      else
+      {
+        fprintf(stderr, "Unable to preprocess shader %s\n", path);
+      }
+      items[i].data = source;
+    }
+    else
+    {
+      size_t size = 0;
+      items[i].data = read_file_(path, &size, false);
+      entry->size = size;
+    }
+
+    if (items[i].data == NULL)
+    {
+      return 1;
+    }
+  }
+
+  // sort by name hash for binary search at runtime
+  qsort(items, file_count, sizeof(pack_item), compare_items_);
+
+  // lay out data after header, and entries
+  uint64_t offset = sizeof(krr_assetpack_header) + file_count * sizeof(krr_assetpack_entry);
+  for (int i=0; i<file_count; i++)
+  {
+    offset = (offset + KRR_ASSETPACK_ALIGNMENT - 1) & ~(uint64_t)(KRR_ASSETPACK_ALIGNMENT - 1);
+    items[i].entry.offset = offset;
+    offset += items[i].entry.size;
+  }
+
+  FILE* file = fopen(output, "wb");
+  if (file == NULL)
+  {
+    fprintf(stderr, "Unable to open file for write %s\n", output);
+    return 1;
+  }
+
+  krr_assetpack_header header;
+  memset(&header, 0, sizeof(header));
+  strcpy(header.magic, KRR_ASSETPACK_MAGIC);
+  header.version = KRR_ASSETPACK_VERSION;
+  header.entry_count = file_count;
+  fwrite(&header, sizeof(header), 1, file);
+
+  for (int i=0; i<file_count; i++)
+  {
+    fwrite(&items[i].entry, sizeof(krr_assetpack_entry), 1, file);
+  }
+
+  static const char zeros[KRR_ASSETPACK_ALIGNMENT] = {0};
+  for (int i=0; i<file_count; i++)
+  {
+    long padding = items[i].entry.offset - ftell(file);
+    fwrite(zeros, 1, padding, file);
+    fwrite(items[i].data, 1, items[i].entry.size, file);
+
+    printf("%-48s type %u, %llu bytes\n", items[i].entry.name, items[i].entry.type, (unsigned long long)items[i].entry.size);
+    free(items[i].data);
+  }
+
+  printf("Packed %d assets into %s (%ld bytes)\n", file_count, output, ftell(file));
+
+  fclose(file);
+  free(items);
+  return 0;
+}
+
+double now_ms_()
+{
+  return SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+int bench_(const char* input, int file_count, char** files)
+{
+  const int iterations = 10;
+  volatile uint64_t sink = 0;
+
+  // loose files, as engine loads them: decode images, read the others
+  double start = now_ms_();
+  for (int it=0; it<iterations; it++)
+  {
+    for (int i=0; i<file_count; i++)
+    {
+      if (is_image_(files[i]))
+      {
+        SDL_Surface* loaded_surface = IMG_Load(files[i]);
+        if (loaded_surface == NULL)
+          continue;
+        SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded_surface, SDL_PIXELFORMAT_ABGR8888, 0);
+        sink += krr_hash_bytes(surface->pixels, (size_t)surface->pitch * surface->h, 0);
+        SDL_FreeSurface(loaded_surface);
+        SDL_FreeSurface(surface);
+      }
+      else
+      {
+        size_t size = 0;
+        void* data = read_file_(files[i], &size, false);
+        if (data == NULL)
+          continue;
+        sink += krr_hash_bytes(data, size, 0);
+        free(data);
+      }
+    }
+  }
+  double loose_ms = (now_ms_() - start) / iterations;
+
+  // pack, map then look up each asset, and touch its data
+  start = now_ms_();
+  for (int it=0; it<iterations; it++)
+  {
+    krr_filemap map;
+    if (!krr_filemap_open(&map, input))
+    {
+      return 1;
+    }
+
+    const krr_assetpack_header* header = map.data;
+    const krr_assetpack_entry* entries = (const krr_assetpack_entry*)(header + 1);
+    for (int i=0; i<file_count; i++)
+    {
+      uint64_t hash = krr_hash_string(files[i]);
+      for (uint32_t e=0; e<header->entry_count; e++)
+      {
+        if (entries[e].name_hash == hash)
+        {
+          sink += krr_hash_bytes((const uint8_t*)map.data + entries[e].offset, entries[e].size, 0);
+          break;
+        }
+      }
+    }
+
+    krr_filemap_close(&map);
+  }
+  double pack_ms = (now_ms_() - start) / iterations;
+
+  printf("Loose files: %.3f ms, pack: %.3f ms (avg over %d runs, %d assets)\n", loose_ms, pack_ms, iterations, file_count);
+  printf("note: pack touches more bytes for textures with mipmaps, and hashing data stands in for upload\n");
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 4)
+  {
+    fprintf(stderr, "Usage:\n  %s pack <output.pack> [--mips] <file>...\n  %s bench <input.pack> <file>...\n", argv[0], argv[0]);
+    return 1;
+  }
+
+  int result = 1;
+  if (strcmp(argv[1], "pack") == 0)
+  {
+    // pack what's on disk now, not what the packer was built with
+    gl_lshader_source_set_read_from_disk(true);
+
+    bool mips = strcmp(argv[3], "--mips") == 0;
+    int first = mips ? 4 : 3;
+    result = pack_(argv[2], argc - first, argv + first, mips);
+  }
+  else if (strcmp(argv[1], "bench") == 0)
+  {
+    result = bench_(argv[2], argc - 3, argv + 3);
+  }
+  else
+  {
+    fprintf(stderr, "Unknown mode %s\n", argv[1]);
+  }
+
+  IMG_Quit();
+  return result;
+}
@@ -0,0 +1,106 @@
+/*
+ * Shader embedding tool.
+ *
+ * Generate a C source file holding given shader files as null-terminated byte arrays,
+ * along with a table of them sorted by path (see gl/gl_lshader_embedded.h).
+ * Makefile runs it whenever any of shader files changes.
+ *
+ * Usage
+ *   embedshaders <output.c> <file>...
+ *
+ * File is looked up at runtime by the path as given in command line.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+static int compare_paths_(const void* a, const void* b);
+static bool write_file_array_(FILE* out, const char* path, int index, size_t* size);
+
+int compare_paths_(const void* a, const void* b)
+{
+  return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+bool write_file_array_(FILE* out, const char* path, int index, size_t* size)
+{
+  FILE* file = fopen(path, "rb");
+  if (file == NULL)
+  {
+    fprintf(stderr, "Unable to open file for read %s\n", path);
+    return false;
+  }
+
+  // byte array rather than string literal, so there's no limit on its length, nor escaping
+  fprintf(out, "// %s\nstatic const char file_%d_[] = {", path, index);
+  size_t count = 0;
+  int c;
+  while ((c = fgetc(file)) != EOF)
+  {
+    fprintf(out, "%s0x%02x,", count % 16 == 0 ? "\n  " : " ", c);
+    count++;
+  }
+  fprintf(out, "%s0x00\n};\n\n", count % 16 == 0 ? "\n  " : " ");
+
+  bool result = ferror(file) == 0;
+  if (!result)
+  {
+    fprintf(stderr, "Read error for file %s\n", path);
+  }
+  fclose(file);
+
+  *size = count;
+  return result;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    fprintf(stderr, "Usage:\n  %s <output.c> <file>...\n", argv[0]);
+    return 1;
+  }
+
+  const char* output = argv[1];
+  const int file_count = argc - 2;
+  char** files = argv + 2;
+
+  // runtime does binary search on path
+  qsort(files, file_count, sizeof(char*), compare_paths_);
+
+  FILE* out = fopen(output, "wb");
+  if (out == NULL)
+  {
+    fprintf(stderr, "Unable to open file for write %s\n", output);
+    return 1;
+  }
+
+  fprintf(out, "// generated by tools/embedshaders, do not edit\n\n#include \"gl/gl_lshader_embedded.h\"\n\n");
+
+  size_t* sizes = malloc(file_count * sizeof(size_t) + 1);
+  for (int i=0; i<file_count; i++)
+  {
+    if (!write_file_array_(out, files[i], i, &sizes[i]))
+    {
+      free(sizes);
+      fclose(out);
+      remove(output);
+      return 1;
+    }
+  }
+
+  fprintf(out, "const gl_lshader_embedded_file gl_lshader_embedded_files[] = {\n");
+  for (int i=0; i<file_count; i++)
+  {
+    fprintf(out, "  { \"%s\", file_%d_, %zu },\n", files[i], i, sizes[i]);
+  }
+  fprintf(out, "};\n\nconst int gl_lshader_embedded_file_count = %d;\n", file_count);
+
+  free(sizes);
+  fclose(out);
+
+  printf("Embedded %d shader files into %s\n", file_count, output);
+  return 0;
+}
@@ -7,10 +7,22 @@
 #include "gl/gl_ltextured_polygon_program2d.h"
 #include "gl/gl_LFont.h"
 #include "gl/gl_lfont_polygon_program2d.h"
-#include "gl/gl_ldouble_multicolor_polygon_program2d.h"
+#include "gl/gl_ltext_layout.h"
+#include "gl/gl_lprogram.h"
+#include "gl/gl_lframe_constants.h"
+#include "gl/gl_ldebug.h"
+#include "gl/gl_lsampler_cache.h"
+#include "gl/gl_lvertex_format.h"
+#ifdef ENABLE_BENCHMARK
+#include "benchmark.h"
+#endif
 
 // don't use this elsewhere
 #define CONTENT_BG_COLOR 0.f, 0.f, 0.f, 1.f
+// directory to keep baked font caches in, generated files are not tracked
+#define FONT_CACHE_DIR "cache"
+// directory to keep linked program binaries in, generated files are not tracked
+#define SHADER_CACHE_DIR "cache"
 
 #ifndef DISABLE_FPS_CALC
 #define FPS_BUFFER 7+1
@@ -39,6 +51,7 @@ static bool g_need_clipping = false;
 
 static mat4 g_projection_matrix;
 // base modelview matrix to reduce some of mathematics operation initially
+// both are shared to all programs via frame constants, programs' own modelview matrix starts from identity
 static mat4 g_base_modelview_matrix;
 // -- section of variables for maintaining aspect ratio -- //
 
@@ -46,25 +59,6 @@ static mat4 g_base_modelview_matrix;
 static void usercode_app_went_windowed_mode();
 static void usercode_app_went_fullscreen();
 
-enum usercode_matrixtype
-{
-  usercode_matrixtype_projection_matrix,
-  usercode_matrixtype_modelview_matrix
-};
-enum usercode_shadertype
-{
-  usercode_shadertype_texture_shader,
-  usercode_shadertype_font_shader
-};
-///
-/// set matrix then update to shader
-/// required user to bind the shader before calling this function.
-///
-/// \param matrix_type type of matrix to copy to dst. Value is enum usercode_matrixtype.
-/// \param shader_type type of shader. Value is enum usercode_shadertype.
-/// \param program pointer to shader program.
-///
-static void usercode_set_matrix_then_update_to_shader(enum usercode_matrixtype matrix_type, enum usercode_shadertype shader_type, void* program);
 // -- end of section of function signatures -- //
 
 #ifndef DISABLE_FPS_CALC
@@ -77,99 +71,24 @@ static gl_lfont_polygon_program2d* font_shader = NULL;
 static gl_LFont* font = NULL;
 
 // double multicolor
-static gl_ldouble_multicolor_polygon_program2d* multicolor_shader = NULL;
+static gl_lprogram* multicolor_shader = NULL;
+static int multicolor_modelview_index = -1;
 static GLuint vertex_vbo = 0;
 static GLuint rgby_vbo = 0;
 static GLuint cymw_vbo = 0;
 static GLuint gray_vbo = 0;
-static GLuint ibo = 0;
 static GLuint left_vao = 0;
 static GLuint right_vao = 0;
 
-void usercode_set_matrix_then_update_to_shader(enum usercode_matrixtype matrix_type, enum usercode_shadertype shader_program, void* program)
-{
-  // projection matrix
-  if (matrix_type == usercode_matrixtype_projection_matrix)
-  {
-    // texture shader
-    if (shader_program == usercode_shadertype_texture_shader)
-    {
-      // convert to right type of program shader
-      gl_ltextured_polygon_program2d* shader_ptr = (gl_ltextured_polygon_program2d*)program;
-
-      // copy calculated projection matrix to shader's then update to shader
-      glm_mat4_copy(g_projection_matrix, shader_ptr->projection_matrix);
-
-      gl_ltextured_polygon_program2d_update_projection_matrix(shader_ptr);
-    }
-    // font shader
-    else if (shader_program == usercode_shadertype_font_shader)
-    {
-      gl_lfont_polygon_program2d* shader_ptr = (gl_lfont_polygon_program2d*)program;
-      glm_mat4_copy(g_projection_matrix, shader_ptr->projection_matrix);
-
-      gl_lfont_polygon_program2d_update_projection_matrix(shader_ptr);
-    }
-  }
-  // modelview matrix
-  else if (matrix_type == usercode_matrixtype_modelview_matrix)
-  {
-    // texture shader
-    if (shader_program == usercode_shadertype_texture_shader)
-    {
-      gl_ltextured_polygon_program2d* shader_ptr = (gl_ltextured_polygon_program2d*)program;
-      glm_mat4_copy(g_base_modelview_matrix, shader_ptr->modelview_matrix);
-
-      gl_ltextured_polygon_program2d_update_modelview_matrix(shader_ptr);
-    }
-    // font shader
-    else if (shader_program == usercode_shadertype_font_shader)
-    {
-      gl_lfont_polygon_program2d* shader_ptr = (gl_lfont_polygon_program2d*)program;
-      glm_mat4_copy(g_base_modelview_matrix, shader_ptr->modelview_matrix);
-
-      gl_lfont_polygon_program2d_update_modelview_matrix(shader_ptr);
-    }
-  }
-}
-
 void usercode_app_went_windowed_mode()
 {
-  gl_LShaderProgram_bind(multicolor_shader->program);
-  glm_mat4_copy(g_projection_matrix, multicolor_shader->projection_matrix);
-  gl_util_update_projection_matrix(multicolor_shader->projection_matrix_location, multicolor_shader->projection_matrix);
-
-  glm_mat4_copy(g_base_modelview_matrix, multicolor_shader->modelview_matrix);
-  gl_util_update_modelview_matrix(multicolor_shader->modelview_matrix_location, multicolor_shader->modelview_matrix);
-
-  gl_LShaderProgram_bind(texture_shader->program);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_projection_matrix, usercode_shadertype_texture_shader, texture_shader);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_modelview_matrix, usercode_shadertype_texture_shader, texture_shader);
-  // no need to unbind as we will bind a new one soon
-
-  gl_LShaderProgram_bind(font_shader->program);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_projection_matrix, usercode_shadertype_font_shader, font_shader);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_modelview_matrix, usercode_shadertype_font_shader, font_shader);
-  gl_LShaderProgram_unbind(font_shader->program);
+  // single buffer write, every program sees it without being bound
+  gl_lframe_constants_update(g_projection_matrix, g_base_modelview_matrix);
 }
 
 void usercode_app_went_fullscreen()
 {
-  gl_LShaderProgram_bind(multicolor_shader->program);
-  glm_mat4_copy(g_projection_matrix, multicolor_shader->projection_matrix);
-  gl_util_update_projection_matrix(multicolor_shader->projection_matrix_location, multicolor_shader->projection_matrix);
-
-  glm_mat4_copy(g_base_modelview_matrix, multicolor_shader->modelview_matrix);
-  gl_util_update_modelview_matrix(multicolor_shader->modelview_matrix_location, multicolor_shader->modelview_matrix);
-
-  gl_LShaderProgram_bind(texture_shader->program);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_projection_matrix, usercode_shadertype_texture_shader, texture_shader);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_modelview_matrix, usercode_shadertype_texture_shader, texture_shader);
-
-  gl_LShaderProgram_bind(font_shader->program);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_projection_matrix, usercode_shadertype_font_shader, font_shader);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_modelview_matrix, usercode_shadertype_font_shader, font_shader);
-  gl_LShaderProgram_unbind(font_shader->program);
+  gl_lframe_constants_update(g_projection_matrix, g_base_modelview_matrix);
 }
 
 bool usercode_init(int screen_width, int screen_height, int logical_width, int logical_height)
@@ -207,8 +126,16 @@ bool usercode_init(int screen_width, int screen_height, int logical_width, int l
   glEnable(GL_CULL_FACE);
   glFrontFace(GL_CW);
 
+  // shared projection, and view matrix for all programs
+  if (!gl_lframe_constants_init())
+  {
+    SDL_Log("Error creating frame constants");
+    return false;
+  }
+  gl_lframe_constants_update(g_projection_matrix, g_base_modelview_matrix);
+
   // check for errors
-  GLenum error = glGetError();
+  GLenum error = GL_LDEBUG_GET_ERROR();
   if (error != GL_NO_ERROR)
   {
     krr_util_print_callstack();
@@ -221,6 +148,34 @@ bool usercode_init(int screen_width, int screen_height, int logical_width, int l
 
 bool usercode_loadmedia()
 {
+  // restore linked programs from previous runs instead of compiling them again
+  gl_LShaderProgram_set_binary_cache_dir(SHADER_CACHE_DIR);
+  // submit all programs first, driver compiles them while fonts are loaded
+  gl_LShaderProgram_begin_batch();
+
+  // load texture shader
+  texture_shader = gl_ltextured_polygon_program2d_new();
+  if (!gl_ltextured_polygon_program2d_load_program(texture_shader))
+  {
+    SDL_Log("Error loading texture shader");
+    return false;
+  }
+  
+  // load font shader
+  font_shader = gl_lfont_polygon_program2d_new();
+  if (!gl_lfont_polygon_program2d_load_program(font_shader))
+  {
+    SDL_Log("Error loading font shader");
+    return false;
+  }
+
+  // TODO: Load media here...
+  multicolor_shader = gl_lprogram_new();
+  if (!gl_lprogram_load_program(multicolor_shader, "res/shaders/l_double_multicolor_polygon_program2d.vert", "res/shaders/l_double_multicolor_polygon_program2d.frag", NULL, 0))
+  {
+    return false;
+  }
+
   // load font to render framerate
 #ifndef DISABLE_FPS_CALC
   {
@@ -230,7 +185,7 @@ bool usercode_loadmedia()
     gl_LSpritesheet* spritesheet = gl_LSpritesheet_new(raw_texture);
 
     fps_font = gl_LFont_new(spritesheet);
-    if (!gl_LFont_load_freetype(fps_font, "../Minecraft.ttf", 14))
+    if (!gl_LFont_load_freetype_cached(fps_font, "../Minecraft.ttf", 14, FONT_CACHE_DIR))
     {
       SDL_Log("Unable to load font for rendering framerate");
       return false;
@@ -242,54 +197,31 @@ bool usercode_loadmedia()
   gl_LTexture* raw_texture = gl_LTexture_new();
   gl_LSpritesheet* ss = gl_LSpritesheet_new(raw_texture);
   font = gl_LFont_new(ss);
-  if (!gl_LFont_load_freetype(font, "../Minecraft.ttf", 40))
+  if (!gl_LFont_load_freetype_cached(font, "../Minecraft.ttf", 40, FONT_CACHE_DIR))
   {
     SDL_Log("Error to load font");
     return false;
   }
-  // load texture shader
-  texture_shader = gl_ltextured_polygon_program2d_new();
-  if (!gl_ltextured_polygon_program2d_load_program(texture_shader))
-  {
-    SDL_Log("Error loading texture shader");
-    return false;
-  }
-  
-  // load font shader
-  font_shader = gl_lfont_polygon_program2d_new();
-  if (!gl_lfont_polygon_program2d_load_program(font_shader))
-  {
-    SDL_Log("Error loading font shader");
-    return false;
-  }
 
-  // TODO: Load media here...
-  multicolor_shader = gl_ldouble_multicolor_polygon_program2d_new();
-  if (!gl_ldouble_multicolor_polygon_program2d_load_program(multicolor_shader))
+  // programs are needed from here on
+  if (!gl_LShaderProgram_wait_all())
   {
+    SDL_Log("Error building shader programs");
     return false;
   }
 
-  // initially update matrices for multicolor shader
-  gl_LShaderProgram_bind(multicolor_shader->program);
-  // set matrices
-  glm_mat4_copy(g_projection_matrix, multicolor_shader->projection_matrix);
-  glm_mat4_copy(g_base_modelview_matrix, multicolor_shader->modelview_matrix);
-  // issue update matrices to gpu
-  gl_util_update_projection_matrix(multicolor_shader->projection_matrix_location, multicolor_shader->projection_matrix);
-  gl_util_update_modelview_matrix(multicolor_shader->modelview_matrix_location, multicolor_shader->modelview_matrix);
-
-  // initially update all related matrices and related graphics stuf for both shaders
+  // look up once, set by index from now on
+  multicolor_modelview_index = gl_lprogram_uniform_index(multicolor_shader, "modelview_matrix");
+
+  // projection, and view matrix come from frame constants, programs' modelview matrix is identity initially
   gl_LShaderProgram_bind(texture_shader->program);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_projection_matrix, usercode_shadertype_texture_shader, texture_shader);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_modelview_matrix, usercode_shadertype_texture_shader, texture_shader);
+  gl_ltextured_polygon_program2d_update_modelview_matrix(texture_shader);
   gl_ltextured_polygon_program2d_set_texture_sampler(texture_shader, 0);
   // set texture shader to all gl_LTexture as active
   shared_textured_shaderprogram = texture_shader;
 
   gl_LShaderProgram_bind(font_shader->program);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_projection_matrix, usercode_shadertype_font_shader, font_shader);
-  usercode_set_matrix_then_update_to_shader(usercode_matrixtype_modelview_matrix, usercode_shadertype_font_shader, font_shader);
+  gl_lfont_polygon_program2d_update_modelview_matrix(font_shader);
   gl_lfont_polygon_program2d_set_texture_sampler(font_shader, 0);
   // set font shader to all gl_LFont as active
   shared_font_shaderprogram = font_shader;
@@ -324,7 +256,16 @@ bool usercode_loadmedia()
     { 0.50f, 0.50f, 0.50f, 1.0f }
   };
 
-  GLuint indices[4] = { 0, 1, 2, 3 };
+  // colors are uploaded as 8-bit normalized components
+  LColorRGBA8 quad_color8_rgby[4];
+  LColorRGBA8 quad_color8_cymw[4];
+  LColorRGBA8 quad_color8_gray[4];
+  for (int i=0; i<4; i++)
+  {
+    quad_color8_rgby[i] = gl_lvertex_format_pack_color(quad_color_rgby[i]);
+    quad_color8_cymw[i] = gl_lvertex_format_pack_color(quad_color_cymw[i]);
+    quad_color8_gray[i] = gl_lvertex_format_pack_color(quad_color_gray[i]);
+  }
 
   // create VBOs
   glGenBuffers(1, &vertex_vbo);
@@ -333,63 +274,34 @@ bool usercode_loadmedia()
 
   glGenBuffers(1, &rgby_vbo);
   glBindBuffer(GL_ARRAY_BUFFER, rgby_vbo);
-  glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(LColorRGBA), quad_color_rgby, GL_STATIC_DRAW);
+  glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(LColorRGBA8), quad_color8_rgby, GL_STATIC_DRAW);
 
   glGenBuffers(1, &cymw_vbo);
   glBindBuffer(GL_ARRAY_BUFFER, cymw_vbo);
-  glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(LColorRGBA), quad_color_cymw, GL_STATIC_DRAW);
+  glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(LColorRGBA8), quad_color8_cymw, GL_STATIC_DRAW);
 
   glGenBuffers(1, &gray_vbo);
   glBindBuffer(GL_ARRAY_BUFFER, gray_vbo);
-  glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(LColorRGBA), quad_color_gray, GL_STATIC_DRAW);
-
-  glGenBuffers(1, &ibo);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, 4 * sizeof(GLuint), indices, GL_STATIC_DRAW);
-
-  // left vao
-  glGenVertexArrays(1, &left_vao);
-
-  // bind vertex array
-  glBindVertexArray(left_vao);
-  // enable vertex attributes
-  gl_ldouble_multicolor_polygon_program2d_enable_all_vertex_attrib_pointers(multicolor_shader);
-
-  // set vertex data
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_vbo);
-  gl_ldouble_multicolor_polygon_program2d_set_attrib_vertex_pos2d_pointer_packed(multicolor_shader, NULL);
-
-  glBindBuffer(GL_ARRAY_BUFFER, rgby_vbo);
-  gl_ldouble_multicolor_polygon_program2d_set_attrib_multicolor_pointer_packed(multicolor_shader, 1, NULL);
-
-  glBindBuffer(GL_ARRAY_BUFFER, gray_vbo);
-  gl_ldouble_multicolor_polygon_program2d_set_attrib_multicolor_pointer_packed(multicolor_shader, 2, NULL);
-
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-
-  // (note: not neccessary to unbin vao as setting a new one will overwrite the active vao, reduce cost in swithing vao)
-  // right vao
-  glGenVertexArrays(1, &right_vao);
+  glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(LColorRGBA8), quad_color8_gray, GL_STATIC_DRAW);
 
-  // bind vertex array
-  glBindVertexArray(right_vao);
-  // enable vertex attributes
-  gl_ldouble_multicolor_polygon_program2d_enable_all_vertex_attrib_pointers(multicolor_shader);
-
-  // set vertex data
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_vbo);
-  gl_ldouble_multicolor_polygon_program2d_set_attrib_vertex_pos2d_pointer_packed(multicolor_shader, NULL);
-
-  glBindBuffer(GL_ARRAY_BUFFER, cymw_vbo);
-  gl_ldouble_multicolor_polygon_program2d_set_attrib_multicolor_pointer_packed(multicolor_shader, 1, NULL);
-
-  glBindBuffer(GL_ARRAY_BUFFER, gray_vbo);
-  gl_ldouble_multicolor_polygon_program2d_set_attrib_multicolor_pointer_packed(multicolor_shader, 2, NULL);
-
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+  // both quads share positions, and gray tint but differ in their base colors
+  gl_lprogram_vertex_attrib left_layout[3] = {
+    { "vertex_pos2d", vertex_vbo, 2, GL_FLOAT, GL_FALSE, 0, 0, 0 },
+    { "multicolor1", rgby_vbo, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0, 0 },
+    { "multicolor2", gray_vbo, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0, 0 }
+  };
+  gl_lprogram_vertex_attrib right_layout[3] = {
+    { "vertex_pos2d", vertex_vbo, 2, GL_FLOAT, GL_FALSE, 0, 0, 0 },
+    { "multicolor1", cymw_vbo, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0, 0 },
+    { "multicolor2", gray_vbo, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0, 0 }
+  };
+  // quads are drawn from shared quad index buffer
+  left_vao = gl_lprogram_create_vertex_array(multicolor_shader, left_layout, 3, gl_lvertex_format_quad_index_buffer());
+  right_vao = gl_lprogram_create_vertex_array(multicolor_shader, right_layout, 3, gl_lvertex_format_quad_index_buffer());
 
-  // unbine vao
-  glBindVertexArray(0);
+#ifdef ENABLE_BENCHMARK
+  benchmark_run_all();
+#endif
 
   return true;
 }
@@ -497,26 +409,27 @@ void usercode_render()
   gl_LShaderProgram_bind(multicolor_shader->program);
 
   // start fresh with modelview matrix
-  glm_mat4_copy(g_base_modelview_matrix, multicolor_shader->modelview_matrix);
+  mat4 modelview_matrix;
+  glm_mat4_identity(modelview_matrix);
 
   // transform matrix for left quad
-  glm_translate(multicolor_shader->modelview_matrix, (vec3){g_logical_width * 1.f / 4.f, g_logical_height / 2.f, 0.f});
-  gl_util_update_modelview_matrix(multicolor_shader->modelview_matrix_location, multicolor_shader->modelview_matrix);
+  glm_translate(modelview_matrix, (vec3){g_logical_width * 1.f / 4.f, g_logical_height / 2.f, 0.f});
+  gl_lprogram_set_mat4(multicolor_shader, multicolor_modelview_index, modelview_matrix);
 
   // render left quad
-  glDrawElements(GL_TRIANGLE_FAN, 4, GL_UNSIGNED_INT, NULL);
+  gl_lvertex_format_draw_quads(0, 1);
 
   // bind right vao
   glBindVertexArray(right_vao);
 
   // start fresh
-  glm_mat4_copy(g_base_modelview_matrix, multicolor_shader->modelview_matrix);
+  glm_mat4_identity(modelview_matrix);
   // transform matrix for right quad
-  glm_translate(multicolor_shader->modelview_matrix, (vec3){g_logical_width * 3.f / 4.f, g_logical_height / 2.f, 0.f });
-  gl_util_update_modelview_matrix(multicolor_shader->modelview_matrix_location, multicolor_shader->modelview_matrix);
+  glm_translate(modelview_matrix, (vec3){g_logical_width * 3.f / 4.f, g_logical_height / 2.f, 0.f });
+  gl_lprogram_set_mat4(multicolor_shader, multicolor_modelview_index, modelview_matrix);
 
   // render right quad
-  glDrawElements(GL_TRIANGLE_FAN, 4, GL_UNSIGNED_INT, NULL);
+  gl_lvertex_format_draw_quads(0, 1);
 
   // unbind shader
   gl_LShaderProgram_unbind(multicolor_shader->program);
@@ -540,7 +453,7 @@ void usercode_render_fps(int avg_fps)
   // use shared font shader
   gl_LShaderProgram_bind(shared_font_shaderprogram->program);
     // start with clean state of modelview matrix
-    glm_mat4_copy(g_base_modelview_matrix, shared_font_shaderprogram->modelview_matrix);
+    glm_mat4_identity(shared_font_shaderprogram->modelview_matrix);
     gl_lfont_polygon_program2d_update_modelview_matrix(shared_font_shaderprogram);
 
     // render text on top right
@@ -571,7 +484,7 @@ void usercode_close()
     gl_ltextured_polygon_program2d_free(texture_shader);
 
   if (multicolor_shader != NULL)
-    gl_ldouble_multicolor_polygon_program2d_free(multicolor_shader);
+    gl_lprogram_free(multicolor_shader);
 
   if (vertex_vbo != 0)
     glDeleteBuffers(1, &vertex_vbo);
@@ -585,4 +498,12 @@ void usercode_close()
     glDeleteVertexArrays(1, &left_vao);
   if (right_vao != 0)
     glDeleteVertexArrays(1, &right_vao);
+
+  gl_LShaderProgram_set_binary_cache_dir(NULL);
+  gl_lframe_constants_free();
+  gl_lsampler_cache_free();
+  gl_LTexture_free_shared_quad();
+  gl_lvertex_format_free();
+  gl_LFont_free_shared_freetype();
+  gl_ltext_layout_free_cache();
 }
@@ -16,6 +16,7 @@
 #include "gl/gl_LTexture.h"
 #include "gl/gl_LTexture_spritesheet.h"
 #include "gl/gl_LFont.h"
+#include "gl/gl_ldebug.h"
 
 #include "usercode.h"
 
@@ -61,7 +62,12 @@ bool init() {
   }
   
   // use core profile of opengl 3.3
+#ifndef NDEBUG
+  // debug context for driver to report messages (see gl_ldebug)
+  SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG | SDL_GL_CONTEXT_DEBUG_FLAG); // Always required on Mac
+#else
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG); // Always required on Mac
+#endif
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
@@ -117,6 +123,9 @@ bool init() {
     return false;
   }
 
+  // report driver messages as they happen, only in debug build
+  gl_ldebug_init();
+
   // relay call to user's code in separate file
   if (!usercode_init(SCREEN_WIDTH, SCREEN_HEIGHT, LOGICAL_WIDTH, LOGICAL_HEIGHT))
   {